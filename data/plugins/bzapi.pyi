@@ -1,7 +1,7 @@
 """Type stubs for bz_plugins module"""
 
 from enum import IntEnum
-from typing import Callable
+from typing import Callable, Optional
 
 class EventType(IntEnum):
     PLAYER_JOIN = 1
@@ -15,6 +15,15 @@ def register_callback(type: EventType, callback: Callable) -> None:
     """Register a callback for a specific event type"""
     ...
 
+def register_batch_callback(type: EventType, callback: Callable[[list[tuple]], None]) -> None:
+    """Register a callback that receives one list of events per server tick.
+
+    Each entry is the tuple of arguments a register_callback handler gets,
+    followed by whether a synchronous callback handled the event. Batch
+    callbacks cannot veto; use register_callback for that.
+    """
+    ...
+
 def send_chat_message(from_id: int, to_id: int, text: str) -> None:
     """Send a chat message"""
     ...
@@ -46,3 +55,39 @@ def get_player_name(id: int) -> str:
 def get_player_ip(id: int) -> str:
     """Get a player's IP by ID"""
     ...
+
+def grant_flag(player_id: int, cname: str) -> bool:
+    """Give a player a native flag (one with a flag.json), replacing any flag they hold"""
+    ...
+
+def drop_flag(player_id: int) -> None:
+    """Drop a player's native flag and restore their default parameters"""
+    ...
+
+def get_player_flag(player_id: int) -> Optional[str]:
+    """Get the cname of the native flag a player holds, or None"""
+    ...
+
+def has_native_flag(cname: str) -> bool:
+    """Whether the server applies this flag itself from a flag.json file"""
+    ...
+
+def get_player_arrays() -> dict:
+    """Get every player's state in one call.
+
+    Returns a dict with "count" and read-only memoryviews sharing one row
+    order: "ids" (uint32), "positions" (float32, N x 3), "rotations"
+    (float32 quaternions as x, y, z, w, N x 4), "velocities" (float32,
+    N x 3), "alive" (uint8) and "scores" (int32). numpy.asarray() wraps them
+    without copying.
+    """
+    ...
+
+def get_plugin_stats() -> list[dict]:
+    """Get callback timing per plugin and event type.
+
+    Each entry has "plugin", "event", "count", "total_ms", "max_ms",
+    "histogram" (call counts below 1us, 10us, 100us, 1ms, 10ms, 100ms and
+    above) and "disabled".
+    """
+    ...
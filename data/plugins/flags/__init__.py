@@ -24,6 +24,9 @@ class Flag:
     
     def register(self) -> None:
         bzapi.register_flag(self.cname, self.name, self.description, self.params)
+        # Flags with a flag.json are applied by the server; skip the Python fallback.
+        if bzapi.has_native_flag(self.cname):
+            return
         for event, callback in self.callbacks.items():
             bzapi.register_callback(event, callback)
 
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# Runs `bz3-server --benchmark bvh-rays` against every bundled world and fails
+# if the BVH backend disagrees with the simulation backend on any of them.
+# The server must be configured with -DKARMA_SERVER_PHYSICS_BACKEND=bvh;
+# against any other build there is nothing to compare and the check fails.
+# Usage: scripts/check_bvh_rays.sh [path/to/bz3-server]
+set -euo pipefail
+
+repo_root="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+worlds_dir="$repo_root/data/server/worlds"
+
+server="${1:-}"
+if [[ -z "$server" ]]; then
+  # bzbuild.py puts each configuration in its own build-* directory.
+  for candidate in "$repo_root"/build-*/bz3-server; do
+    if [[ -x "$candidate" ]]; then
+      server="$candidate"
+      break
+    fi
+  done
+fi
+
+if [[ -z "$server" || ! -x "$server" ]]; then
+  echo "bz3-server not found or not executable: ${server:-no build-*/bz3-server}" >&2
+  exit 1
+fi
+echo "Using $server"
+
+status=0
+for world in "$worlds_dir"/*/; do
+  echo "== $(basename "$world")"
+  if ! output="$("$server" -d "$repo_root/data" -w "$world" --benchmark bvh-rays)"; then
+    status=1
+  fi
+  echo "$output"
+  if grep -q "nothing to compare" <<<"$output"; then
+    echo "$server was not built with KARMA_SERVER_PHYSICS_BACKEND=bvh" >&2
+    exit 1
+  fi
+done
+exit "$status"
@@ -0,0 +1,115 @@
+#include "common/worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace karma::jobs {
+
+WorkerPool::WorkerPool(std::size_t workerCount) {
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void WorkerPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void WorkerPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& fn,
+                             std::size_t minPerTask) {
+    if (count == 0) {
+        return;
+    }
+
+    const std::size_t grain = std::max<std::size_t>(1, minPerTask);
+    const std::size_t participants = std::min(workers_.size() + 1, (count + grain - 1) / grain);
+    if (participants <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Shared with helper tasks, which may only get scheduled after the caller
+    // has already finished every index; they then exit without touching fn.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::size_t count = 0;
+        const std::function<void(std::size_t)>* fn = nullptr;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->fn = &fn;
+
+    auto drain = [](State& s) {
+        for (;;) {
+            const std::size_t i = s.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= s.count) {
+                return;
+            }
+            (*s.fn)(i);
+            if (s.done.fetch_add(1, std::memory_order_acq_rel) + 1 == s.count) {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.finished.notify_all();
+            }
+        }
+    };
+
+    for (std::size_t i = 1; i < participants; ++i) {
+        submit([state, drain]() { drain(*state); });
+    }
+    drain(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() {
+        return state->done.load(std::memory_order_acquire) == state->count;
+    });
+}
+
+WorkerPool& SharedWorkerPool() {
+    static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+} // namespace karma::jobs
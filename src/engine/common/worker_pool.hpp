@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace karma::jobs {
+
+// Small fixed-size thread pool for data-parallel work inside a frame/tick.
+// The calling thread always takes part in parallelFor, so nested or
+// concurrent callers never deadlock waiting on a busy pool.
+class WorkerPool {
+public:
+    explicit WorkerPool(std::size_t workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    std::size_t workerCount() const { return workers_.size(); }
+
+    // Runs fn(i) for every i in [0, count) and returns once all calls are done.
+    // Ranges shorter than minPerTask per participant run inline.
+    void parallelFor(std::size_t count,
+                     const std::function<void(std::size_t)>& fn,
+                     std::size_t minPerTask = 1);
+
+    void submit(std::function<void()> task);
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+// Process-wide pool sized to the machine (one thread per core minus the caller).
+WorkerPool& SharedWorkerPool();
+
+} // namespace karma::jobs
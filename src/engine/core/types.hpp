@@ -55,5 +55,3 @@ inline float angleBetween(const glm::quat& a, const glm::quat& b, bool degrees =
 }
 
 using render_id = uint32_t;
-
-using PlayerParameters = std::map<std::string, float>;
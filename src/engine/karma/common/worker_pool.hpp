@@ -0,0 +1,3 @@
+#pragma once
+
+#include "engine/common/worker_pool.hpp"
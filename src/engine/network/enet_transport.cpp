@@ -3,10 +3,25 @@
 #include <enet.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
 
 namespace net {
 namespace {
@@ -71,6 +86,51 @@ std::optional<std::string> peerIpString(const ENetAddress &addr) {
     return std::nullopt;
 }
 
+// Host name lookup for one connect attempt. getaddrinfo cannot be interrupted,
+// so a cancelled lookup is left to finish on its detached thread; it only
+// touches this shared job.
+struct ResolveJob {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, uint16_t>> addresses;
+    std::atomic<bool> done{false};
+};
+
+void resolveCandidates(const std::shared_ptr<ResolveJob> &job, std::vector<ConnectCandidate> candidates) {
+    std::vector<std::pair<std::string, uint16_t>> addresses;
+    for (const auto &candidate : candidates) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        hints.ai_protocol = IPPROTO_UDP;
+        addrinfo *results = nullptr;
+        if (getaddrinfo(candidate.host.c_str(), nullptr, &hints, &results) != 0 || !results) {
+            spdlog::warn("ENet client: failed to resolve host {}", candidate.host);
+            continue;
+        }
+        for (const addrinfo *info = results; info; info = info->ai_next) {
+            std::array<char, INET6_ADDRSTRLEN> ipBuffer{};
+            const void *raw = nullptr;
+            if (info->ai_family == AF_INET) {
+                raw = &reinterpret_cast<const sockaddr_in *>(info->ai_addr)->sin_addr;
+            } else if (info->ai_family == AF_INET6) {
+                raw = &reinterpret_cast<const sockaddr_in6 *>(info->ai_addr)->sin6_addr;
+            }
+            if (!raw || !inet_ntop(info->ai_family, raw, ipBuffer.data(), ipBuffer.size())) {
+                continue;
+            }
+            std::pair<std::string, uint16_t> address{ipBuffer.data(), candidate.port};
+            if (std::find(addresses.begin(), addresses.end(), address) == addresses.end()) {
+                addresses.push_back(std::move(address));
+            }
+        }
+        freeaddrinfo(results);
+    }
+
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->addresses = std::move(addresses);
+    job->done.store(true, std::memory_order_release);
+}
+
 class EnetClientTransport final : public IClientTransport {
 public:
     EnetClientTransport() = default;
@@ -82,50 +142,55 @@ public:
         }
     }
 
-    bool connect(const std::string &hostName, uint16_t port, int timeoutMs) override {
+    bool beginConnect(const std::vector<ConnectCandidate> &candidates, int timeoutMs) override {
         disconnect();
         remoteIp.reset();
         remotePort.reset();
 
+        if (candidates.empty()) {
+            state = ConnectState::Failed;
+            return false;
+        }
+
         if (!host) {
-            host = enet_host_create(nullptr, 1, channelCount, 0, 0);
+            host = enet_host_create(nullptr, maxCandidatePeers, channelCount, 0, 0);
             if (!host) {
                 spdlog::error("ENet client: failed to create host");
+                state = ConnectState::Failed;
                 return false;
             }
         }
 
-        ENetAddress address;
-        if (enet_address_set_host(&address, hostName.c_str()) != 0) {
-            spdlog::error("ENet client: failed to resolve host {}", hostName);
-            return false;
-        }
-        address.port = port;
+        connectTimeout = std::chrono::milliseconds(std::max(timeoutMs, 0));
+        deadline = std::chrono::steady_clock::now() + connectTimeout;
+        resolveJob = std::make_shared<ResolveJob>();
+        std::thread(resolveCandidates, resolveJob, candidates).detach();
+        state = ConnectState::Resolving;
+        return true;
+    }
 
-        peer = enet_host_connect(host, &address, 2, 0);
-        if (!peer) {
-            spdlog::error("ENet client: no available peers");
-            return false;
+    void cancelConnect() override {
+        resolveJob.reset();
+        for (ENetPeer *pending : pendingPeers) {
+            enet_peer_disconnect_now(pending, 0);
         }
-
-        ENetEvent event;
-        if (enet_host_service(host, &event, timeoutMs) > 0 && event.type == ENET_EVENT_TYPE_CONNECT) {
-            remoteIp = peerIpString(event.peer->address);
-            remotePort = event.peer->address.port;
-            enet_host_flush(host);
-            return true;
+        pendingPeers.clear();
+        if (state == ConnectState::Resolving || state == ConnectState::Handshaking) {
+            state = ConnectState::Idle;
         }
+    }
 
-        enet_peer_reset(peer);
-        peer = nullptr;
-        return false;
+    ConnectState getConnectState() const override {
+        return state;
     }
 
     void disconnect() override {
+        cancelConnect();
         if (peer) {
             enet_peer_disconnect(peer, 0);
             peer = nullptr;
         }
+        state = ConnectState::Idle;
     }
 
     bool isConnected() const override {
@@ -137,9 +202,36 @@ public:
             return;
         }
 
+        if (state == ConnectState::Resolving) {
+            startHandshakes();
+        }
+
         ENetEvent event;
         while (enet_host_service(host, &event, 0) > 0) {
             switch (event.type) {
+            case ENET_EVENT_TYPE_CONNECT: {
+                if (!takePendingPeer(event.peer)) {
+                    break;
+                }
+                // First handshake to finish wins; the other candidates are dropped.
+                for (ENetPeer *loser : pendingPeers) {
+                    enet_peer_disconnect_now(loser, 0);
+                }
+                pendingPeers.clear();
+                peer = event.peer;
+                remoteIp = peerIpString(event.peer->address);
+                remotePort = event.peer->address.port;
+                state = ConnectState::Connected;
+                enet_host_flush(host);
+
+                Event e;
+                e.type = Event::Type::Connect;
+                e.connection = reinterpret_cast<ConnectionHandle>(event.peer);
+                e.peerIp = remoteIp.value_or(std::string());
+                e.peerPort = event.peer->address.port;
+                outEvents.push_back(std::move(e));
+                break;
+            }
             case ENET_EVENT_TYPE_RECEIVE: {
                 Event e;
                 e.type = Event::Type::Receive;
@@ -151,6 +243,11 @@ public:
                 break;
             }
             case ENET_EVENT_TYPE_DISCONNECT: {
+                // Refused candidates, and peers from an earlier connection that
+                // was already torn down locally, are not reported.
+                if (takePendingPeer(event.peer) || event.peer != peer) {
+                    break;
+                }
                 Event e;
                 e.type = Event::Type::Disconnect;
                 e.connection = reinterpret_cast<ConnectionHandle>(event.peer);
@@ -165,6 +262,9 @@ public:
                 break;
             }
             case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT: {
+                if (takePendingPeer(event.peer) || event.peer != peer) {
+                    break;
+                }
                 Event e;
                 e.type = Event::Type::DisconnectTimeout;
                 e.connection = reinterpret_cast<ConnectionHandle>(event.peer);
@@ -182,6 +282,17 @@ public:
                 break;
             }
         }
+
+        if (state == ConnectState::Handshaking && pendingPeers.empty()) {
+            spdlog::info("ENet client: every candidate refused the connection");
+            state = ConnectState::Failed;
+        }
+        if ((state == ConnectState::Resolving || state == ConnectState::Handshaking) &&
+            std::chrono::steady_clock::now() >= deadline) {
+            spdlog::info("ENet client: connect attempt timed out");
+            cancelConnect();
+            state = ConnectState::Failed;
+        }
     }
 
     void send(const std::byte *data, std::size_t size, Delivery delivery, bool flush) override {
@@ -206,14 +317,75 @@ public:
     }
 
 private:
+    // Once the lookup is done, sends a handshake to every resolved address.
+    void startHandshakes() {
+        if (!resolveJob || !resolveJob->done.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::vector<std::pair<std::string, uint16_t>> addresses;
+        {
+            std::lock_guard<std::mutex> lock(resolveJob->mutex);
+            addresses = std::move(resolveJob->addresses);
+        }
+        resolveJob.reset();
+
+        for (const auto &[ip, port] : addresses) {
+            if (pendingPeers.size() >= static_cast<std::size_t>(maxCandidatePeers)) {
+                spdlog::debug("ENet client: ignoring candidate {}:{} beyond the first {}", ip, port, maxCandidatePeers);
+                continue;
+            }
+            ENetAddress address;
+            if (enet_address_set_host_ip(&address, ip.c_str()) != 0) {
+                continue;
+            }
+            address.port = port;
+            if (ENetPeer *pending = enet_host_connect(host, &address, channelCount, 0)) {
+                spdlog::debug("ENet client: handshaking with {}:{}", ip, port);
+                pendingPeers.push_back(pending);
+            }
+        }
+
+        if (pendingPeers.empty()) {
+            spdlog::error("ENet client: no reachable address among the candidates");
+            state = ConnectState::Failed;
+            return;
+        }
+        state = ConnectState::Handshaking;
+        deadline = std::chrono::steady_clock::now() + connectTimeout;
+        enet_host_flush(host);
+    }
+
+    bool takePendingPeer(ENetPeer *candidate) {
+        auto it = std::find(pendingPeers.begin(), pendingPeers.end(), candidate);
+        if (it == pendingPeers.end()) {
+            return false;
+        }
+        pendingPeers.erase(it);
+        return true;
+    }
+
     EnetGlobal global;
     ENetHost *host = nullptr;
     ENetPeer *peer = nullptr;
+    std::vector<ENetPeer*> pendingPeers;
+    std::shared_ptr<ResolveJob> resolveJob;
+    ConnectState state = ConnectState::Idle;
+    std::chrono::milliseconds connectTimeout{0};
+    std::chrono::steady_clock::time_point deadline;
     std::optional<std::string> remoteIp;
     std::optional<uint16_t> remotePort;
     static constexpr int channelCount = 2;
+    static constexpr int maxCandidatePeers = 8;
 };
 
+class EnetServerTransport;
+
+// ENet's intercept hook carries no user data; it only runs inside
+// enet_host_service, so the transport being polled is kept here.
+thread_local EnetServerTransport *servicingTransport = nullptr;
+
+int interceptDatagram(ENetHost *host);
+
 class EnetServerTransport final : public IServerTransport {
 public:
     EnetServerTransport(uint16_t port, int maxClients, int numChannels) {
@@ -225,7 +397,12 @@ public:
         channelCount = numChannels;
         if (!host) {
             spdlog::error("ENet server: failed to create host on port {}", port);
+            return;
         }
+        // Generic so it converts to the intercept signature of the ENet in use.
+        host->intercept = [](ENetHost *interceptHost, auto *) -> int {
+            return interceptDatagram(interceptHost);
+        };
     }
 
     ~EnetServerTransport() override {
@@ -235,11 +412,36 @@ public:
         }
     }
 
+    void setDatagramHandler(DatagramHandler handler) override {
+        datagramHandler = std::move(handler);
+    }
+
+    // Called from the intercept hook for every datagram the host receives.
+    bool handleDatagram() {
+        if (!datagramHandler || !host->receivedData || host->receivedDataLength == 0) {
+            return false;
+        }
+        reply.clear();
+        if (!datagramHandler(reinterpret_cast<const std::byte *>(host->receivedData),
+                             host->receivedDataLength,
+                             reply)) {
+            return false;
+        }
+        if (!reply.empty()) {
+            ENetBuffer buffer;
+            buffer.data = reply.data();
+            buffer.dataLength = reply.size();
+            enet_socket_send(host->socket, &host->receivedAddress, &buffer, 1);
+        }
+        return true;
+    }
+
     void poll(std::vector<Event> &outEvents) override {
         if (!host) {
             return;
         }
 
+        servicingTransport = this;
         ENetEvent event;
         while (enet_host_service(host, &event, 0) > 0) {
             switch (event.type) {
@@ -290,6 +492,7 @@ public:
                 break;
             }
         }
+        servicingTransport = nullptr;
     }
 
     void send(ConnectionHandle connection, const std::byte *data, std::size_t size, Delivery delivery, bool flush) override {
@@ -319,12 +522,30 @@ public:
         enet_peer_disconnect(peer, 0);
     }
 
+    std::optional<uint32_t> getRoundTripTimeMs(ConnectionHandle connection) const override {
+        const auto *peer = reinterpret_cast<const ENetPeer*>(connection);
+        if (!peer || peer->state != ENET_PEER_STATE_CONNECTED) {
+            return std::nullopt;
+        }
+        return static_cast<uint32_t>(peer->roundTripTime);
+    }
+
 private:
     EnetGlobal global;
     ENetHost *host = nullptr;
     int channelCount = 1;
+    DatagramHandler datagramHandler;
+    std::vector<std::byte> reply;
 };
 
+int interceptDatagram(ENetHost *host) {
+    EnetServerTransport *transport = servicingTransport;
+    if (!transport || !host) {
+        return 0;
+    }
+    return transport->handleDatagram() ? 1 : 0;
+}
+
 } // namespace
 
 std::unique_ptr<IClientTransport> createEnetClientTransport() {
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -34,11 +35,31 @@ struct Event {
     uint16_t peerPort = 0;
 };
 
+struct ConnectCandidate {
+    std::string host;
+    uint16_t port = 0;
+};
+
+enum class ConnectState {
+    Idle,
+    Resolving,
+    Handshaking,
+    Connected,
+    Failed
+};
+
 class IClientTransport {
 public:
     virtual ~IClientTransport() = default;
 
-    virtual bool connect(const std::string &host, uint16_t port, int timeoutMs) = 0;
+    // Starts connecting without blocking and returns false if the attempt could
+    // not be started. Host names are resolved off the calling thread, and every
+    // resolved address of every candidate is tried at once; the first handshake
+    // to complete wins. poll() drives the attempt and reports success as a
+    // Connect event. A new attempt or disconnect() cancels the previous one.
+    virtual bool beginConnect(const std::vector<ConnectCandidate> &candidates, int timeoutMs) = 0;
+    virtual void cancelConnect() = 0;
+    virtual ConnectState getConnectState() const = 0;
     virtual void disconnect() = 0;
     virtual bool isConnected() const = 0;
 
@@ -52,12 +73,22 @@ public:
 
 class IServerTransport {
 public:
+    // Gets datagrams that reach the server's port but are not part of the
+    // transport protocol, such as latency probes. Returns true if it consumed
+    // the datagram; a non-empty reply is sent straight back to the sender.
+    using DatagramHandler = std::function<bool(const std::byte *data, std::size_t size, std::vector<std::byte> &reply)>;
+
     virtual ~IServerTransport() = default;
 
+    virtual void setDatagramHandler(DatagramHandler handler) = 0;
+
     virtual void poll(std::vector<Event> &outEvents) = 0;
 
     virtual void send(ConnectionHandle connection, const std::byte *data, std::size_t size, Delivery delivery, bool flush) = 0;
     virtual void disconnect(ConnectionHandle connection) = 0;
+
+    // Smoothed round-trip estimate for a connection, if the transport tracks one.
+    virtual std::optional<uint32_t> getRoundTripTimeMs(ConnectionHandle connection) const = 0;
 };
 
 } // namespace net
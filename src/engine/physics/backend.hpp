@@ -1,11 +1,13 @@
 #pragma once
 
 #include "physics/types.hpp"
+#include "common/worker_pool.hpp"
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace physics_backend {
 
@@ -55,6 +57,11 @@ public:
     virtual void destroy() = 0;
 };
 
+struct PlayerStep {
+    PhysicsPlayerControllerBackend* player = nullptr;
+    float deltaTime = 0.0f;
+};
+
 class PhysicsWorldBackend {
 public:
     virtual ~PhysicsWorldBackend() = default;
@@ -65,10 +72,58 @@ public:
                                                                    const glm::vec3& position,
                                                                    const PhysicsMaterial& material) = 0;
     virtual std::unique_ptr<PhysicsPlayerControllerBackend> createPlayer(const glm::vec3& size) = 0;
+    // Steps independent player controllers created by this backend. Backends
+    // that can run them concurrently override this; the default is serial.
+    virtual void updatePlayers(const std::vector<PlayerStep>& steps) {
+        for (const auto& step : steps) {
+            if (step.player) {
+                step.player->update(step.deltaTime);
+            }
+        }
+    }
     virtual std::unique_ptr<PhysicsStaticBodyBackend> createStaticMesh(const std::string& meshPath) = 0;
-    virtual bool raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3& hitPoint, glm::vec3& hitNormal) const = 0;
+
+    // Single queries. Implementations must be safe to call concurrently from
+    // several threads while the world is not being stepped or modified.
+    virtual PhysicsQueryHit castRay(const PhysicsRayQuery& query) const = 0;
+    virtual PhysicsQueryHit castSphere(const PhysicsSphereSweepQuery& query) const = 0;
+    virtual PhysicsQueryHit overlapSphere(const PhysicsSphereOverlapQuery& query) const = 0;
+
+    // Runs every query in the batch, spread across the shared worker pool.
+    virtual void query(const PhysicsQueryBatch& batch, PhysicsQueryResults& results) const {
+        results.rays.resize(batch.rays.size());
+        results.sweeps.resize(batch.sweeps.size());
+        results.overlaps.resize(batch.overlaps.size());
+
+        const std::size_t sweepStart = batch.rays.size();
+        const std::size_t overlapStart = sweepStart + batch.sweeps.size();
+        const std::size_t total = overlapStart + batch.overlaps.size();
+        karma::jobs::SharedWorkerPool().parallelFor(total, [&](std::size_t i) {
+            if (i < sweepStart) {
+                results.rays[i] = castRay(batch.rays[i]);
+            } else if (i < overlapStart) {
+                results.sweeps[i - sweepStart] = castSphere(batch.sweeps[i - sweepStart]);
+            } else {
+                results.overlaps[i - overlapStart] = overlapSphere(batch.overlaps[i - overlapStart]);
+            }
+        }, MIN_QUERIES_PER_TASK);
+    }
+
+protected:
+    // A single query is a few microseconds; smaller chunks cost more to hand
+    // out than to run.
+    static constexpr std::size_t MIN_QUERIES_PER_TASK = 32;
 };
 
 std::unique_ptr<PhysicsWorldBackend> CreatePhysicsWorldBackend();
+// The simulating SDK backend (Jolt or PhysX), even when CreatePhysicsWorldBackend
+// hands out the query-only BVH world on the server.
+std::unique_ptr<PhysicsWorldBackend> CreateSimulationPhysicsWorldBackend();
+
+// Set before creating worlds when several of them tick concurrently in one
+// process (the multi-arena server). Backends then share one job pool between
+// worlds instead of giving each world its own threads.
+void SetConcurrentWorlds(bool concurrent);
+bool ConcurrentWorlds();
 
 } // namespace physics_backend
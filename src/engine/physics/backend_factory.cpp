@@ -8,9 +8,35 @@
 #error "KARMA physics backend not set. Define KARMA_PHYSICS_BACKEND_JOLT or KARMA_PHYSICS_BACKEND_PHYSX."
 #endif
 
+#if defined(KARMA_SERVER) && defined(KARMA_SERVER_PHYSICS_BVH)
+#include "physics/backends/bvh/physics_world_bvh.hpp"
+#endif
+
+#include <atomic>
+
 namespace physics_backend {
 
+namespace {
+std::atomic<bool> g_concurrentWorlds{false};
+} // namespace
+
+void SetConcurrentWorlds(bool concurrent) {
+    g_concurrentWorlds.store(concurrent);
+}
+
+bool ConcurrentWorlds() {
+    return g_concurrentWorlds.load();
+}
+
 std::unique_ptr<PhysicsWorldBackend> CreatePhysicsWorldBackend() {
+#if defined(KARMA_SERVER) && defined(KARMA_SERVER_PHYSICS_BVH)
+    return std::make_unique<PhysicsWorldBvh>();
+#else
+    return CreateSimulationPhysicsWorldBackend();
+#endif
+}
+
+std::unique_ptr<PhysicsWorldBackend> CreateSimulationPhysicsWorldBackend() {
 #if defined(KARMA_PHYSICS_BACKEND_JOLT)
     return std::make_unique<PhysicsWorldJolt>();
 #elif defined(KARMA_PHYSICS_BACKEND_PHYSX)
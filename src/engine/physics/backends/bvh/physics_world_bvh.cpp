@@ -0,0 +1,222 @@
+#include "physics/backends/bvh/physics_world_bvh.hpp"
+#include "physics/backends/bvh/static_body_bvh.hpp"
+#include "physics/backends/bvh/triangle_bvh.hpp"
+#include "common/config_helpers.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// Fraction/normal tolerances for the startup cross-check against the
+// simulation backend; both sides work in single precision.
+constexpr float CROSS_CHECK_FRACTION_TOLERANCE = 1e-3f;
+constexpr float CROSS_CHECK_NORMAL_DOT = 0.99f;
+
+void KeepCloser(PhysicsQueryHit& best, const PhysicsQueryHit& candidate, std::uintptr_t body) {
+    if (candidate.hit && (!best.hit || candidate.fraction < best.fraction)) {
+        best = candidate;
+        best.body = body;
+    }
+}
+
+} // namespace
+
+namespace physics_backend {
+
+void PhysicsWorldBvh::update(float) {
+}
+
+void PhysicsWorldBvh::setGravity(float) {
+}
+
+std::unique_ptr<PhysicsRigidBodyBackend> PhysicsWorldBvh::createBoxBody(const glm::vec3&,
+                                                                        float,
+                                                                        const glm::vec3&,
+                                                                        const PhysicsMaterial&) {
+    if (!warnedNoSimulation_) {
+        spdlog::warn("PhysicsWorldBvh::createBoxBody: The BVH backend is query-only; rigid bodies are not simulated");
+        warnedNoSimulation_ = true;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<PhysicsPlayerControllerBackend> PhysicsWorldBvh::createPlayer(const glm::vec3&) {
+    if (!warnedNoSimulation_) {
+        spdlog::warn("PhysicsWorldBvh::createPlayer: The BVH backend is query-only; player controllers (movementValidation, movement.Authority=server) need the Jolt or PhysX backend");
+        warnedNoSimulation_ = true;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<PhysicsStaticBodyBackend> PhysicsWorldBvh::createStaticMesh(const std::string& meshPath) {
+    auto body = PhysicsStaticBodyBvh::fromMesh(this, meshPath);
+
+    const int crossCheckRays = static_cast<int>(karma::config::ReadFloatConfig({"physics.BvhCrossCheckRays"}, 0.0f));
+    if (crossCheckRays > 0 && body->isValid()) {
+        if (auto bvh = PhysicsStaticBodyBvh::loadMesh(meshPath)) {
+            crossCheck(meshPath, *bvh, crossCheckRays);
+        }
+    }
+    return body;
+}
+
+std::uintptr_t PhysicsWorldBvh::addMesh(std::shared_ptr<const TriangleBvh> bvh) {
+    const std::uintptr_t handle = nextHandle_++;
+    meshes_.push_back(MeshEntry{handle, std::move(bvh)});
+    return handle;
+}
+
+void PhysicsWorldBvh::removeMesh(std::uintptr_t handle) {
+    meshes_.erase(std::remove_if(meshes_.begin(), meshes_.end(),
+                                 [handle](const MeshEntry& mesh) { return mesh.handle == handle; }),
+                  meshes_.end());
+}
+
+bool PhysicsWorldBvh::accepts(const PhysicsQueryFilter& filter, const MeshEntry& mesh) {
+    // Every body in this world is static.
+    return filter.bodies != PhysicsQueryBodies::DynamicOnly && filter.ignoreBody != mesh.handle;
+}
+
+PhysicsQueryHit PhysicsWorldBvh::castRay(const PhysicsRayQuery& query) const {
+    PhysicsQueryHit best;
+    for (const auto& mesh : meshes_) {
+        if (accepts(query.filter, mesh)) {
+            KeepCloser(best, mesh.bvh->castRay(query.from, query.to), mesh.handle);
+        }
+    }
+    return best;
+}
+
+PhysicsQueryHit PhysicsWorldBvh::castSphere(const PhysicsSphereSweepQuery& query) const {
+    PhysicsQueryHit best;
+    for (const auto& mesh : meshes_) {
+        if (accepts(query.filter, mesh)) {
+            KeepCloser(best, mesh.bvh->castSphere(query.from, query.to, query.radius), mesh.handle);
+        }
+    }
+    return best;
+}
+
+PhysicsQueryHit PhysicsWorldBvh::overlapSphere(const PhysicsSphereOverlapQuery& query) const {
+    for (const auto& mesh : meshes_) {
+        if (!accepts(query.filter, mesh)) {
+            continue;
+        }
+        PhysicsQueryHit hit = mesh.bvh->overlapSphere(query.center, query.radius);
+        if (hit.hit) {
+            hit.body = mesh.handle;
+            return hit;
+        }
+    }
+    return PhysicsQueryHit{};
+}
+
+void PhysicsWorldBvh::castRayPacket(const PhysicsRayQuery* rays, std::size_t count, PhysicsQueryHit* hits) const {
+    for (std::size_t r = 0; r < count; ++r) {
+        hits[r] = PhysicsQueryHit{};
+    }
+    PhysicsQueryHit meshHits[TriangleBvh::PACKET_SIZE];
+    for (const auto& mesh : meshes_) {
+        bool allAccept = true;
+        for (std::size_t r = 0; r < count; ++r) {
+            allAccept = allAccept && accepts(rays[r].filter, mesh);
+        }
+        if (allAccept) {
+            mesh.bvh->castRayPacket(rays, count, meshHits);
+            for (std::size_t r = 0; r < count; ++r) {
+                KeepCloser(hits[r], meshHits[r], mesh.handle);
+            }
+            continue;
+        }
+        for (std::size_t r = 0; r < count; ++r) {
+            if (accepts(rays[r].filter, mesh)) {
+                KeepCloser(hits[r], mesh.bvh->castRay(rays[r].from, rays[r].to), mesh.handle);
+            }
+        }
+    }
+}
+
+void PhysicsWorldBvh::query(const PhysicsQueryBatch& batch, PhysicsQueryResults& results) const {
+    results.rays.resize(batch.rays.size());
+    results.sweeps.resize(batch.sweeps.size());
+    results.overlaps.resize(batch.overlaps.size());
+
+    // Callers build batches in spatial order (shots in creation order, grid
+    // bakes row by row), so neighbouring rays make reasonably coherent packets.
+    const std::size_t packetCount = (batch.rays.size() + TriangleBvh::PACKET_SIZE - 1) / TriangleBvh::PACKET_SIZE;
+    const std::size_t sweepStart = packetCount;
+    const std::size_t overlapStart = sweepStart + batch.sweeps.size();
+    const std::size_t total = overlapStart + batch.overlaps.size();
+    karma::jobs::SharedWorkerPool().parallelFor(total, [&](std::size_t i) {
+        if (i < sweepStart) {
+            const std::size_t first = i * TriangleBvh::PACKET_SIZE;
+            const std::size_t count = std::min(TriangleBvh::PACKET_SIZE, batch.rays.size() - first);
+            castRayPacket(batch.rays.data() + first, count, results.rays.data() + first);
+        } else if (i < overlapStart) {
+            results.sweeps[i - sweepStart] = castSphere(batch.sweeps[i - sweepStart]);
+        } else {
+            results.overlaps[i - overlapStart] = overlapSphere(batch.overlaps[i - overlapStart]);
+        }
+    }, MIN_QUERIES_PER_TASK / TriangleBvh::PACKET_SIZE);
+}
+
+void PhysicsWorldBvh::crossCheck(const std::string& meshPath, const TriangleBvh& bvh, int rayCount) const {
+    std::unique_ptr<PhysicsWorldBackend> reference = CreateSimulationPhysicsWorldBackend();
+    if (!reference) {
+        return;
+    }
+    auto referenceBody = reference->createStaticMesh(meshPath);
+    if (!referenceBody || !referenceBody->isValid()) {
+        spdlog::warn("PhysicsWorldBvh::crossCheck: Reference backend could not load {}", meshPath);
+        return;
+    }
+
+    // Half the rays fall straight down (spawn/ground queries), half are random
+    // segments through the mesh bounds (shots).
+    std::mt19937 rng(1234);
+    const glm::vec3 lo = bvh.boundsMin() - glm::vec3(1.0f);
+    const glm::vec3 hi = bvh.boundsMax() + glm::vec3(1.0f);
+    std::uniform_real_distribution<float> distX(lo.x, hi.x);
+    std::uniform_real_distribution<float> distY(lo.y, hi.y);
+    std::uniform_real_distribution<float> distZ(lo.z, hi.z);
+
+    int mismatches = 0;
+    for (int i = 0; i < rayCount; ++i) {
+        PhysicsRayQuery ray;
+        if (i % 2 == 0) {
+            const float x = distX(rng);
+            const float z = distZ(rng);
+            ray.from = glm::vec3(x, hi.y, z);
+            ray.to = glm::vec3(x, lo.y, z);
+        } else {
+            ray.from = glm::vec3(distX(rng), distY(rng), distZ(rng));
+            ray.to = glm::vec3(distX(rng), distY(rng), distZ(rng));
+        }
+
+        const PhysicsQueryHit ours = bvh.castRay(ray.from, ray.to);
+        const PhysicsQueryHit theirs = reference->castRay(ray);
+        bool agree = ours.hit == theirs.hit;
+        if (agree && ours.hit) {
+            agree = std::fabs(ours.fraction - theirs.fraction) <= CROSS_CHECK_FRACTION_TOLERANCE &&
+                    glm::dot(ours.normal, theirs.normal) >= CROSS_CHECK_NORMAL_DOT;
+        }
+        if (!agree) {
+            ++mismatches;
+            spdlog::debug("PhysicsWorldBvh::crossCheck: ray ({}, {}, {}) -> ({}, {}, {}): bvh hit={} f={} ref hit={} f={}",
+                          ray.from.x, ray.from.y, ray.from.z, ray.to.x, ray.to.y, ray.to.z,
+                          ours.hit, ours.fraction, theirs.hit, theirs.fraction);
+        }
+    }
+
+    referenceBody->destroy();
+    if (mismatches > 0) {
+        spdlog::warn("PhysicsWorldBvh::crossCheck: {} of {} rays disagree with the reference backend on {}",
+                     mismatches, rayCount, meshPath);
+    } else {
+        spdlog::info("PhysicsWorldBvh::crossCheck: All {} rays match the reference backend on {}", rayCount, meshPath);
+    }
+}
+
+} // namespace physics_backend
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "physics/backend.hpp"
+#include <memory>
+#include <vector>
+
+namespace physics_backend {
+
+class TriangleBvh;
+
+// Query-only world for the dedicated server: static meshes are kept as
+// triangle BVHs and there is no simulation, so bodies and player controllers
+// are not available. Selected with KARMA_SERVER_PHYSICS_BACKEND=bvh.
+class PhysicsWorldBvh final : public PhysicsWorldBackend {
+public:
+    PhysicsWorldBvh() = default;
+    ~PhysicsWorldBvh() override = default;
+
+    void update(float deltaTime) override;
+    void setGravity(float gravity) override;
+    std::unique_ptr<PhysicsRigidBodyBackend> createBoxBody(const glm::vec3& halfExtents,
+                                                           float mass,
+                                                           const glm::vec3& position,
+                                                           const PhysicsMaterial& material) override;
+    std::unique_ptr<PhysicsPlayerControllerBackend> createPlayer(const glm::vec3& size) override;
+    std::unique_ptr<PhysicsStaticBodyBackend> createStaticMesh(const std::string& meshPath) override;
+
+    PhysicsQueryHit castRay(const PhysicsRayQuery& query) const override;
+    PhysicsQueryHit castSphere(const PhysicsSphereSweepQuery& query) const override;
+    PhysicsQueryHit overlapSphere(const PhysicsSphereOverlapQuery& query) const override;
+    // Rays are traced in packets of TriangleBvh::PACKET_SIZE.
+    void query(const PhysicsQueryBatch& batch, PhysicsQueryResults& results) const override;
+
+    std::uintptr_t addMesh(std::shared_ptr<const TriangleBvh> bvh);
+    void removeMesh(std::uintptr_t handle);
+
+private:
+    struct MeshEntry {
+        std::uintptr_t handle = 0;
+        std::shared_ptr<const TriangleBvh> bvh;
+    };
+
+    static bool accepts(const PhysicsQueryFilter& filter, const MeshEntry& mesh);
+    void castRayPacket(const PhysicsRayQuery* rays, std::size_t count, PhysicsQueryHit* hits) const;
+    void crossCheck(const std::string& meshPath, const TriangleBvh& bvh, int rayCount) const;
+
+    std::vector<MeshEntry> meshes_;
+    std::uintptr_t nextHandle_ = 1;
+    bool warnedNoSimulation_ = false;
+};
+
+} // namespace physics_backend
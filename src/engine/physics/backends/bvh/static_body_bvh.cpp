@@ -0,0 +1,117 @@
+#include "physics/backends/bvh/static_body_bvh.hpp"
+#include "physics/backends/bvh/physics_world_bvh.hpp"
+#include "physics/backends/bvh/triangle_bvh.hpp"
+#include "karma/geometry/mesh_loader.hpp"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Same sharing scheme as the Jolt mesh shapes: one immutable BVH per file,
+// rebuilt when the file's write time changes.
+struct CachedMeshBvh {
+    std::filesystem::file_time_type writeTime;
+    std::shared_ptr<const physics_backend::TriangleBvh> bvh;
+};
+std::mutex g_meshBvhMutex;
+std::unordered_map<std::string, CachedMeshBvh> g_meshBvhs;
+
+std::shared_ptr<const physics_backend::TriangleBvh> buildMeshBvh(const std::string& meshPath) {
+    std::vector<MeshLoader::MeshData> meshes = MeshLoader::loadGLB(meshPath);
+    if (meshes.empty()) {
+        spdlog::warn("PhysicsStaticBodyBvh::fromMesh: No meshes found at {}", meshPath);
+        return nullptr;
+    }
+
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+    for (const auto& mesh : meshes) {
+        const uint32_t base = static_cast<uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        if (mesh.indices.size() % 3 != 0) {
+            spdlog::warn("PhysicsStaticBodyBvh::fromMesh: Mesh {} has non-multiple-of-3 indices; skipping remainder", meshPath);
+        }
+        for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            indices.push_back(base + mesh.indices[i]);
+            indices.push_back(base + mesh.indices[i + 1]);
+            indices.push_back(base + mesh.indices[i + 2]);
+        }
+    }
+
+    auto bvh = std::make_shared<physics_backend::TriangleBvh>();
+    bvh->build(vertices, indices);
+    if (bvh->empty()) {
+        spdlog::warn("PhysicsStaticBodyBvh::fromMesh: Mesh {} has no usable triangles", meshPath);
+        return nullptr;
+    }
+    spdlog::info("PhysicsStaticBodyBvh::fromMesh: Built BVH for {} ({} triangles, {} nodes, {:.1f} KiB)",
+                 meshPath, bvh->triangleCount(), bvh->nodeCount(), static_cast<double>(bvh->memoryBytes()) / 1024.0);
+    return bvh;
+}
+
+} // namespace
+
+namespace physics_backend {
+
+PhysicsStaticBodyBvh::PhysicsStaticBodyBvh(PhysicsWorldBvh* world, std::uintptr_t handle)
+    : world_(world), handle_(handle) {}
+
+PhysicsStaticBodyBvh::~PhysicsStaticBodyBvh() {
+    destroy();
+}
+
+bool PhysicsStaticBodyBvh::isValid() const {
+    return world_ != nullptr && handle_ != 0;
+}
+
+glm::vec3 PhysicsStaticBodyBvh::getPosition() const {
+    return glm::vec3(0.0f);
+}
+
+glm::quat PhysicsStaticBodyBvh::getRotation() const {
+    return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void PhysicsStaticBodyBvh::destroy() {
+    if (world_ && handle_ != 0) {
+        world_->removeMesh(handle_);
+    }
+    world_ = nullptr;
+    handle_ = 0;
+}
+
+std::uintptr_t PhysicsStaticBodyBvh::nativeHandle() const {
+    return handle_;
+}
+
+std::shared_ptr<const TriangleBvh> PhysicsStaticBodyBvh::loadMesh(const std::string& meshPath) {
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(meshPath, ec);
+
+    std::lock_guard<std::mutex> lock(g_meshBvhMutex);
+    auto it = g_meshBvhs.find(meshPath);
+    if (!ec && it != g_meshBvhs.end() && it->second.writeTime == writeTime) {
+        return it->second.bvh;
+    }
+
+    std::shared_ptr<const TriangleBvh> bvh = buildMeshBvh(meshPath);
+    if (bvh && !ec) {
+        g_meshBvhs[meshPath] = CachedMeshBvh{writeTime, bvh};
+    }
+    return bvh;
+}
+
+std::unique_ptr<PhysicsStaticBodyBackend> PhysicsStaticBodyBvh::fromMesh(PhysicsWorldBvh* world, const std::string& meshPath) {
+    if (!world) return std::make_unique<PhysicsStaticBodyBvh>();
+
+    std::shared_ptr<const TriangleBvh> bvh = loadMesh(meshPath);
+    if (!bvh) {
+        return std::make_unique<PhysicsStaticBodyBvh>();
+    }
+    return std::make_unique<PhysicsStaticBodyBvh>(world, world->addMesh(std::move(bvh)));
+}
+
+} // namespace physics_backend
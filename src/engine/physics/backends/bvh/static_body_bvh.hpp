@@ -0,0 +1,32 @@
+#pragma once
+
+#include "physics/backend.hpp"
+#include <memory>
+
+namespace physics_backend {
+
+class PhysicsWorldBvh;
+class TriangleBvh;
+
+class PhysicsStaticBodyBvh final : public PhysicsStaticBodyBackend {
+public:
+    PhysicsStaticBodyBvh() = default;
+    PhysicsStaticBodyBvh(PhysicsWorldBvh* world, std::uintptr_t handle);
+    ~PhysicsStaticBodyBvh() override;
+
+    bool isValid() const override;
+    glm::vec3 getPosition() const override;
+    glm::quat getRotation() const override;
+    void destroy() override;
+    std::uintptr_t nativeHandle() const override;
+
+    static std::unique_ptr<PhysicsStaticBodyBackend> fromMesh(PhysicsWorldBvh* world, const std::string& meshPath);
+    // Builds (or reuses) the BVH for a mesh file without adding it to a world.
+    static std::shared_ptr<const TriangleBvh> loadMesh(const std::string& meshPath);
+
+private:
+    PhysicsWorldBvh* world_ = nullptr;
+    std::uintptr_t handle_ = 0;
+};
+
+} // namespace physics_backend
@@ -0,0 +1,851 @@
+#include "physics/backends/bvh/triangle_bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define KARMA_BVH_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define KARMA_BVH_NEON 1
+#endif
+
+namespace physics_backend {
+
+namespace {
+
+constexpr uint32_t SAH_BINS = 16;
+constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+// SAH may keep a larger leaf when splitting doesn't pay; never beyond this.
+constexpr uint32_t MAX_SAH_LEAF_TRIANGLES = 16;
+constexpr uint32_t MAX_BUILD_DEPTH = 64;
+constexpr std::size_t TRAVERSAL_STACK_SIZE = 256;
+constexpr uint32_t NO_TRIANGLE = std::numeric_limits<uint32_t>::max();
+constexpr float MIN_TRIANGLE_AREA = 1e-12f;
+
+struct Bounds {
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    void grow(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void grow(const Bounds& b) {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+    bool valid() const { return min.x <= max.x; }
+    float area() const {
+        if (!valid()) return 0.0f;
+        const glm::vec3 e = max - min;
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+};
+
+struct BuildPrim {
+    Bounds bounds;
+    glm::vec3 centroid;
+};
+
+struct BuildNode {
+    Bounds bounds;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+
+    bool isLeaf() const { return count > 0; }
+};
+
+struct RayData {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 invDirection;
+};
+
+// Clamped rather than infinite so 0 * invDir never turns into NaN in the slab test.
+float SafeInverse(float v) {
+    constexpr float LARGE = 1e30f;
+    if (std::fabs(v) > 1e-30f) {
+        return 1.0f / v;
+    }
+    return std::signbit(v) ? -LARGE : LARGE;
+}
+
+RayData MakeRay(const glm::vec3& from, const glm::vec3& to) {
+    const glm::vec3 direction = to - from;
+    return RayData{from, direction, glm::vec3(SafeInverse(direction.x), SafeInverse(direction.y), SafeInverse(direction.z))};
+}
+
+// Slab test of one ray against the node's four child boxes, each grown by
+// `inflate` on every side. Returns a bit per child whose entry distance is
+// within [0, tLimit] and writes those entry distances to tNear.
+template <typename NodeT>
+int TestChildBoxes(const NodeT& node, const RayData& ray, float inflate, float tLimit, float* tNear) {
+#if defined(KARMA_BVH_SSE)
+    const __m128 grow = _mm_set1_ps(inflate);
+    const __m128 ox = _mm_set1_ps(ray.origin.x);
+    const __m128 oy = _mm_set1_ps(ray.origin.y);
+    const __m128 oz = _mm_set1_ps(ray.origin.z);
+    const __m128 ix = _mm_set1_ps(ray.invDirection.x);
+    const __m128 iy = _mm_set1_ps(ray.invDirection.y);
+    const __m128 iz = _mm_set1_ps(ray.invDirection.z);
+
+    const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(node.minX), grow), ox), ix);
+    const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_loadu_ps(node.maxX), grow), ox), ix);
+    const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(node.minY), grow), oy), iy);
+    const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_loadu_ps(node.maxY), grow), oy), iy);
+    const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_loadu_ps(node.minZ), grow), oz), iz);
+    const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_loadu_ps(node.maxZ), grow), oz), iz);
+
+    const __m128 tEnter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)),
+                                     _mm_max_ps(_mm_min_ps(t0z, t1z), _mm_setzero_ps()));
+    const __m128 tExit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)),
+                                    _mm_min_ps(_mm_max_ps(t0z, t1z), _mm_set1_ps(tLimit)));
+    _mm_storeu_ps(tNear, tEnter);
+    const int mask = _mm_movemask_ps(_mm_cmple_ps(tEnter, tExit));
+#elif defined(KARMA_BVH_NEON)
+    const float32x4_t grow = vdupq_n_f32(inflate);
+    const float32x4_t ox = vdupq_n_f32(ray.origin.x);
+    const float32x4_t oy = vdupq_n_f32(ray.origin.y);
+    const float32x4_t oz = vdupq_n_f32(ray.origin.z);
+    const float32x4_t ix = vdupq_n_f32(ray.invDirection.x);
+    const float32x4_t iy = vdupq_n_f32(ray.invDirection.y);
+    const float32x4_t iz = vdupq_n_f32(ray.invDirection.z);
+
+    const float32x4_t t0x = vmulq_f32(vsubq_f32(vsubq_f32(vld1q_f32(node.minX), grow), ox), ix);
+    const float32x4_t t1x = vmulq_f32(vsubq_f32(vaddq_f32(vld1q_f32(node.maxX), grow), ox), ix);
+    const float32x4_t t0y = vmulq_f32(vsubq_f32(vsubq_f32(vld1q_f32(node.minY), grow), oy), iy);
+    const float32x4_t t1y = vmulq_f32(vsubq_f32(vaddq_f32(vld1q_f32(node.maxY), grow), oy), iy);
+    const float32x4_t t0z = vmulq_f32(vsubq_f32(vsubq_f32(vld1q_f32(node.minZ), grow), oz), iz);
+    const float32x4_t t1z = vmulq_f32(vsubq_f32(vaddq_f32(vld1q_f32(node.maxZ), grow), oz), iz);
+
+    const float32x4_t tEnter = vmaxq_f32(vmaxq_f32(vminq_f32(t0x, t1x), vminq_f32(t0y, t1y)),
+                                         vmaxq_f32(vminq_f32(t0z, t1z), vdupq_n_f32(0.0f)));
+    const float32x4_t tExit = vminq_f32(vminq_f32(vmaxq_f32(t0x, t1x), vmaxq_f32(t0y, t1y)),
+                                        vminq_f32(vmaxq_f32(t0z, t1z), vdupq_n_f32(tLimit)));
+    vst1q_f32(tNear, tEnter);
+    const uint32x4_t inside = vcleq_f32(tEnter, tExit);
+    const int mask = static_cast<int>((vgetq_lane_u32(inside, 0) & 1u) |
+                                      ((vgetq_lane_u32(inside, 1) & 1u) << 1) |
+                                      ((vgetq_lane_u32(inside, 2) & 1u) << 2) |
+                                      ((vgetq_lane_u32(inside, 3) & 1u) << 3));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const float t0x = (node.minX[i] - inflate - ray.origin.x) * ray.invDirection.x;
+        const float t1x = (node.maxX[i] + inflate - ray.origin.x) * ray.invDirection.x;
+        const float t0y = (node.minY[i] - inflate - ray.origin.y) * ray.invDirection.y;
+        const float t1y = (node.maxY[i] + inflate - ray.origin.y) * ray.invDirection.y;
+        const float t0z = (node.minZ[i] - inflate - ray.origin.z) * ray.invDirection.z;
+        const float t1z = (node.maxZ[i] + inflate - ray.origin.z) * ray.invDirection.z;
+        const float tEnter = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), 0.0f));
+        const float tExit = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), tLimit));
+        tNear[i] = tEnter;
+        mask |= (tEnter <= tExit ? 1 : 0) << i;
+    }
+#endif
+    // Unused slots hold inverted boxes, which the min/max slab test can't reject.
+    return mask & ((1 << node.childCount) - 1);
+}
+
+// Triangles are hit from both sides, so the face normal is flipped to face
+// the ray, as a surface normal seen from the caster should.
+glm::vec3 FacingNormal(const glm::vec3& edge1, const glm::vec3& edge2, const glm::vec3& direction) {
+    const glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+    return glm::dot(normal, direction) > 0.0f ? -normal : normal;
+}
+
+// Double-sided Möller–Trumbore; t is a fraction of the (unnormalized) direction.
+bool RayTriangle(const RayData& ray, const glm::vec3& v0, const glm::vec3& edge1, const glm::vec3& edge2,
+                 float tMax, float& tOut) {
+    const glm::vec3 p = glm::cross(ray.direction, edge2);
+    const float det = glm::dot(edge1, p);
+    if (std::fabs(det) < 1e-20f) {
+        return false;
+    }
+    const float invDet = 1.0f / det;
+    const glm::vec3 s = ray.origin - v0;
+    const float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const glm::vec3 q = glm::cross(s, edge1);
+    const float v = glm::dot(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    const float t = glm::dot(edge2, q) * invDet;
+    if (t < 0.0f || t > tMax) {
+        return false;
+    }
+    tOut = t;
+    return true;
+}
+
+// Closest point on triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5).
+glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+    const glm::vec3 ap = p - a;
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+bool PointInTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& n) {
+    return glm::dot(glm::cross(b - a, p - a), n) >= 0.0f &&
+           glm::dot(glm::cross(c - b, p - b), n) >= 0.0f &&
+           glm::dot(glm::cross(a - c, p - c), n) >= 0.0f;
+}
+
+// First time in [0, tMax] a sphere of radius r moving along the ray touches the point c.
+bool SweepSphereVertex(const RayData& ray, const glm::vec3& c, float r, float tMax, float& tOut) {
+    const glm::vec3 m = ray.origin - c;
+    const float cc = glm::dot(m, m) - r * r;
+    if (cc <= 0.0f) {
+        tOut = 0.0f;
+        return true;
+    }
+    const float b = glm::dot(m, ray.direction);
+    if (b >= 0.0f) {
+        return false;
+    }
+    const float a = glm::dot(ray.direction, ray.direction);
+    const float disc = b * b - a * cc;
+    if (disc < 0.0f) {
+        return false;
+    }
+    const float t = (-b - std::sqrt(disc)) / a;
+    if (t > tMax) {
+        return false;
+    }
+    tOut = std::max(t, 0.0f);
+    return true;
+}
+
+// First time the moving sphere touches the open segment ab (side of the capsule).
+bool SweepSphereEdge(const RayData& ray, const glm::vec3& a, const glm::vec3& b, float r, float tMax, float& tOut) {
+    const glm::vec3 e = b - a;
+    const glm::vec3 m = ray.origin - a;
+    const float ee = glm::dot(e, e);
+    if (ee < MIN_TRIANGLE_AREA) {
+        return false;
+    }
+    const float de = glm::dot(ray.direction, e);
+    const float me = glm::dot(m, e);
+    const float c = ee * (glm::dot(m, m) - r * r) - me * me;
+    if (c <= 0.0f) {
+        // Starts inside the infinite cylinder; only a hit if also beside the segment.
+        const float s = me / ee;
+        if (s < 0.0f || s > 1.0f) {
+            return false;
+        }
+        tOut = 0.0f;
+        return true;
+    }
+
+    const float a2 = ee * glm::dot(ray.direction, ray.direction) - de * de;
+    const float b2 = ee * glm::dot(m, ray.direction) - me * de;
+    if (std::fabs(a2) < 1e-20f || b2 >= 0.0f) {
+        return false;
+    }
+    const float disc = b2 * b2 - a2 * c;
+    if (disc < 0.0f) {
+        return false;
+    }
+    const float t = (-b2 - std::sqrt(disc)) / a2;
+    if (t < 0.0f || t > tMax) {
+        return false;
+    }
+    const float s = (me + t * de) / ee;
+    if (s < 0.0f || s > 1.0f) {
+        return false;
+    }
+    tOut = t;
+    return true;
+}
+
+struct SweepContact {
+    float t = 0.0f;
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f};
+};
+
+bool SweepSphereTriangle(const RayData& ray, float r, const glm::vec3& v0, const glm::vec3& edge1, const glm::vec3& edge2,
+                         float tMax, SweepContact& contact) {
+    glm::vec3 n = glm::cross(edge1, edge2);
+    const float nLength = glm::length(n);
+    if (nLength < MIN_TRIANGLE_AREA) {
+        return false;
+    }
+    n /= nLength;
+    const glm::vec3 v1 = v0 + edge1;
+    const glm::vec3 v2 = v0 + edge2;
+
+    // Face: the sphere first touches the plane inside the triangle.
+    const float dist0 = glm::dot(ray.origin - v0, n);
+    const float side = dist0 >= 0.0f ? 1.0f : -1.0f;
+    if (std::fabs(dist0) <= r) {
+        const glm::vec3 projected = ray.origin - dist0 * n;
+        if (PointInTriangle(projected, v0, v1, v2, n)) {
+            contact = SweepContact{0.0f, projected, side * n};
+            return true;
+        }
+    } else {
+        const float denom = glm::dot(ray.direction, n);
+        if (dist0 * denom < 0.0f) {
+            const float t = (side * r - dist0) / denom;
+            const glm::vec3 touch = ray.origin + t * ray.direction - side * r * n;
+            if (t <= tMax && PointInTriangle(touch, v0, v1, v2, n)) {
+                // Nothing on the triangle can be touched before its face.
+                contact = SweepContact{t, touch, side * n};
+                return true;
+            }
+        }
+    }
+
+    // Otherwise the first contact is on an edge or a vertex.
+    bool found = false;
+    float best = tMax;
+    float t = 0.0f;
+    const std::array<glm::vec3, 3> corners{v0, v1, v2};
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (SweepSphereEdge(ray, corners[i], corners[(i + 1) % 3], r, best, t)) {
+            best = t;
+            found = true;
+        }
+        if (SweepSphereVertex(ray, corners[i], r, best, t)) {
+            best = t;
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    const glm::vec3 center = ray.origin + best * ray.direction;
+    const glm::vec3 touch = ClosestPointOnTriangle(center, v0, v1, v2);
+    const glm::vec3 away = center - touch;
+    const float awayLength = glm::length(away);
+    contact = SweepContact{best, touch, awayLength > 1e-6f ? away / awayLength : side * n};
+    return true;
+}
+
+struct StackEntry {
+    uint32_t ref;
+    uint32_t count;
+    float tNear;
+};
+
+} // namespace
+
+void TriangleBvh::build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices) {
+    nodes_.clear();
+    triangles_.clear();
+
+    std::vector<Triangle> source;
+    std::vector<BuildPrim> prims;
+    source.reserve(indices.size() / 3);
+    prims.reserve(indices.size() / 3);
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size()) {
+            continue;
+        }
+        const glm::vec3& a = vertices[indices[i]];
+        const glm::vec3& b = vertices[indices[i + 1]];
+        const glm::vec3& c = vertices[indices[i + 2]];
+        if (glm::length(glm::cross(b - a, c - a)) < MIN_TRIANGLE_AREA) {
+            continue;
+        }
+        source.push_back(Triangle{a, b - a, c - a});
+
+        BuildPrim prim;
+        prim.bounds.grow(a);
+        prim.bounds.grow(b);
+        prim.bounds.grow(c);
+        prim.centroid = (a + b + c) / 3.0f;
+        prims.push_back(prim);
+    }
+    if (prims.empty()) {
+        return;
+    }
+
+    const uint32_t primCount = static_cast<uint32_t>(prims.size());
+    std::vector<uint32_t> order(primCount);
+    std::iota(order.begin(), order.end(), 0u);
+
+    // Binary SAH build over `order`; leaves reference contiguous ranges of it.
+    std::vector<BuildNode> buildNodes;
+    buildNodes.reserve(primCount * 2);
+    BuildNode root;
+    root.first = 0;
+    root.count = primCount;
+    for (const auto& prim : prims) {
+        root.bounds.grow(prim.bounds);
+    }
+    buildNodes.push_back(root);
+
+    struct BuildTask {
+        uint32_t node;
+        uint32_t depth;
+    };
+    std::vector<BuildTask> tasks{{0, 0}};
+    while (!tasks.empty()) {
+        const BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        const uint32_t first = buildNodes[task.node].first;
+        const uint32_t count = buildNodes[task.node].count;
+        if (count <= MAX_LEAF_TRIANGLES || task.depth >= MAX_BUILD_DEPTH) {
+            continue;
+        }
+
+        Bounds centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i) {
+            centroidBounds.grow(prims[order[i]].centroid);
+        }
+        const glm::vec3 centroidExtent = centroidBounds.max - centroidBounds.min;
+
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centroidExtent[axis] <= 1e-6f) {
+                continue;
+            }
+            const float scale = static_cast<float>(SAH_BINS) / centroidExtent[axis];
+            std::array<Bounds, SAH_BINS> binBounds{};
+            std::array<uint32_t, SAH_BINS> binCounts{};
+            for (uint32_t i = first; i < first + count; ++i) {
+                const BuildPrim& prim = prims[order[i]];
+                const uint32_t bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((prim.centroid[axis] - centroidBounds.min[axis]) * scale));
+                binBounds[bin].grow(prim.bounds);
+                ++binCounts[bin];
+            }
+
+            std::array<float, SAH_BINS - 1> leftCost{};
+            Bounds leftBounds;
+            uint32_t leftCount = 0;
+            for (uint32_t i = 0; i < SAH_BINS - 1; ++i) {
+                leftBounds.grow(binBounds[i]);
+                leftCount += binCounts[i];
+                leftCost[i] = leftBounds.area() * static_cast<float>(leftCount);
+            }
+            Bounds rightBounds;
+            uint32_t rightCount = 0;
+            for (uint32_t i = SAH_BINS - 1; i > 0; --i) {
+                rightBounds.grow(binBounds[i]);
+                rightCount += binCounts[i];
+                const float cost = leftCost[i - 1] + rightBounds.area() * static_cast<float>(rightCount);
+                if (rightCount > 0 && rightCount < count && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        const float leafCost = buildNodes[task.node].bounds.area() * static_cast<float>(count);
+        if (bestCost >= leafCost && count <= MAX_SAH_LEAF_TRIANGLES) {
+            continue;
+        }
+
+        uint32_t mid = first;
+        if (bestAxis >= 0) {
+            const float scale = static_cast<float>(SAH_BINS) / centroidExtent[bestAxis];
+            const float minCentroid = centroidBounds.min[bestAxis];
+            auto* split = std::partition(order.data() + first, order.data() + first + count, [&](uint32_t index) {
+                const uint32_t bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((prims[index].centroid[bestAxis] - minCentroid) * scale));
+                return bin < bestSplit;
+            });
+            mid = static_cast<uint32_t>(split - order.data());
+        }
+        if (mid == first || mid == first + count) {
+            // No usable SAH split (e.g. coincident centroids): split at the median.
+            int axis = 0;
+            if (centroidExtent.y > centroidExtent[axis]) axis = 1;
+            if (centroidExtent.z > centroidExtent[axis]) axis = 2;
+            mid = first + count / 2;
+            std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                             [&](uint32_t a, uint32_t b) { return prims[a].centroid[axis] < prims[b].centroid[axis]; });
+        }
+
+        BuildNode left;
+        left.first = first;
+        left.count = mid - first;
+        for (uint32_t i = left.first; i < left.first + left.count; ++i) {
+            left.bounds.grow(prims[order[i]].bounds);
+        }
+        BuildNode right;
+        right.first = mid;
+        right.count = first + count - mid;
+        for (uint32_t i = right.first; i < right.first + right.count; ++i) {
+            right.bounds.grow(prims[order[i]].bounds);
+        }
+
+        const uint32_t leftIndex = static_cast<uint32_t>(buildNodes.size());
+        buildNodes.push_back(left);
+        buildNodes.push_back(right);
+        buildNodes[task.node].left = leftIndex;
+        buildNodes[task.node].right = leftIndex + 1;
+        buildNodes[task.node].count = 0;
+        tasks.push_back({leftIndex, task.depth + 1});
+        tasks.push_back({leftIndex + 1, task.depth + 1});
+    }
+
+    triangles_.reserve(primCount);
+    for (uint32_t index : order) {
+        triangles_.push_back(source[index]);
+    }
+
+    // Collapse the binary tree into 4-wide nodes, opening the largest inner
+    // child first so each node's boxes are as tight as possible.
+    nodes_.reserve(buildNodes.size() / 2 + 1);
+    auto collapse = [&](auto&& self, uint32_t buildIndex) -> uint32_t {
+        std::array<uint32_t, 4> children{};
+        uint32_t childCount = 0;
+        if (buildNodes[buildIndex].isLeaf()) {
+            children[childCount++] = buildIndex;
+        } else {
+            children[childCount++] = buildNodes[buildIndex].left;
+            children[childCount++] = buildNodes[buildIndex].right;
+            while (childCount < 4) {
+                int largest = -1;
+                float largestArea = -1.0f;
+                for (uint32_t i = 0; i < childCount; ++i) {
+                    const BuildNode& child = buildNodes[children[i]];
+                    if (!child.isLeaf() && child.bounds.area() > largestArea) {
+                        largest = static_cast<int>(i);
+                        largestArea = child.bounds.area();
+                    }
+                }
+                if (largest < 0) {
+                    break;
+                }
+                const BuildNode& opened = buildNodes[children[largest]];
+                children[largest] = opened.left;
+                children[childCount++] = opened.right;
+            }
+        }
+
+        const uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back(Node{});
+        for (uint32_t i = 0; i < 4; ++i) {
+            Node& node = nodes_[nodeIndex];
+            if (i >= childCount) {
+                node.minX[i] = node.minY[i] = node.minZ[i] = std::numeric_limits<float>::max();
+                node.maxX[i] = node.maxY[i] = node.maxZ[i] = std::numeric_limits<float>::lowest();
+                node.child[i] = 0;
+                node.triangleCount[i] = 0;
+                continue;
+            }
+            const BuildNode& child = buildNodes[children[i]];
+            node.minX[i] = child.bounds.min.x;
+            node.minY[i] = child.bounds.min.y;
+            node.minZ[i] = child.bounds.min.z;
+            node.maxX[i] = child.bounds.max.x;
+            node.maxY[i] = child.bounds.max.y;
+            node.maxZ[i] = child.bounds.max.z;
+            if (child.isLeaf()) {
+                node.child[i] = child.first | LEAF_BIT;
+                node.triangleCount[i] = child.count;
+            } else {
+                const uint32_t childNode = self(self, children[i]);
+                nodes_[nodeIndex].child[i] = childNode;
+                nodes_[nodeIndex].triangleCount[i] = 0;
+            }
+        }
+        nodes_[nodeIndex].childCount = childCount;
+        return nodeIndex;
+    };
+    collapse(collapse, 0);
+
+    boundsMin_ = buildNodes[0].bounds.min;
+    boundsMax_ = buildNodes[0].bounds.max;
+}
+
+std::size_t TriangleBvh::memoryBytes() const {
+    return nodes_.capacity() * sizeof(Node) + triangles_.capacity() * sizeof(Triangle);
+}
+
+PhysicsQueryHit TriangleBvh::castRay(const glm::vec3& from, const glm::vec3& to) const {
+    PhysicsQueryHit hit;
+    if (nodes_.empty()) {
+        return hit;
+    }
+
+    const RayData ray = MakeRay(from, to);
+    float best = 1.0f;
+    uint32_t bestTriangle = NO_TRIANGLE;
+
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = StackEntry{0, 0, 0.0f};
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.tNear > best) {
+            continue;
+        }
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.ref; i < entry.ref + entry.count; ++i) {
+                const Triangle& tri = triangles_[i];
+                float t = 0.0f;
+                if (RayTriangle(ray, tri.v0, tri.edge1, tri.edge2, best, t)) {
+                    best = t;
+                    bestTriangle = i;
+                }
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[entry.ref];
+        float tNear[4];
+        const int mask = TestChildBoxes(node, ray, 0.0f, best, tNear);
+
+        // Push far children first so the nearest is visited next and tightens `best` early.
+        StackEntry hits[4];
+        int hitCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (mask & (1 << i)) {
+                hits[hitCount++] = StackEntry{node.child[i] & ~LEAF_BIT, node.triangleCount[i], tNear[i]};
+            }
+        }
+        std::sort(hits, hits + hitCount, [](const StackEntry& a, const StackEntry& b) { return a.tNear > b.tNear; });
+        for (int i = 0; i < hitCount; ++i) {
+            stack[stackSize++] = hits[i];
+        }
+    }
+
+    if (bestTriangle == NO_TRIANGLE) {
+        return hit;
+    }
+    const Triangle& tri = triangles_[bestTriangle];
+    hit.hit = true;
+    hit.fraction = best;
+    hit.point = from + ray.direction * best;
+    hit.normal = FacingNormal(tri.edge1, tri.edge2, ray.direction);
+    return hit;
+}
+
+void TriangleBvh::castRayPacket(const PhysicsRayQuery* rays, std::size_t count, PhysicsQueryHit* hits) const {
+    count = std::min(count, PACKET_SIZE);
+    for (std::size_t r = 0; r < count; ++r) {
+        hits[r] = PhysicsQueryHit{};
+    }
+    if (nodes_.empty() || count == 0) {
+        return;
+    }
+
+    RayData packet[PACKET_SIZE];
+    float best[PACKET_SIZE];
+    uint32_t bestTriangle[PACKET_SIZE];
+    for (std::size_t r = 0; r < count; ++r) {
+        packet[r] = MakeRay(rays[r].from, rays[r].to);
+        best[r] = 1.0f;
+        bestTriangle[r] = NO_TRIANGLE;
+    }
+
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = StackEntry{0, 0, 0.0f};
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.ref; i < entry.ref + entry.count; ++i) {
+                const Triangle& tri = triangles_[i];
+                for (std::size_t r = 0; r < count; ++r) {
+                    float t = 0.0f;
+                    if (RayTriangle(packet[r], tri.v0, tri.edge1, tri.edge2, best[r], t)) {
+                        best[r] = t;
+                        bestTriangle[r] = i;
+                    }
+                }
+            }
+            continue;
+        }
+
+        // A child is visited if any ray in the packet can still reach it.
+        const Node& node = nodes_[entry.ref];
+        float tNear[4];
+        float packetNear[4] = {best[0], best[0], best[0], best[0]};
+        int mask = 0;
+        for (std::size_t r = 0; r < count; ++r) {
+            const int rayMask = TestChildBoxes(node, packet[r], 0.0f, best[r], tNear);
+            for (int i = 0; i < 4; ++i) {
+                if (rayMask & (1 << i)) {
+                    packetNear[i] = (mask & (1 << i)) ? std::min(packetNear[i], tNear[i]) : tNear[i];
+                }
+            }
+            mask |= rayMask;
+        }
+
+        StackEntry children[4];
+        int childCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (mask & (1 << i)) {
+                children[childCount++] = StackEntry{node.child[i] & ~LEAF_BIT, node.triangleCount[i], packetNear[i]};
+            }
+        }
+        std::sort(children, children + childCount, [](const StackEntry& a, const StackEntry& b) { return a.tNear > b.tNear; });
+        for (int i = 0; i < childCount; ++i) {
+            stack[stackSize++] = children[i];
+        }
+    }
+
+    for (std::size_t r = 0; r < count; ++r) {
+        if (bestTriangle[r] == NO_TRIANGLE) {
+            continue;
+        }
+        const Triangle& tri = triangles_[bestTriangle[r]];
+        hits[r].hit = true;
+        hits[r].fraction = best[r];
+        hits[r].point = packet[r].origin + packet[r].direction * best[r];
+        hits[r].normal = FacingNormal(tri.edge1, tri.edge2, packet[r].direction);
+    }
+}
+
+PhysicsQueryHit TriangleBvh::castSphere(const glm::vec3& from, const glm::vec3& to, float radius) const {
+    PhysicsQueryHit hit;
+    if (nodes_.empty() || radius <= 0.0f) {
+        return hit;
+    }
+
+    const RayData ray = MakeRay(from, to);
+    float best = 1.0f;
+    SweepContact bestContact;
+    bool found = false;
+
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = StackEntry{0, 0, 0.0f};
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.tNear > best) {
+            continue;
+        }
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.ref; i < entry.ref + entry.count; ++i) {
+                const Triangle& tri = triangles_[i];
+                SweepContact contact;
+                if (SweepSphereTriangle(ray, radius, tri.v0, tri.edge1, tri.edge2, best, contact)) {
+                    best = contact.t;
+                    bestContact = contact;
+                    found = true;
+                }
+            }
+            continue;
+        }
+
+        // Boxes grown by the radius contain every point the sphere centre can touch them from.
+        const Node& node = nodes_[entry.ref];
+        float tNear[4];
+        const int mask = TestChildBoxes(node, ray, radius, best, tNear);
+        StackEntry children[4];
+        int childCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (mask & (1 << i)) {
+                children[childCount++] = StackEntry{node.child[i] & ~LEAF_BIT, node.triangleCount[i], tNear[i]};
+            }
+        }
+        std::sort(children, children + childCount, [](const StackEntry& a, const StackEntry& b) { return a.tNear > b.tNear; });
+        for (int i = 0; i < childCount; ++i) {
+            stack[stackSize++] = children[i];
+        }
+    }
+
+    if (!found) {
+        return hit;
+    }
+    hit.hit = true;
+    hit.fraction = bestContact.t;
+    hit.point = bestContact.point;
+    hit.normal = bestContact.normal;
+    return hit;
+}
+
+PhysicsQueryHit TriangleBvh::overlapSphere(const glm::vec3& center, float radius) const {
+    PhysicsQueryHit hit;
+    if (nodes_.empty() || radius <= 0.0f) {
+        return hit;
+    }
+
+    const float radiusSq = radius * radius;
+    uint32_t stack[TRAVERSAL_STACK_SIZE];
+    uint32_t stackCounts[TRAVERSAL_STACK_SIZE];
+    std::size_t stackSize = 0;
+    stack[stackSize] = 0;
+    stackCounts[stackSize++] = 0;
+    while (stackSize > 0) {
+        --stackSize;
+        const uint32_t ref = stack[stackSize];
+        const uint32_t count = stackCounts[stackSize];
+
+        if (count > 0) {
+            for (uint32_t i = ref; i < ref + count; ++i) {
+                const Triangle& tri = triangles_[i];
+                const glm::vec3 closest = ClosestPointOnTriangle(center, tri.v0, tri.v0 + tri.edge1, tri.v0 + tri.edge2);
+                const glm::vec3 away = center - closest;
+                const float distSq = glm::dot(away, away);
+                if (distSq <= radiusSq) {
+                    hit.hit = true;
+                    hit.fraction = 0.0f;
+                    hit.point = closest;
+                    hit.normal = distSq > 1e-12f ? away / std::sqrt(distSq) : glm::normalize(glm::cross(tri.edge1, tri.edge2));
+                    return hit;
+                }
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[ref];
+        for (uint32_t i = 0; i < node.childCount; ++i) {
+            const glm::vec3 boxMin(node.minX[i], node.minY[i], node.minZ[i]);
+            const glm::vec3 boxMax(node.maxX[i], node.maxY[i], node.maxZ[i]);
+            const glm::vec3 delta = center - glm::clamp(center, boxMin, boxMax);
+            if (glm::dot(delta, delta) <= radiusSq) {
+                stack[stackSize] = node.child[i] & ~LEAF_BIT;
+                stackCounts[stackSize++] = node.triangleCount[i];
+            }
+        }
+    }
+    return hit;
+}
+
+} // namespace physics_backend
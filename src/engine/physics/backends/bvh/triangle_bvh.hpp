@@ -0,0 +1,65 @@
+#pragma once
+
+#include "physics/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace physics_backend {
+
+// Static, query-only triangle BVH. Built once with a binned SAH split and
+// collapsed to a 4-wide tree so each node visit tests four child boxes with
+// one SIMD slab test. All query functions are const and thread-safe.
+class TriangleBvh {
+public:
+    static constexpr std::size_t PACKET_SIZE = 4;
+
+    void build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices);
+
+    bool empty() const { return nodes_.empty(); }
+    std::size_t triangleCount() const { return triangles_.size(); }
+    std::size_t nodeCount() const { return nodes_.size(); }
+    std::size_t memoryBytes() const;
+    glm::vec3 boundsMin() const { return boundsMin_; }
+    glm::vec3 boundsMax() const { return boundsMax_; }
+
+    // Closest hit along from→to; fraction is in [0, 1] of that segment.
+    PhysicsQueryHit castRay(const glm::vec3& from, const glm::vec3& to) const;
+
+    // Traces up to PACKET_SIZE rays together, sharing node fetches. Pays off
+    // for coherent rays (same area, similar direction) such as grid bakes.
+    void castRayPacket(const PhysicsRayQuery* rays, std::size_t count, PhysicsQueryHit* hits) const;
+
+    PhysicsQueryHit castSphere(const glm::vec3& from, const glm::vec3& to, float radius) const;
+    PhysicsQueryHit overlapSphere(const glm::vec3& center, float radius) const;
+
+private:
+    struct alignas(16) Node {
+        float minX[4];
+        float minY[4];
+        float minZ[4];
+        float maxX[4];
+        float maxY[4];
+        float maxZ[4];
+        // Inner child: node index. Leaf child: first triangle | LEAF_BIT.
+        uint32_t child[4];
+        uint32_t triangleCount[4];
+        uint32_t childCount;
+    };
+
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 edge1;
+        glm::vec3 edge2;
+    };
+
+    static constexpr uint32_t LEAF_BIT = 0x80000000u;
+
+    std::vector<Node> nodes_;
+    std::vector<Triangle> triangles_;
+    glm::vec3 boundsMin_{0.0f};
+    glm::vec3 boundsMax_{0.0f};
+};
+
+} // namespace physics_backend
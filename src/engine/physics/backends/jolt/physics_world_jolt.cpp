@@ -2,33 +2,57 @@
 #include "physics/backends/jolt/player_controller_jolt.hpp"
 #include "physics/backends/jolt/rigid_body_jolt.hpp"
 #include "physics/backends/jolt/static_body_jolt.hpp"
+#include "common/config_helpers.hpp"
+#include "common/worker_pool.hpp"
+#include <Jolt/Core/Color.h>
 #include <Jolt/Core/Factory.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyFilter.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyInterface.h>
 #include <Jolt/Physics/Body/BodyLock.h>
 #include <Jolt/Physics/Body/BodyLockInterface.h>
 #include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/ObjectLayer.h>
 #include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/RegisterTypes.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <mutex>
 #include <spdlog/spdlog.h>
 #include <thread>
 
 namespace {
 using namespace JPH;
 
-constexpr uint32 MAX_BODIES = 4096;
+// Defaults for the physics.* config keys.
+constexpr uint32 DEFAULT_MAX_BODIES = 4096;
 constexpr uint32 NUM_BODY_MUTEXES = 0;
-constexpr uint32 MAX_BODY_PAIRS = 65536;
-constexpr uint32 MAX_CONTACT_CONSTRAINTS = 8192;
+constexpr uint32 DEFAULT_MAX_BODY_PAIRS = 65536;
+constexpr uint32 DEFAULT_MAX_CONTACT_CONSTRAINTS = 8192;
+constexpr float DEFAULT_TEMP_ALLOCATOR_MB = 32.0f;
+
+// Below this many controllers per job the dispatch overhead outweighs the work.
+constexpr size_t MIN_PLAYERS_PER_JOB = 8;
+constexpr uint32 PLAYER_TEMP_ALLOCATOR_SIZE = 1024u * 1024u;
+
+// Each world keeps at most two barriers and one update's worth of jobs in
+// flight, so the shared pool is sized for this many concurrently ticking worlds.
+constexpr uint32 MAX_SHARED_WORLDS = 16;
 
 using ObjectLayer = JPH::ObjectLayer;
 constexpr ObjectLayer NonMoving = 0;
@@ -76,6 +100,60 @@ public:
     }
 };
 
+class QueryBroadPhaseFilter final : public BroadPhaseLayerFilter {
+public:
+    explicit QueryBroadPhaseFilter(PhysicsQueryBodies bodies) : bodies_(bodies) {}
+
+    bool ShouldCollide(BroadPhaseLayer layer) const override {
+        switch (bodies_) {
+            case PhysicsQueryBodies::StaticOnly: return layer == BP_NON_MOVING;
+            case PhysicsQueryBodies::DynamicOnly: return layer == BP_MOVING;
+            default: return true;
+        }
+    }
+
+private:
+    PhysicsQueryBodies bodies_;
+};
+
+class QueryObjectLayerFilter final : public ObjectLayerFilter {
+public:
+    explicit QueryObjectLayerFilter(PhysicsQueryBodies bodies) : bodies_(bodies) {}
+
+    bool ShouldCollide(ObjectLayer layer) const override {
+        switch (bodies_) {
+            case PhysicsQueryBodies::StaticOnly: return layer == NonMoving;
+            case PhysicsQueryBodies::DynamicOnly: return layer == Moving;
+            default: return true;
+        }
+    }
+
+private:
+    PhysicsQueryBodies bodies_;
+};
+
+class QueryBodyFilter final : public BodyFilter {
+public:
+    explicit QueryBodyFilter(std::uintptr_t ignoreBody) : ignoreBody_(ignoreBody) {}
+
+    bool ShouldCollide(const BodyID& id) const override {
+        return ignoreBody_ == PHYSICS_NO_BODY || id.GetIndexAndSequenceNumber() != ignoreBody_;
+    }
+
+private:
+    std::uintptr_t ignoreBody_;
+};
+
+// Bundles the three Jolt filter layers for one PhysicsQueryFilter.
+struct QueryFilters {
+    explicit QueryFilters(const PhysicsQueryFilter& filter)
+        : broadPhase(filter.bodies), objectLayer(filter.bodies), body(filter.ignoreBody) {}
+
+    QueryBroadPhaseFilter broadPhase;
+    QueryObjectLayerFilter objectLayer;
+    QueryBodyFilter body;
+};
+
 inline Vec3 toJph(const glm::vec3& v) { return Vec3(v.x, v.y, v.z); }
 inline glm::vec3 toGlm(const Vec3& v) { return glm::vec3(v.GetX(), v.GetY(), v.GetZ()); }
 
@@ -89,19 +167,133 @@ void JoltTrace(const char* fmt, ...) {
 }
 
 void initJoltOnce() {
-    static bool initialized = false;
-    if (initialized) return;
-
-    JPH::RegisterDefaultAllocator();
-    JPH::Trace = &JoltTrace;
-    JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = [](const char* expr, const char* msg, const char* file, uint line) {
-        spdlog::error("Jolt assert failed: {} {} ({}:{})", expr, msg ? msg : "", file, line);
-        return true;
+    static std::once_flag once;
+    std::call_once(once, []() {
+        JPH::RegisterDefaultAllocator();
+        JPH::Trace = &JoltTrace;
+        JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = [](const char* expr, const char* msg, const char* file, uint line) {
+            spdlog::error("Jolt assert failed: {} {} ({}:{})", expr, msg ? msg : "", file, line);
+            return true;
+        });
+
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
     });
+}
+
+// Runs Jolt jobs on a karma::jobs::WorkerPool instead of Jolt's own threads, so
+// physics shares cores with the engine's other parallel stages. Job
+// bookkeeping mirrors JobSystemThreadPool.
+class WorkerPoolJobSystem final : public JobSystemWithBarrier {
+public:
+    WorkerPoolJobSystem(karma::jobs::WorkerPool& pool, uint maxJobs, uint maxBarriers)
+        : JobSystemWithBarrier(maxBarriers), pool_(pool) {
+        jobs_.Init(maxJobs, maxJobs);
+    }
+
+    ~WorkerPoolJobSystem() override {
+        // A pool task may still be releasing its job after the barrier saw it finish.
+        while (inFlight_.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    int GetMaxConcurrency() const override {
+        return static_cast<int>(pool_.workerCount()) + 1;
+    }
+
+    JobHandle CreateJob(const char* name, ColorArg color, const JobFunction& function, uint32 numDependencies = 0) override {
+        uint32 index;
+        for (;;) {
+            index = jobs_.ConstructObject(name, color, this, function, numDependencies);
+            if (index != AvailableJobs::cInvalidObjectIndex) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        Job* job = &jobs_.Get(index);
+        JobHandle handle(job);
+        if (numDependencies == 0) {
+            QueueJob(job);
+        }
+        return handle;
+    }
+
+protected:
+    void QueueJob(Job* job) override {
+        job->AddRef();
+        inFlight_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, job]() {
+            job->Execute();
+            job->Release();
+            inFlight_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void QueueJobs(Job** jobs, uint numJobs) override {
+        for (uint i = 0; i < numJobs; ++i) {
+            QueueJob(jobs[i]);
+        }
+    }
+
+    void FreeJob(Job* job) override {
+        jobs_.DestructObject(job);
+    }
 
-    JPH::Factory::sInstance = new JPH::Factory();
-    JPH::RegisterTypes();
-    initialized = true;
+private:
+    using AvailableJobs = FixedSizeFreeList<Job>;
+    AvailableJobs jobs_;
+    karma::jobs::WorkerPool& pool_;
+    std::atomic<uint32> inFlight_{0};
+};
+
+// physics.WorkerThreads < 0 means one per core minus the stepping thread,
+// which also runs jobs while it waits.
+int configuredWorkerThreads() {
+    const int configured = static_cast<int>(karma::config::ReadFloatConfig({"physics.WorkerThreads"}, -1.0f));
+    if (configured >= 0) {
+        return configured;
+    }
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+}
+
+// Sized for `worlds` worlds ticking at once on the returned job system.
+std::shared_ptr<JobSystem> createJobSystem(uint32 worlds) {
+    const std::string pool = karma::config::ReadStringConfig("physics.JobPool", "dedicated");
+    if (pool == "shared") {
+        spdlog::info("PhysicsWorldJolt: Running jobs on the shared worker pool ({} workers)",
+                     karma::jobs::SharedWorkerPool().workerCount());
+        return std::make_shared<WorkerPoolJobSystem>(karma::jobs::SharedWorkerPool(),
+                                                     JPH::cMaxPhysicsJobs * worlds,
+                                                     JPH::cMaxPhysicsBarriers * worlds);
+    }
+    if (pool != "dedicated") {
+        spdlog::warn("PhysicsWorldJolt: Unknown physics.JobPool '{}'; using a dedicated pool", pool);
+    }
+    const int threads = configuredWorkerThreads();
+    spdlog::info("PhysicsWorldJolt: Running jobs on {} dedicated worker threads", threads);
+    return std::make_shared<JobSystemThreadPool>(JPH::cMaxPhysicsJobs * worlds,
+                                                 JPH::cMaxPhysicsBarriers * worlds,
+                                                 threads);
+}
+
+// A single world owns its job system. When several worlds tick concurrently
+// they share one, so they don't each spin up a thread per core.
+std::shared_ptr<JobSystem> acquireJobSystem() {
+    if (!physics_backend::ConcurrentWorlds()) {
+        return createJobSystem(1);
+    }
+
+    static std::mutex mutex;
+    static std::weak_ptr<JobSystem> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto existing = shared.lock()) {
+        return existing;
+    }
+    auto created = createJobSystem(MAX_SHARED_WORLDS);
+    shared = created;
+    return created;
 }
 } // namespace
 
@@ -110,18 +302,23 @@ namespace physics_backend {
 PhysicsWorldJolt::PhysicsWorldJolt() {
     initJoltOnce();
 
-    tempAllocator_ = std::make_unique<TempAllocatorImpl>(32u * 1024u * 1024u);
-    jobSystem_ = std::make_unique<JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency());
+    const float tempAllocatorMb = karma::config::ReadFloatConfig({"physics.TempAllocatorMB"}, DEFAULT_TEMP_ALLOCATOR_MB);
+    const uint32 maxBodies = static_cast<uint32>(karma::config::ReadFloatConfig({"physics.MaxBodies"}, static_cast<float>(DEFAULT_MAX_BODIES)));
+    const uint32 maxBodyPairs = static_cast<uint32>(karma::config::ReadFloatConfig({"physics.MaxBodyPairs"}, static_cast<float>(DEFAULT_MAX_BODY_PAIRS)));
+    const uint32 maxContactConstraints = static_cast<uint32>(karma::config::ReadFloatConfig({"physics.MaxContactConstraints"}, static_cast<float>(DEFAULT_MAX_CONTACT_CONSTRAINTS)));
+
+    tempAllocator_ = std::make_unique<TempAllocatorImpl>(static_cast<uint>(std::max(1.0f, tempAllocatorMb) * 1024.0f * 1024.0f));
+    jobSystem_ = acquireJobSystem();
 
     static BPLayerInterfaceImpl broadPhaseLayers;
     static ObjectVsBroadPhaseLayerFilterImpl objectVsBroadphaseFilter;
     static ObjectLayerPairFilterImpl objectPairFilter;
 
     physicsSystem_ = std::make_unique<PhysicsSystem>();
-    physicsSystem_->Init(MAX_BODIES,
+    physicsSystem_->Init(std::max<uint32>(1, maxBodies),
                          NUM_BODY_MUTEXES,
-                         MAX_BODY_PAIRS,
-                         MAX_CONTACT_CONSTRAINTS,
+                         std::max<uint32>(1, maxBodyPairs),
+                         std::max<uint32>(1, maxContactConstraints),
                          broadPhaseLayers,
                          objectVsBroadphaseFilter,
                          objectPairFilter);
@@ -130,6 +327,7 @@ PhysicsWorldJolt::PhysicsWorldJolt() {
 }
 
 PhysicsWorldJolt::~PhysicsWorldJolt() {
+    playerTempAllocators_.clear();
     physicsSystem_.reset();
     jobSystem_.reset();
     tempAllocator_.reset();
@@ -189,31 +387,134 @@ std::unique_ptr<PhysicsPlayerControllerBackend> PhysicsWorldJolt::createPlayer(c
     return controller;
 }
 
+void PhysicsWorldJolt::updatePlayers(const std::vector<PlayerStep>& steps) {
+    if (!physicsSystem_ || steps.empty()) return;
+
+    // Characters only read the physics system and do not collide with each
+    // other, so disjoint slices can be stepped on separate workers.
+    const size_t maxJobs = static_cast<size_t>(std::max(1, jobSystem_->GetMaxConcurrency()));
+    const size_t jobCount = std::min(maxJobs, (steps.size() + MIN_PLAYERS_PER_JOB - 1) / MIN_PLAYERS_PER_JOB);
+
+    if (jobCount <= 1) {
+        for (const auto& step : steps) {
+            static_cast<PhysicsPlayerControllerJolt*>(step.player)->update(step.deltaTime, *tempAllocator_);
+        }
+        return;
+    }
+
+    while (playerTempAllocators_.size() < jobCount) {
+        playerTempAllocators_.push_back(std::make_unique<TempAllocatorImpl>(PLAYER_TEMP_ALLOCATOR_SIZE));
+    }
+
+    const size_t perJob = (steps.size() + jobCount - 1) / jobCount;
+    Barrier* barrier = jobSystem_->CreateBarrier();
+    for (size_t job = 0; job < jobCount; ++job) {
+        const size_t begin = job * perJob;
+        const size_t end = std::min(steps.size(), begin + perJob);
+        if (begin >= end) break;
+
+        TempAllocator* allocator = playerTempAllocators_[job].get();
+        JobHandle handle = jobSystem_->CreateJob("UpdatePlayers", Color::sGreen, [&steps, allocator, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                static_cast<PhysicsPlayerControllerJolt*>(steps[i].player)->update(steps[i].deltaTime, *allocator);
+            }
+        });
+        barrier->AddJob(handle);
+    }
+    jobSystem_->WaitForJobs(barrier);
+    jobSystem_->DestroyBarrier(barrier);
+}
+
 std::unique_ptr<PhysicsStaticBodyBackend> PhysicsWorldJolt::createStaticMesh(const std::string& meshPath) {
     return PhysicsStaticBodyJolt::fromMesh(this, meshPath);
 }
 
-bool PhysicsWorldJolt::raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3& hitPoint, glm::vec3& hitNormal) const {
-    if (!physicsSystem_) return false;
+PhysicsQueryHit PhysicsWorldJolt::castRay(const PhysicsRayQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!physicsSystem_) return hit;
 
-    RVec3 origin(from.x, from.y, from.z);
-    Vec3 direction(to.x - from.x, to.y - from.y, to.z - from.z);
-    RRayCast ray(origin, direction);
+    const RRayCast ray(toJph(query.from), toJph(query.to - query.from));
     RayCastResult result;
-    if (!physicsSystem_->GetNarrowPhaseQuery().CastRay(ray, result)) {
-        return false;
+    const QueryFilters filters(query.filter);
+    if (!physicsSystem_->GetNarrowPhaseQuery().CastRay(ray, result, filters.broadPhase, filters.objectLayer, filters.body)) {
+        return hit;
     }
 
-    glm::vec3 rayVec = glm::vec3(direction.GetX(), direction.GetY(), direction.GetZ());
-    hitPoint = glm::vec3(from) + rayVec * result.mFraction;
+    hit.hit = true;
+    hit.fraction = result.mFraction;
+    hit.point = toGlm(ray.GetPointOnRay(result.mFraction));
+    hit.body = result.mBodyID.GetIndexAndSequenceNumber();
 
-    BodyLockRead lock(physicsSystem_->GetBodyLockInterface(), result.mBodyID);
+    // Queries only run while the world isn't stepping or changing, so the
+    // no-lock interface is safe and keeps parallel batches from contending.
+    BodyLockRead lock(physicsSystem_->GetBodyLockInterfaceNoLock(), result.mBodyID);
     if (lock.Succeeded()) {
-        hitNormal = toGlm(lock.GetBody().GetWorldSpaceSurfaceNormal(result.mSubShapeID2, ray.GetPointOnRay(result.mFraction)));
-    } else {
-        hitNormal = glm::vec3(0.0f);
+        hit.normal = toGlm(lock.GetBody().GetWorldSpaceSurfaceNormal(result.mSubShapeID2, ray.GetPointOnRay(result.mFraction)));
+        if (glm::dot(hit.normal, query.to - query.from) > 0.0f) {
+            hit.normal = -hit.normal;
+        }
     }
-    return true;
+    return hit;
+}
+
+PhysicsQueryHit PhysicsWorldJolt::castSphere(const PhysicsSphereSweepQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!physicsSystem_ || query.radius <= 0.0f) return hit;
+
+    SphereShape sphere(query.radius);
+    sphere.SetEmbedded();
+    const RShapeCast cast = RShapeCast::sFromWorldTransform(&sphere,
+                                                            Vec3::sReplicate(1.0f),
+                                                            RMat44::sTranslation(toJph(query.from)),
+                                                            toJph(query.to - query.from));
+    ShapeCastSettings settings;
+    settings.mReturnDeepestPoint = true;
+    ClosestHitCollisionCollector<CastShapeCollector> collector;
+    const QueryFilters filters(query.filter);
+    physicsSystem_->GetNarrowPhaseQuery().CastShape(cast, settings, RVec3::sZero(), collector,
+                                                    filters.broadPhase, filters.objectLayer, filters.body);
+    if (!collector.HadHit()) {
+        return hit;
+    }
+
+    const ShapeCastResult& result = collector.mHit;
+    hit.hit = true;
+    hit.fraction = result.mFraction;
+    hit.point = toGlm(result.mContactPointOn2);
+    hit.normal = toGlm(-result.mPenetrationAxis.NormalizedOr(Vec3::sZero()));
+    hit.body = result.mBodyID2.GetIndexAndSequenceNumber();
+    return hit;
+}
+
+PhysicsQueryHit PhysicsWorldJolt::overlapSphere(const PhysicsSphereOverlapQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!physicsSystem_ || query.radius <= 0.0f) return hit;
+
+    SphereShape sphere(query.radius);
+    sphere.SetEmbedded();
+    CollideShapeSettings settings;
+    AnyHitCollisionCollector<CollideShapeCollector> collector;
+    const QueryFilters filters(query.filter);
+    physicsSystem_->GetNarrowPhaseQuery().CollideShape(&sphere,
+                                                       Vec3::sReplicate(1.0f),
+                                                       RMat44::sTranslation(toJph(query.center)),
+                                                       settings,
+                                                       RVec3::sZero(),
+                                                       collector,
+                                                       filters.broadPhase,
+                                                       filters.objectLayer,
+                                                       filters.body);
+    if (!collector.HadHit()) {
+        return hit;
+    }
+
+    const CollideShapeResult& result = collector.mHit;
+    hit.hit = true;
+    hit.fraction = 0.0f;
+    hit.point = toGlm(result.mContactPointOn2);
+    hit.normal = toGlm(-result.mPenetrationAxis.NormalizedOr(Vec3::sZero()));
+    hit.body = result.mBodyID2.GetIndexAndSequenceNumber();
+    return hit;
 }
 
 void PhysicsWorldJolt::removeBody(const JPH::BodyID& id) const {
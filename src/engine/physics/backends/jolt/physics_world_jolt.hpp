@@ -4,6 +4,7 @@
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Body/BodyID.h>
 #include <memory>
+#include <vector>
 
 namespace JPH {
 class PhysicsSystem;
@@ -25,8 +26,11 @@ public:
                                                            const glm::vec3& position,
                                                            const PhysicsMaterial& material) override;
     std::unique_ptr<PhysicsPlayerControllerBackend> createPlayer(const glm::vec3& size) override;
+    void updatePlayers(const std::vector<PlayerStep>& steps) override;
     std::unique_ptr<PhysicsStaticBodyBackend> createStaticMesh(const std::string& meshPath) override;
-    bool raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3& hitPoint, glm::vec3& hitNormal) const override;
+    PhysicsQueryHit castRay(const PhysicsRayQuery& query) const override;
+    PhysicsQueryHit castSphere(const PhysicsSphereSweepQuery& query) const override;
+    PhysicsQueryHit overlapSphere(const PhysicsSphereOverlapQuery& query) const override;
 
     JPH::PhysicsSystem* physicsSystem() { return physicsSystem_.get(); }
     const JPH::PhysicsSystem* physicsSystem() const { return physicsSystem_.get(); }
@@ -35,8 +39,12 @@ public:
 
 private:
     std::unique_ptr<JPH::TempAllocator> tempAllocator_;
-    std::unique_ptr<JPH::JobSystem> jobSystem_;
+    // Shared between worlds only when several tick concurrently
+    // (see physics_backend::SetConcurrentWorlds).
+    std::shared_ptr<JPH::JobSystem> jobSystem_;
     std::unique_ptr<JPH::PhysicsSystem> physicsSystem_;
+    // One per concurrent player-update job; TempAllocatorImpl is not thread-safe.
+    std::vector<std::unique_ptr<JPH::TempAllocator>> playerTempAllocators_;
 };
 
 } // namespace physics_backend
@@ -105,6 +105,12 @@ bool PhysicsPlayerControllerJolt::isGrounded() const {
 }
 
 void PhysicsPlayerControllerJolt::update(float dt) {
+    JPH::TempAllocator* allocator = world_ ? world_->tempAllocator() : nullptr;
+    if (!allocator) return;
+    update(dt, *allocator);
+}
+
+void PhysicsPlayerControllerJolt::update(float dt, JPH::TempAllocator& allocator) {
     if (!world_ || !character_ || dt <= 0.f) return;
 
     Vec3 gravityVec = world_->physicsSystem() ? world_->physicsSystem()->GetGravity() : Vec3(0, gravity, 0);
@@ -127,8 +133,6 @@ void PhysicsPlayerControllerJolt::update(float dt) {
     ObjectLayerFilter objFilter;
     BodyFilter bodyFilter;
     ShapeFilter shapeFilter;
-    JPH::TempAllocator* allocator = world_->tempAllocator();
-    if (!allocator) return;
     character_->ExtendedUpdate(dt,
                                gravityVec,
                                updateSettings,
@@ -136,7 +140,7 @@ void PhysicsPlayerControllerJolt::update(float dt) {
                                objFilter,
                                bodyFilter,
                                shapeFilter,
-                               *allocator);
+                               allocator);
 
     velocity = toGlm(character_->GetLinearVelocity());
 
@@ -22,6 +22,9 @@ public:
     glm::vec3 getForwardVector() const override;
     void setHalfExtents(const glm::vec3& extents) override;
     void update(float dt) override;
+    // Safe to call concurrently for different controllers as long as each
+    // caller supplies its own allocator.
+    void update(float dt, JPH::TempAllocator& allocator);
     void setPosition(const glm::vec3& position) override;
     void setRotation(const glm::quat& rotation) override;
     void setVelocity(const glm::vec3& velocity) override;
@@ -8,6 +8,9 @@
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <spdlog/spdlog.h>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 using namespace JPH;
@@ -15,17 +18,22 @@ using namespace JPH;
 namespace {
 template <class TVec>
 inline glm::vec3 toGlm(const TVec& v) { return glm::vec3(static_cast<float>(v.GetX()), static_cast<float>(v.GetY()), static_cast<float>(v.GetZ())); }
-}
-
-namespace physics_backend {
-
-std::unique_ptr<PhysicsStaticBodyBackend> PhysicsStaticBodyJolt::fromMesh(PhysicsWorldJolt* world, const std::string& meshPath) {
-    if (!world || !world->physicsSystem()) return std::make_unique<PhysicsStaticBodyJolt>();
 
+// Mesh shapes are immutable once built, so worlds loading the same file
+// (e.g. several arenas on one map) share a single copy. Entries are keyed on
+// the file's write time as well so a re-downloaded world is rebuilt.
+struct CachedMeshShape {
+    std::filesystem::file_time_type writeTime;
+    JPH::RefConst<JPH::Shape> shape;
+};
+std::mutex g_meshShapeMutex;
+std::unordered_map<std::string, CachedMeshShape> g_meshShapes;
+
+JPH::RefConst<JPH::Shape> buildMeshShape(const std::string& meshPath) {
     std::vector<MeshLoader::MeshData> meshes = MeshLoader::loadGLB(meshPath);
     if (meshes.empty()) {
         spdlog::warn("PhysicsStaticBodyJolt::fromMesh: No meshes found at {}", meshPath);
-        return std::make_unique<PhysicsStaticBodyJolt>();
+        return nullptr;
     }
 
     using JPH::VertexList;
@@ -57,10 +65,39 @@ std::unique_ptr<PhysicsStaticBodyBackend> PhysicsStaticBodyJolt::fromMesh(Physic
     auto shapeResult = meshSettings.Create();
     if (shapeResult.HasError()) {
         spdlog::error("PhysicsStaticBodyJolt::fromMesh: Failed to create mesh shape: {}", shapeResult.GetError().c_str());
+        return nullptr;
+    }
+    return shapeResult.Get();
+}
+
+JPH::RefConst<JPH::Shape> cachedMeshShape(const std::string& meshPath) {
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(meshPath, ec);
+
+    std::lock_guard<std::mutex> lock(g_meshShapeMutex);
+    auto it = g_meshShapes.find(meshPath);
+    if (!ec && it != g_meshShapes.end() && it->second.writeTime == writeTime) {
+        return it->second.shape;
+    }
+
+    JPH::RefConst<JPH::Shape> shape = buildMeshShape(meshPath);
+    if (shape != nullptr && !ec) {
+        g_meshShapes[meshPath] = CachedMeshShape{writeTime, shape};
+    }
+    return shape;
+}
+}
+
+namespace physics_backend {
+
+std::unique_ptr<PhysicsStaticBodyBackend> PhysicsStaticBodyJolt::fromMesh(PhysicsWorldJolt* world, const std::string& meshPath) {
+    if (!world || !world->physicsSystem()) return std::make_unique<PhysicsStaticBodyJolt>();
+
+    JPH::RefConst<JPH::Shape> shape = cachedMeshShape(meshPath);
+    if (shape == nullptr) {
         return std::make_unique<PhysicsStaticBodyJolt>();
     }
 
-    JPH::RefConst<JPH::Shape> shape = shapeResult.Get();
     JPH::BodyCreationSettings settings(shape,
                                       JPH::RVec3::sZero(),
                                       JPH::Quat::sIdentity(),
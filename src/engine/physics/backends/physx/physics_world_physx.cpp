@@ -2,17 +2,22 @@
 #include "physics/backends/physx/player_controller_physx.hpp"
 #include "physics/backends/physx/rigid_body_physx.hpp"
 #include "physics/backends/physx/static_body_physx.hpp"
+#include "common/config_helpers.hpp"
+#include "common/worker_pool.hpp"
 #include <PxPhysicsAPI.h>
 #include <spdlog/spdlog.h>
 
 namespace {
 physx::PxVec3 toPx(const glm::vec3& v) { return physx::PxVec3(v.x, v.y, v.z); }
+glm::vec3 toGlm(const physx::PxVec3& v) { return glm::vec3(v.x, v.y, v.z); }
 
 class IgnorePlayerQueryFilter final : public physx::PxQueryFilterCallback {
 public:
+    explicit IgnorePlayerQueryFilter(std::uintptr_t ignoreActor = PHYSICS_NO_BODY) : ignoreActor_(ignoreActor) {}
+
     physx::PxQueryHitType::Enum preFilter(const physx::PxFilterData&,
                                           const physx::PxShape* shape,
-                                          const physx::PxRigidActor*,
+                                          const physx::PxRigidActor* actor,
                                           physx::PxHitFlags&) override {
         if (!shape) {
             return physx::PxQueryHitType::eNONE;
@@ -21,6 +26,9 @@ public:
         if ((data.word0 & physics_backend::kPhysXQueryIgnorePlayer) != 0) {
             return physx::PxQueryHitType::eNONE;
         }
+        if (ignoreActor_ != PHYSICS_NO_BODY && reinterpret_cast<std::uintptr_t>(actor) == ignoreActor_) {
+            return physx::PxQueryHitType::eNONE;
+        }
         return physx::PxQueryHitType::eBLOCK;
     }
 
@@ -30,7 +38,46 @@ public:
                                            const physx::PxRigidActor*) override {
         return physx::PxQueryHitType::eBLOCK;
     }
+
+private:
+    std::uintptr_t ignoreActor_;
 };
+
+// Hands PhysX simulation tasks to the engine's shared worker pool instead of
+// a dedicated dispatcher thread set.
+class WorkerPoolCpuDispatcher final : public physx::PxCpuDispatcher {
+public:
+    explicit WorkerPoolCpuDispatcher(karma::jobs::WorkerPool& pool) : pool_(pool) {}
+
+    void submitTask(physx::PxBaseTask& task) override {
+        pool_.submit([&task]() {
+            task.run();
+            task.release();
+        });
+    }
+
+    physx::PxU32 getWorkerCount() const override {
+        return static_cast<physx::PxU32>(pool_.workerCount());
+    }
+
+private:
+    karma::jobs::WorkerPool& pool_;
+};
+
+// Matches the thread count this backend always used before it was configurable.
+constexpr int DEFAULT_DISPATCHER_THREADS = 2;
+
+physx::PxQueryFilterData toFilterData(const PhysicsQueryFilter& filter) {
+    physx::PxQueryFilterData filterData;
+    filterData.flags = physx::PxQueryFlag::ePREFILTER;
+    if (filter.bodies != PhysicsQueryBodies::DynamicOnly) {
+        filterData.flags |= physx::PxQueryFlag::eSTATIC;
+    }
+    if (filter.bodies != PhysicsQueryBodies::StaticOnly) {
+        filterData.flags |= physx::PxQueryFlag::eDYNAMIC;
+    }
+    return filterData;
+}
 }
 
 namespace physics_backend {
@@ -50,8 +97,19 @@ PhysicsWorldPhysX::PhysicsWorldPhysX() {
 
     physx::PxSceneDesc sceneDesc(physics_->getTolerancesScale());
     sceneDesc.gravity = physx::PxVec3(0.0f, -9.8f, 0.0f);
-    dispatcher_ = physx::PxDefaultCpuDispatcherCreate(2);
-    sceneDesc.cpuDispatcher = dispatcher_;
+    const std::string jobPool = karma::config::ReadStringConfig("physics.JobPool", "dedicated");
+    if (jobPool == "shared") {
+        poolDispatcher_ = std::make_unique<WorkerPoolCpuDispatcher>(karma::jobs::SharedWorkerPool());
+        sceneDesc.cpuDispatcher = poolDispatcher_.get();
+    } else {
+        if (jobPool != "dedicated") {
+            spdlog::warn("PhysX: unknown physics.JobPool '{}'; using a dedicated dispatcher", jobPool);
+        }
+        const int configured = static_cast<int>(karma::config::ReadFloatConfig({"physics.WorkerThreads"}, -1.0f));
+        const int threads = configured >= 0 ? configured : DEFAULT_DISPATCHER_THREADS;
+        dispatcher_ = physx::PxDefaultCpuDispatcherCreate(static_cast<physx::PxU32>(threads));
+        sceneDesc.cpuDispatcher = dispatcher_;
+    }
     sceneDesc.filterShader = physx::PxDefaultSimulationFilterShader;
     scene_ = physics_->createScene(sceneDesc);
 
@@ -76,6 +134,7 @@ PhysicsWorldPhysX::~PhysicsWorldPhysX() {
         dispatcher_->release();
         dispatcher_ = nullptr;
     }
+    poolDispatcher_.reset();
     if (physics_) {
         physics_->release();
         physics_ = nullptr;
@@ -149,27 +208,74 @@ std::unique_ptr<PhysicsStaticBodyBackend> PhysicsWorldPhysX::createStaticMesh(co
     return PhysicsStaticBodyPhysX::fromMesh(this, meshPath);
 }
 
-bool PhysicsWorldPhysX::raycast(const glm::vec3& from,
-                                const glm::vec3& to,
-                                glm::vec3& hitPoint,
-                                glm::vec3& hitNormal) const {
-    if (!scene_) return false;
+PhysicsQueryHit PhysicsWorldPhysX::castRay(const PhysicsRayQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!scene_) return hit;
 
-    const physx::PxVec3 origin = toPx(from);
-    const physx::PxVec3 direction = toPx(to - from);
+    const physx::PxVec3 direction = toPx(query.to - query.from);
     const float distance = direction.magnitude();
-    if (distance <= 1e-6f) return false;
+    if (distance <= 1e-6f) return hit;
 
-    physx::PxRaycastBuffer hit;
-    physx::PxQueryFilterData filterData;
-    filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
-    IgnorePlayerQueryFilter filterCallback;
-    if (!scene_->raycast(origin, direction.getNormalized(), distance, hit, physx::PxHitFlag::eDEFAULT, filterData, &filterCallback)) {
-        return false;
-    }
-    hitPoint = glm::vec3(hit.block.position.x, hit.block.position.y, hit.block.position.z);
-    hitNormal = glm::vec3(hit.block.normal.x, hit.block.normal.y, hit.block.normal.z);
-    return true;
+    physx::PxRaycastBuffer buffer;
+    IgnorePlayerQueryFilter filterCallback(query.filter.ignoreBody);
+    if (!scene_->raycast(toPx(query.from), direction.getNormalized(), distance, buffer,
+                         physx::PxHitFlag::eDEFAULT, toFilterData(query.filter), &filterCallback)) {
+        return hit;
+    }
+
+    hit.hit = true;
+    hit.point = toGlm(buffer.block.position);
+    hit.normal = toGlm(buffer.block.normal);
+    hit.fraction = buffer.block.distance / distance;
+    hit.body = reinterpret_cast<std::uintptr_t>(buffer.block.actor);
+    return hit;
+}
+
+PhysicsQueryHit PhysicsWorldPhysX::castSphere(const PhysicsSphereSweepQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!scene_ || query.radius <= 0.0f) return hit;
+
+    const physx::PxVec3 direction = toPx(query.to - query.from);
+    const float distance = direction.magnitude();
+    if (distance <= 1e-6f) {
+        return overlapSphere({query.from, query.radius, query.filter});
+    }
+
+    physx::PxSweepBuffer buffer;
+    IgnorePlayerQueryFilter filterCallback(query.filter.ignoreBody);
+    if (!scene_->sweep(physx::PxSphereGeometry(query.radius), physx::PxTransform(toPx(query.from)),
+                       direction.getNormalized(), distance, buffer,
+                       physx::PxHitFlag::eDEFAULT, toFilterData(query.filter), &filterCallback)) {
+        return hit;
+    }
+
+    hit.hit = true;
+    hit.point = toGlm(buffer.block.position);
+    hit.normal = toGlm(buffer.block.normal);
+    hit.fraction = buffer.block.distance / distance;
+    hit.body = reinterpret_cast<std::uintptr_t>(buffer.block.actor);
+    return hit;
+}
+
+PhysicsQueryHit PhysicsWorldPhysX::overlapSphere(const PhysicsSphereOverlapQuery& query) const {
+    PhysicsQueryHit hit;
+    if (!scene_ || query.radius <= 0.0f) return hit;
+
+    physx::PxOverlapBuffer buffer;
+    physx::PxQueryFilterData filterData = toFilterData(query.filter);
+    filterData.flags |= physx::PxQueryFlag::eANY_HIT;
+    IgnorePlayerQueryFilter filterCallback(query.filter.ignoreBody);
+    if (!scene_->overlap(physx::PxSphereGeometry(query.radius), physx::PxTransform(toPx(query.center)),
+                         buffer, filterData, &filterCallback)) {
+        return hit;
+    }
+
+    // Overlaps carry no contact data; report the query centre.
+    hit.hit = true;
+    hit.point = query.center;
+    hit.fraction = 0.0f;
+    hit.body = reinterpret_cast<std::uintptr_t>(buffer.block.actor);
+    return hit;
 }
 
 } // namespace physics_backend
@@ -21,7 +21,9 @@ public:
                                                            const PhysicsMaterial& material) override;
     std::unique_ptr<PhysicsPlayerControllerBackend> createPlayer(const glm::vec3& size) override;
     std::unique_ptr<PhysicsStaticBodyBackend> createStaticMesh(const std::string& meshPath) override;
-    bool raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3& hitPoint, glm::vec3& hitNormal) const override;
+    PhysicsQueryHit castRay(const PhysicsRayQuery& query) const override;
+    PhysicsQueryHit castSphere(const PhysicsSphereSweepQuery& query) const override;
+    PhysicsQueryHit overlapSphere(const PhysicsSphereOverlapQuery& query) const override;
 
     physx::PxPhysics* physics() const { return physics_; }
     physx::PxScene* scene() const { return scene_; }
@@ -33,7 +35,9 @@ private:
     physx::PxDefaultErrorCallback errorCallback_;
     physx::PxFoundation* foundation_ = nullptr;
     physx::PxPhysics* physics_ = nullptr;
+    // Exactly one of these drives the scene, picked by physics.JobPool.
     physx::PxDefaultCpuDispatcher* dispatcher_ = nullptr;
+    std::unique_ptr<physx::PxCpuDispatcher> poolDispatcher_;
     physx::PxScene* scene_ = nullptr;
     physx::PxMaterial* defaultMaterial_ = nullptr;
     physx::PxControllerManager* controllerManager_ = nullptr;
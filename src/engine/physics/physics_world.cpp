@@ -45,6 +45,28 @@ PhysicsPlayerController& PhysicsWorld::createPlayer() {
     return createPlayer(glm::vec3(1.0f, 2.0f, 1.0f));
 }
 
+PhysicsPlayerController PhysicsWorld::createPlayerController(const glm::vec3& size) {
+    if (!backend_) {
+        return PhysicsPlayerController();
+    }
+    return PhysicsPlayerController(backend_->createPlayer(size));
+}
+
+void PhysicsWorld::updatePlayers(const std::vector<PhysicsPlayerStep>& steps) {
+    if (!backend_ || steps.empty()) {
+        return;
+    }
+
+    std::vector<physics_backend::PlayerStep> backendSteps;
+    backendSteps.reserve(steps.size());
+    for (const auto& step : steps) {
+        if (step.controller && step.controller->backend_) {
+            backendSteps.push_back({step.controller->backend_.get(), step.deltaTime});
+        }
+    }
+    backend_->updatePlayers(backendSteps);
+}
+
 PhysicsStaticBody PhysicsWorld::createStaticMesh(const std::string& meshPath) {
     if (!backend_) {
         return PhysicsStaticBody();
@@ -59,5 +81,21 @@ bool PhysicsWorld::raycast(const glm::vec3& from,
     if (!backend_) {
         return false;
     }
-    return backend_->raycast(from, to, hitPoint, hitNormal);
+    const PhysicsQueryHit hit = backend_->castRay({from, to, {}});
+    if (!hit.hit) {
+        return false;
+    }
+    hitPoint = hit.point;
+    hitNormal = hit.normal;
+    return true;
+}
+
+void PhysicsWorld::query(const PhysicsQueryBatch& batch, PhysicsQueryResults& results) const {
+    if (!backend_) {
+        results.rays.assign(batch.rays.size(), PhysicsQueryHit{});
+        results.sweeps.assign(batch.sweeps.size(), PhysicsQueryHit{});
+        results.overlaps.assign(batch.overlaps.size(), PhysicsQueryHit{});
+        return;
+    }
+    backend_->query(batch, results);
 }
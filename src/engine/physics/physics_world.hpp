@@ -7,9 +7,15 @@
 #include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PhysicsPlayerController;
 
+struct PhysicsPlayerStep {
+    PhysicsPlayerController* controller = nullptr;
+    float deltaTime = 0.0f;
+};
+
 namespace physics_backend {
 class PhysicsWorldBackend;
 }
@@ -36,10 +42,20 @@ public:
 
     PhysicsPlayerController* playerController() { return playerController_.get(); }
 
+    // Controllers owned by the caller rather than the world; they are not
+    // stepped by update() and must be advanced with updatePlayers().
+    PhysicsPlayerController createPlayerController(const glm::vec3& size);
+    void updatePlayers(const std::vector<PhysicsPlayerStep>& steps);
+
     PhysicsStaticBody createStaticMesh(const std::string& meshPath);
 
     bool raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3& hitPoint, glm::vec3& hitNormal) const;
 
+    // Runs a batch of rays, sphere sweeps and sphere overlaps in parallel and
+    // fills one result per query. Must not run concurrently with update() or
+    // with bodies being created or destroyed.
+    void query(const PhysicsQueryBatch& batch, PhysicsQueryResults& results) const;
+
 private:
     std::unique_ptr<physics_backend::PhysicsWorldBackend> backend_;
     std::unique_ptr<PhysicsPlayerController> playerController_;
@@ -8,6 +8,10 @@ PhysicsPlayerController::~PhysicsPlayerController() {
     destroy();
 }
 
+bool PhysicsPlayerController::isValid() const {
+    return backend_ != nullptr;
+}
+
 glm::vec3 PhysicsPlayerController::getPosition() const {
     return backend_ ? backend_->getPosition() : glm::vec3(0.0f);
 }
@@ -15,6 +15,9 @@ public:
     PhysicsPlayerController& operator=(PhysicsPlayerController&& other) noexcept = default;
     ~PhysicsPlayerController();
 
+    // False when the backend cannot simulate characters (e.g. the query-only BVH world).
+    bool isValid() const;
+
     glm::vec3 getPosition() const;
     glm::quat getRotation() const;
     glm::vec3 getVelocity() const;
@@ -34,5 +37,7 @@ public:
     void destroy();
 
 private:
+    friend class PhysicsWorld;
+
     std::unique_ptr<physics_backend::PhysicsPlayerControllerBackend> backend_;
 };
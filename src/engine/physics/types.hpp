@@ -1,8 +1,79 @@
 #pragma once
 
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
 struct PhysicsMaterial {
     float friction = 0.0f;
     float restitution = 0.0f;
     float rollingFriction = 0.0f;
     float spinningFriction = 0.0f;
 };
+
+enum class PhysicsQueryBodies : uint8_t {
+    All,
+    StaticOnly,
+    DynamicOnly
+};
+
+// "No body" for query filters and hits. Handles are backend native ids, and 0
+// is a real one (Jolt's first body has index and sequence 0), so it can't
+// mean "none".
+constexpr std::uintptr_t PHYSICS_NO_BODY = std::numeric_limits<std::uintptr_t>::max();
+
+struct PhysicsQueryFilter {
+    PhysicsQueryBodies bodies = PhysicsQueryBodies::All;
+    // nativeHandle() of a body the query passes through (e.g. the caster);
+    // PHYSICS_NO_BODY for none.
+    std::uintptr_t ignoreBody = PHYSICS_NO_BODY;
+};
+
+struct PhysicsRayQuery {
+    glm::vec3 from{0.0f};
+    glm::vec3 to{0.0f};
+    PhysicsQueryFilter filter;
+};
+
+struct PhysicsSphereSweepQuery {
+    glm::vec3 from{0.0f};
+    glm::vec3 to{0.0f};
+    float radius = 0.0f;
+    PhysicsQueryFilter filter;
+};
+
+struct PhysicsSphereOverlapQuery {
+    glm::vec3 center{0.0f};
+    float radius = 0.0f;
+    PhysicsQueryFilter filter;
+};
+
+struct PhysicsQueryHit {
+    bool hit = false;
+    glm::vec3 point{0.0f};
+    // Unit surface normal, facing against the query direction.
+    glm::vec3 normal{0.0f};
+    // Fraction of the way from `from` to `to`; 0 for overlaps.
+    float fraction = 1.0f;
+    std::uintptr_t body = PHYSICS_NO_BODY;
+};
+
+struct PhysicsQueryBatch {
+    std::vector<PhysicsRayQuery> rays;
+    std::vector<PhysicsSphereSweepQuery> sweeps;
+    std::vector<PhysicsSphereOverlapQuery> overlaps;
+
+    void clear() {
+        rays.clear();
+        sweeps.clear();
+        overlaps.clear();
+    }
+};
+
+// One hit per query, in the same order as the batch.
+struct PhysicsQueryResults {
+    std::vector<PhysicsQueryHit> rays;
+    std::vector<PhysicsQueryHit> sweeps;
+    std::vector<PhysicsQueryHit> overlaps;
+};
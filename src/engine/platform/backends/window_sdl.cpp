@@ -4,6 +4,7 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <string>
 
@@ -342,8 +343,12 @@ public:
 
     void pollEvents() override {
         eventsBuffer.clear();
+        // SDL stamps events on its own nanosecond tick clock; map them onto the steady clock.
+        const auto steadyNow = std::chrono::steady_clock::now();
+        const Uint64 sdlNow = SDL_GetTicksNS();
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            const std::size_t firstNew = eventsBuffer.size();
             switch (event.type) {
                 case SDL_EVENT_QUIT: {
                     closeRequested = true;
@@ -430,6 +435,12 @@ public:
                 default:
                     break;
             }
+            const Uint64 age = event.common.timestamp < sdlNow ? sdlNow - event.common.timestamp : 0;
+            const auto timestamp = steadyNow - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::nanoseconds(age));
+            for (std::size_t i = firstNew; i < eventsBuffer.size(); ++i) {
+                eventsBuffer[i].timestamp = timestamp;
+            }
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
 namespace platform {
@@ -92,6 +93,8 @@ struct Event {
     int width = 0;
     int height = 0;
     bool focused = true;
+    // When the OS queued the event, on the steady clock. Default-constructed if the backend cannot tell.
+    std::chrono::steady_clock::time_point timestamp{};
 };
 
 } // namespace platform
@@ -18,17 +18,25 @@ void Actor::setScore(int score) {
 }
 
 float Actor::getParameter(const std::string &paramName, float defaultValue) const {
-    auto it = state.params.find(paramName);
-    if (it != state.params.end()) {
-        return it->second;
+    const PlayerParameterId param = game.world->parameterSchema().find(paramName);
+    if (param < state.params.size()) {
+        return state.params[param];
     }
     spdlog::warn("Actor::getParameter: Parameter '{}' not found, returning {}", paramName, defaultValue);
     return defaultValue;
 }
 
 void Actor::setParameters(const PlayerParameters &params) {
-    for (const auto &pair : params) {
-        state.params[pair.first] = pair.second;
+    state.params = params;
+}
+
+void Actor::applyParameterChanges(const std::vector<PlayerParameterChange> &changes) {
+    for (const auto &change : changes) {
+        if (change.id < state.params.size()) {
+            state.params[change.id] = change.value;
+        } else {
+            spdlog::warn("Actor::applyParameterChanges: Unknown parameter id {}", change.id);
+        }
     }
 }
 
@@ -3,6 +3,7 @@
 #include <string>
 #include "karma/core/types.hpp"
 #include "game/net/messages.hpp"
+#include "client/snapshot_buffer.hpp"
 #include <glm/vec3.hpp>
 
 class Game;
@@ -16,14 +17,27 @@ protected:
 public:
     Actor(Game &game, client_id id) : game(game), id(id) {}
     bool isEqual(client_id otherId) const;
+    client_id getId() const { return id; }
     const PlayerState &getState() const;
 
     void setLocation(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    // Location update from the server, with the server's send time on the
+    // local clock; remote actors buffer it for interpolation.
+    virtual void receiveLocation(SnapshotBuffer::clock::time_point /*sentAt*/,
+                                 const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity) {
+        setLocation(position, rotation, velocity);
+    }
+    virtual const SnapshotBufferStats *getInterpolationStats() const { return nullptr; }
     void setScore(int score);
 
+    // By name goes through the world's schema; per-frame code should keep the id.
     float getParameter(const std::string &paramName, float defaultValue = 0.0f) const;
+    float getParameter(PlayerParameterId param, float defaultValue = 0.0f) const {
+        return param < state.params.size() ? state.params[param] : defaultValue;
+    }
     void setParameters(const PlayerParameters &params);
     void setParameters(PlayerParameters &&params);
+    void applyParameterChanges(const std::vector<PlayerParameterChange> &changes);
     virtual void die();
 
     virtual ~Actor();
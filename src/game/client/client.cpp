@@ -27,12 +27,22 @@ Client::~Client() {
     game.engine.render->destroy(renderId);
 }
 
+void Client::receiveLocation(SnapshotBuffer::clock::time_point sentAt,
+                             const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity) {
+    snapshots.push(sentAt, position, rotation, velocity);
+}
+
 void Client::update(TimeUtils::duration /*deltaTime*/) {
+    SnapshotBuffer::Snapshot sample;
+    if (snapshots.sample(SnapshotBuffer::clock::now(), sample)) {
+        setLocation(sample.position, sample.rotation, sample.velocity);
+    }
     syncRenderFromState();
 }
 
 void Client::setState(const PlayerState &newState) {
     state = newState;
+    snapshots.reset(SnapshotBuffer::clock::now(), state.position, state.rotation, state.velocity);
 }
 
 void Client::die() {
@@ -48,6 +58,7 @@ void Client::die() {
 
 void Client::spawn(glm::vec3 position, glm::quat rotation, glm::vec3 velocity) {
     setLocation(position, rotation, velocity);
+    snapshots.reset(SnapshotBuffer::clock::now(), position, rotation, velocity);
     state.alive = true;
     justSpawned = true;
     lastSpawnPosition = state.position;
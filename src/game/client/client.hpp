@@ -5,6 +5,7 @@
 #include <glm/vec3.hpp>
 #include "karma/audio/audio.hpp"
 #include "actor.hpp"
+#include "snapshot_buffer.hpp"
 
 #include <string>
 
@@ -17,6 +18,7 @@ private:
     render_id renderId;
     bool justSpawned = false;
     glm::vec3 lastSpawnPosition{0.0f};
+    SnapshotBuffer snapshots;
 
     void syncRenderFromState();
 
@@ -27,6 +29,10 @@ public:
     std::string getName() const { return state.name; }
     int getScore() const { return state.score; }
 
+    void receiveLocation(SnapshotBuffer::clock::time_point sentAt,
+                         const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity) override;
+    const SnapshotBufferStats *getInterpolationStats() const override { return &snapshots.getStats(); }
+
     void update(TimeUtils::duration deltaTime) override;
     void setState(const PlayerState &newState) override;
     void die() override;
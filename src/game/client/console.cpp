@@ -11,9 +11,38 @@ void Console::focusChatInput() {
     chatInFocus = true;
 }
 
+bool Console::handleLocalCommand(const std::string &message) {
+    if (message == "/frametimes reset") {
+        game.engine.framePacer.resetHistogram();
+        game.engine.ui->addConsoleLine(std::string(), "Frame time histogram reset.");
+        return true;
+    }
+    if (message == "/frametimes") {
+        for (const auto &line : game.engine.framePacer.histogram().describe()) {
+            game.engine.ui->addConsoleLine(std::string(), line);
+        }
+        return true;
+    }
+    if (message == "/latency reset") {
+        game.engine.inputLatency.reset();
+        game.engine.ui->addConsoleLine(std::string(), "Input latency histogram reset.");
+        return true;
+    }
+    if (message == "/latency") {
+        for (const auto &line : game.engine.inputLatency.describe()) {
+            game.engine.ui->addConsoleLine(std::string(), line);
+        }
+        return true;
+    }
+    return false;
+}
+
 void Console::update() {
     if (chatInFocus) {
-        if (game.engine.ui->getChatInputBuffer().length() > 0) {
+        if (game.engine.ui->getChatInputBuffer().length() > 0 &&
+            handleLocalCommand(game.engine.ui->getChatInputBuffer())) {
+            game.engine.ui->clearChatInputBuffer();
+        } else if (game.engine.ui->getChatInputBuffer().length() > 0) {
             spdlog::trace("Console::update: Processing submitted chat input");
             std::string message = game.engine.ui->getChatInputBuffer();
             std::string consoleMessage = message;
@@ -44,21 +73,21 @@ void Console::update() {
             chatInFocus = false;
         }
     }
+}
 
-    for (const auto &msg : game.engine.network->consumeMessages<ServerMsg_Chat>()) {
-        std::string name;
-        if (auto *actor = game.getActorById(msg.fromId)) {
-            name = (game.player && actor == game.player) ? "YOU" : actor->getState().name;
-        } else if (msg.fromId == SERVER_CLIENT_ID) {
-            name = "SERVER";
-        } else {
-            name = "UNKNOWN";
-        }
-
-        if (game.player && msg.toId == game.player->getClientId()) {
-            name = "[" + name + " ->]";
-        }
+void Console::handleChat(const ServerMsg_Chat &msg) {
+    std::string name;
+    if (auto *actor = game.getActorById(msg.fromId)) {
+        name = (game.player && actor == game.player) ? "YOU" : actor->getState().name;
+    } else if (msg.fromId == SERVER_CLIENT_ID) {
+        name = "SERVER";
+    } else {
+        name = "UNKNOWN";
+    }
 
-        game.engine.ui->addConsoleLine(name, msg.text);
+    if (game.player && msg.toId == game.player->getClientId()) {
+        name = "[" + name + " ->]";
     }
+
+    game.engine.ui->addConsoleLine(name, msg.text);
 }
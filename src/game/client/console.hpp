@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "game/net/messages.hpp"
 
 class Game;
 
@@ -16,6 +17,9 @@ private:
     std::vector<struct ChatMsg> messages;
     bool chatInFocus = false;
 
+    // Commands answered by the client itself instead of being sent as chat.
+    bool handleLocalCommand(const std::string &message);
+
 public:
     Console(Game &game);
     ~Console() = default;
@@ -23,4 +27,5 @@ public:
     void update();
     bool isChatInFocus() const { return chatInFocus; }
     void focusChatInput();
+    void handleChat(const ServerMsg_Chat &msg);
 };
\ No newline at end of file
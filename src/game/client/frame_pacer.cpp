@@ -0,0 +1,135 @@
+#include "client/frame_pacer.hpp"
+
+#include "karma/common/config_helpers.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace game_client {
+
+namespace {
+
+float Milliseconds(FramePacer::clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+} // namespace
+
+const std::array<float, FrameTimeHistogram::BUCKETS - 1> FrameTimeHistogram::EDGES_MS = {
+    4.0f, 7.0f, 8.4f, 11.2f, 16.8f, 20.0f, 33.4f, 50.0f, 100.0f
+};
+
+FramePacerSettings FramePacerSettings::Read() {
+    FramePacerSettings settings;
+    settings.gameFps = std::max(0.0f, karma::config::ReadFloatConfig({"performance.MaxFPS"}, 120.0f));
+    settings.menuFps = std::max(0.0f, karma::config::ReadFloatConfig({"performance.MenuMaxFPS"}, 30.0f));
+    settings.spinWindow = std::chrono::microseconds(
+        karma::config::ReadUInt16Config({"performance.FramePacingSpinMicros"}, 1000));
+    return settings;
+}
+
+void FrameTimeHistogram::record(float frameMs, float workMs) {
+    std::size_t bucket = 0;
+    while (bucket < EDGES_MS.size() && frameMs >= EDGES_MS[bucket]) {
+        ++bucket;
+    }
+    ++counts[bucket];
+    ++frameCount;
+    totalFrameMs += frameMs;
+    totalWorkMs += workMs;
+    maxFrameMs = std::max(maxFrameMs, frameMs);
+}
+
+void FrameTimeHistogram::reset() {
+    *this = FrameTimeHistogram{};
+}
+
+float FrameTimeHistogram::percentileMs(float fraction) const {
+    if (frameCount == 0) {
+        return 0.0f;
+    }
+    const uint64_t target = static_cast<uint64_t>(fraction * static_cast<float>(frameCount));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < EDGES_MS.size(); ++i) {
+        seen += counts[i];
+        if (seen > target) {
+            return EDGES_MS[i];
+        }
+    }
+    return maxFrameMs;
+}
+
+std::vector<std::string> FrameTimeHistogram::describe() const {
+    std::vector<std::string> lines;
+    if (frameCount == 0) {
+        lines.push_back("No frames recorded.");
+        return lines;
+    }
+
+    const double frames = static_cast<double>(frameCount);
+    char line[192];
+    std::snprintf(line, sizeof(line),
+                  "%llu frames, avg %.2f ms (%.0f FPS), work %.2f ms, p50 < %.1f ms, p99 < %.1f ms, max %.1f ms",
+                  static_cast<unsigned long long>(frameCount),
+                  totalFrameMs / frames,
+                  totalFrameMs > 0.0 ? 1000.0 * frames / totalFrameMs : 0.0,
+                  totalWorkMs / frames,
+                  percentileMs(0.5f),
+                  percentileMs(0.99f),
+                  maxFrameMs);
+    lines.push_back(line);
+
+    float lower = 0.0f;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        const double share = 100.0 * static_cast<double>(counts[i]) / frames;
+        if (i < EDGES_MS.size()) {
+            std::snprintf(line, sizeof(line), "  %5.1f - %5.1f ms: %8llu (%5.1f%%)",
+                          lower, EDGES_MS[i], static_cast<unsigned long long>(counts[i]), share);
+            lower = EDGES_MS[i];
+        } else {
+            std::snprintf(line, sizeof(line), "  %5.1f ms and up: %8llu (%5.1f%%)",
+                          lower, static_cast<unsigned long long>(counts[i]), share);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+FramePacer::FramePacer(FramePacerSettings settings)
+    : settings_(settings),
+      frameStart_(clock::now()),
+      deadline_(frameStart_) {}
+
+void FramePacer::endFrame(bool inGame) {
+    const clock::time_point workEnd = clock::now();
+    const float fps = inGame ? settings_.gameFps : settings_.menuFps;
+
+    if (fps > 0.0f) {
+        const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(1.0f / fps));
+        deadline_ += period;
+        // After a long frame pace from now instead of rushing through frames
+        // to catch up; after the cap rises, do not wait out the old period.
+        if (deadline_ < workEnd) {
+            deadline_ = workEnd;
+        } else if (deadline_ > workEnd + period) {
+            deadline_ = workEnd + period;
+        }
+
+        const auto remaining = deadline_ - workEnd;
+        if (remaining > settings_.spinWindow) {
+            std::this_thread::sleep_for(remaining - settings_.spinWindow);
+        }
+        while (clock::now() < deadline_) {
+            std::this_thread::yield();
+        }
+    } else {
+        deadline_ = workEnd;
+    }
+
+    const clock::time_point frameEnd = clock::now();
+    histogram_.record(Milliseconds(frameEnd - frameStart_), Milliseconds(workEnd - frameStart_));
+    frameStart_ = frameEnd;
+}
+
+} // namespace game_client
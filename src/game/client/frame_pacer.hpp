@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game_client {
+
+struct FramePacerSettings {
+    // Frame rate caps; 0 leaves the loop unpaced (VSync, if on, still applies).
+    float gameFps = 120.0f;
+    // Used while no game is running or the console is open.
+    float menuFps = 30.0f;
+    // The last part of each wait is spun instead of slept, since OS sleeps overshoot.
+    std::chrono::microseconds spinWindow{1000};
+
+    static FramePacerSettings Read();
+};
+
+// Frame intervals bucketed by duration, for the /frametimes console command.
+class FrameTimeHistogram {
+public:
+    static constexpr std::size_t BUCKETS = 10;
+
+    void record(float frameMs, float workMs);
+    void reset();
+
+    uint64_t frames() const { return frameCount; }
+    // Upper bucket edge below which the given fraction of frames fell.
+    float percentileMs(float fraction) const;
+    std::vector<std::string> describe() const;
+
+private:
+    static const std::array<float, BUCKETS - 1> EDGES_MS;
+
+    std::array<uint64_t, BUCKETS> counts{};
+    uint64_t frameCount = 0;
+    double totalFrameMs = 0.0;
+    double totalWorkMs = 0.0;
+    float maxFrameMs = 0.0f;
+};
+
+// Caps the client loop to a target frame rate. endFrame() is called once per
+// frame after rendering and waits out what is left of the frame's budget,
+// sleeping for most of it and spinning the rest for an accurate wake-up.
+class FramePacer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit FramePacer(FramePacerSettings settings = FramePacerSettings::Read());
+
+    void endFrame(bool inGame);
+
+    const FrameTimeHistogram &histogram() const { return histogram_; }
+    void resetHistogram() { histogram_.reset(); }
+    const FramePacerSettings &settings() const { return settings_; }
+
+private:
+    FramePacerSettings settings_;
+    FrameTimeHistogram histogram_;
+    clock::time_point frameStart_;
+    clock::time_point deadline_;
+};
+
+} // namespace game_client
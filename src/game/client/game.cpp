@@ -3,6 +3,15 @@
 #include <algorithm>
 #include "ui/core/system.hpp"
 
+namespace {
+
+// Remote-only copies of the local player's own updates are ignored while roaming.
+bool IsOwnRoamingUpdate(const Game &game, client_id id) {
+    return game.isRoamingMode() && id == game.world->playerId;
+}
+
+} // namespace
+
 Game::Game(ClientEngine &engine,
            std::string playerName,
            std::string worldDir,
@@ -26,16 +35,117 @@ Game::Game(ClientEngine &engine,
     );
 
     focusState = FOCUS_STATE_GAME;
+
+    registerMessageHandlers();
 };
 
+void Game::registerMessageHandlers() {
+    ClientNetwork &net = *engine.network;
+
+    net.setHandler<ServerMsg_Chat>([this](const ServerMsg_Chat &msg) {
+        console->handleChat(msg);
+    });
+
+    net.setHandler<ServerMsg_PlayerJoin>([this](const ServerMsg_PlayerJoin &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId) || getActorById(msg.clientId)) {
+            return;
+        }
+        addActor(std::make_unique<Client>(*this, msg.clientId, msg.state));
+        spdlog::trace("Game: New client connected with ID {}", msg.clientId);
+    });
+
+    net.setHandler<ServerMsg_PlayerLeave>([this](const ServerMsg_PlayerLeave &msg) {
+        if (removeActor(msg.clientId)) {
+            spdlog::trace("Game: Client disconnected with ID {}", msg.clientId);
+        }
+    });
+
+    net.setHandler<ServerMsg_PlayerParameters>([this](const ServerMsg_PlayerParameters &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->applyParameterChanges(msg.changes);
+        }
+    });
+
+    net.setHandler<ServerMsg_PlayerState>([this](const ServerMsg_PlayerState &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->setState(msg.state);
+        }
+    });
+
+    net.setHandler<ServerMsg_PlayerLocation>([this](const ServerMsg_PlayerLocation &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        const auto sentAt = serverClock.observe(msg.serverTime, SnapshotBuffer::clock::now());
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->receiveLocation(sentAt, msg.position, msg.rotation, msg.velocity);
+        }
+    });
+
+    net.setHandler<ServerMsg_PlayerDeath>([this](const ServerMsg_PlayerDeath &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->die();
+        }
+    });
+
+    net.setHandler<ServerMsg_SetScore>([this](const ServerMsg_SetScore &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->setScore(msg.score);
+        }
+    });
+
+    net.setHandler<ServerMsg_PlayerSpawn>([this](const ServerMsg_PlayerSpawn &msg) {
+        if (IsOwnRoamingUpdate(*this, msg.clientId)) {
+            return;
+        }
+        if (auto *actor = getActorById(msg.clientId)) {
+            actor->spawn(msg.position, msg.rotation, msg.velocity);
+        }
+    });
+
+    net.setHandler<ServerMsg_InputAck>([this](const ServerMsg_InputAck &msg) {
+        if (player) {
+            player->reconcile(msg);
+        }
+    });
+
+    net.setHandler<ServerMsg_CreateShot>([this](const ServerMsg_CreateShot &msg) {
+        shots->spawnGlobal(msg.globalShotId, msg.position, msg.velocity);
+    });
+
+    net.setHandler<ServerMsg_RemoveShot>([this](const ServerMsg_RemoveShot &msg) {
+        shots->remove(msg.shotId, msg.isGlobalId);
+    });
+}
+
 Game::~Game() {
+    engine.network->clearHandlers();
+    shots.reset();
+
+    const SnapshotBufferStats stats = getInterpolationStats();
+    if (stats.samples > 0) {
+        spdlog::info("Game: Remote actor interpolation: {} samples, {} extrapolated, {} held, {} underruns, {} out-of-order snapshots",
+                     stats.samples, stats.extrapolated, stats.held, stats.underruns, stats.outOfOrder);
+    }
 
     world.reset();
     spdlog::trace("Game: World session destroyed successfully");
     console.reset();
     spdlog::trace("Game: Console destroyed successfully");
+    actorIndex.clear();
     actors.clear();
-    shots.clear();
 }
 
 void Game::earlyUpdate(TimeUtils::duration deltaTime) {
@@ -45,6 +155,10 @@ void Game::earlyUpdate(TimeUtils::duration deltaTime) {
         return;
     }
 
+    if (!shots) {
+        shots = std::make_unique<ShotSystem>(*this);
+    }
+
     if (!player && !roamingMode) {
         spdlog::trace("Game: Creating player with name '{}'", playerName);
         auto playerActor = std::make_unique<Player>(
@@ -56,7 +170,7 @@ void Game::earlyUpdate(TimeUtils::duration deltaTime) {
             communityAdmin,
             localAdmin);
         player = playerActor.get();
-        actors.push_back(std::move(playerActor));
+        addActor(std::move(playerActor));
         spdlog::trace("Game: Player created successfully");
     }
 
@@ -73,103 +187,23 @@ void Game::earlyUpdate(TimeUtils::duration deltaTime) {
         spdlog::trace("Game: Returning focus to game");
     }
 
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerJoin>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (getActorById(msg.clientId)) {
-            continue;
-        }
-        actors.push_back(std::make_unique<Client>(*this, msg.clientId, msg.state));
-        spdlog::trace("Game: New client connected with ID {}", msg.clientId);
-    }
-
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerLeave>()) {
-        auto it = std::remove_if(actors.begin(), actors.end(),
-            [&msg](const std::unique_ptr<Actor> &actor) {
-                return actor->isEqual(msg.clientId);
-            });
-
-        if (it != actors.end()) {
-            actors.erase(it, actors.end());
-            spdlog::trace("Game: Client disconnected with ID {}", msg.clientId);
-        }
-    }
+    engine.network->dispatchMessages();
 
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerParameters>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->setParameters(msg.params);
-        }
-    }
-
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerState>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->setState(msg.state);
-        }
-    }
-
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerLocation>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->setLocation(msg.position, msg.rotation, msg.velocity);
-        }
-    }
-
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerDeath>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->die();
-        }
-    }
-
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_SetScore>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->setScore(msg.score);
-        }
-    }
+    (void)deltaTime;
+}
 
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_PlayerSpawn>()) {
-        if (roamingMode && msg.clientId == world->playerId) {
-            continue;
-        }
-        if (auto *actor = getActorById(msg.clientId)) {
-            actor->spawn(msg.position, msg.rotation, msg.velocity);
-        }
+void Game::fixedUpdate(TimeUtils::duration stepDelta) {
+    if (!world->isInitialized()) {
+        return;
     }
 
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_CreateShot>()) {
-        shots.push_back(std::make_unique<Shot>(
-            *this,
-            msg.globalShotId,
-            msg.position,
-            msg.velocity
-        ));
+    if (player) {
+        player->fixedUpdate(stepDelta);
     }
 
-    for (const auto &msg : engine.network->consumeMessages<ServerMsg_RemoveShot>()) {
-        auto it = std::remove_if(shots.begin(), shots.end(),
-            [&msg](const std::unique_ptr<Shot> &shot) {
-                return shot->isEqual(msg.shotId, msg.isGlobalId);
-            });
-        if (it != shots.end()) {
-            shots.erase(it, shots.end());
-        }
+    if (shots) {
+        shots->update(stepDelta);
     }
-
-    (void)deltaTime;
 }
 
 void Game::lateUpdate(TimeUtils::duration deltaTime) {
@@ -181,11 +215,12 @@ void Game::lateUpdate(TimeUtils::duration deltaTime) {
         actor->update(deltaTime);
     }
 
-    for (const auto &shot : shots) {
-        shot->update(deltaTime);
+    if (shots) {
+        shots->present(engine.getInterpolationAlpha());
     }
 
     engine.updateRoamingCamera(deltaTime, focusState == FOCUS_STATE_GAME);
+    reportInterpolationStats();
 
     std::vector<ScoreboardEntry> scoreboard;
     scoreboard.reserve(actors.size());
@@ -202,11 +237,56 @@ void Game::lateUpdate(TimeUtils::duration deltaTime) {
     engine.ui->setScoreboardEntries(scoreboard);
 }
 
-Actor *Game::getActorById(client_id id) {
-    for (auto &actor : actors) {
-        if (actor->isEqual(id)) {
-            return actor.get();
+SnapshotBufferStats Game::getInterpolationStats() const {
+    SnapshotBufferStats total = departedInterpolationStats;
+    for (const auto &actor : actors) {
+        if (const SnapshotBufferStats *stats = actor->getInterpolationStats()) {
+            total += *stats;
         }
     }
-    return nullptr;
+    return total;
+}
+
+void Game::reportInterpolationStats() {
+    constexpr TimeUtils::duration REPORT_INTERVAL = 10.0f;
+    const TimeUtils::time now = TimeUtils::GetCurrentTime();
+    if (TimeUtils::GetElapsedTime(lastInterpolationReport, now) < REPORT_INTERVAL) {
+        return;
+    }
+    lastInterpolationReport = now;
+
+    const SnapshotBufferStats stats = getInterpolationStats();
+    if (stats.samples > 0) {
+        spdlog::debug("Game: Interpolation {} samples, {} interpolated, {} extrapolated, {} held, {} underruns",
+                      stats.samples, stats.interpolated, stats.extrapolated, stats.held, stats.underruns);
+    }
+}
+
+Actor *Game::getActorById(client_id id) {
+    auto it = actorIndex.find(id);
+    return it == actorIndex.end() ? nullptr : it->second;
+}
+
+void Game::addActor(std::unique_ptr<Actor> actor) {
+    actorIndex[actor->getId()] = actor.get();
+    actors.push_back(std::move(actor));
+}
+
+bool Game::removeActor(client_id id) {
+    auto indexed = actorIndex.find(id);
+    if (indexed == actorIndex.end()) {
+        return false;
+    }
+    Actor *departed = indexed->second;
+    actorIndex.erase(indexed);
+
+    if (const SnapshotBufferStats *stats = departed->getInterpolationStats()) {
+        departedInterpolationStats += *stats;
+    }
+    if (departed == player) {
+        player = nullptr;
+    }
+    actors.erase(std::find_if(actors.begin(), actors.end(),
+                              [departed](const std::unique_ptr<Actor> &actor) { return actor.get() == departed; }));
+    return true;
 }
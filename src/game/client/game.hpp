@@ -1,11 +1,12 @@
 #pragma once
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "karma/core/types.hpp"
 #include "game/net/messages.hpp"
 #include "game/engine/client_engine.hpp"
 #include "world_session.hpp"
-#include "shot.hpp"
+#include "shot_system.hpp"
 #include "console.hpp"
 
 #include "actor.hpp"
@@ -27,6 +28,20 @@ private:
     bool roamingMode = false;
 
     std::vector<std::unique_ptr<Actor>> actors;
+    std::unordered_map<client_id, Actor*> actorIndex;
+    void addActor(std::unique_ptr<Actor> actor);
+    bool removeActor(client_id id);
+
+    // Server messages are dispatched to these in arrival order.
+    void registerMessageHandlers();
+
+    // Server send times of location updates, mapped onto the local clock.
+    ServerClockEstimate serverClock;
+
+    // Interpolation counters of actors that have left, so totals survive them.
+    SnapshotBufferStats departedInterpolationStats;
+    TimeUtils::time lastInterpolationReport = TimeUtils::GetCurrentTime();
+    void reportInterpolationStats();
 
 public:
     ClientEngine &engine;
@@ -34,7 +49,8 @@ public:
     Player *player = nullptr;
     std::unique_ptr<ClientWorldSession> world;
     std::unique_ptr<Console> console;
-    std::vector<std::unique_ptr<Shot>> shots;
+    // Created once the world has loaded.
+    std::unique_ptr<ShotSystem> shots;
 
     FOCUS_STATE getFocusState() const { return focusState; }
     bool isRoamingMode() const { return roamingMode; }
@@ -47,11 +63,15 @@ public:
          bool localAdmin);
     ~Game();
 
+    // Once per frame: network messages and focus.
     void earlyUpdate(TimeUtils::duration deltaTime);
+    // Once per fixed simulation step, just before physics is stepped.
+    void fixedUpdate(TimeUtils::duration stepDelta);
+    // Once per frame: presentation, interpolated between the last two steps.
     void lateUpdate(TimeUtils::duration deltaTime);
 
-    void addShot(std::unique_ptr<Shot> shot) { shots.push_back(std::move(shot)); }
-
     const std::vector<std::unique_ptr<Actor>> &getActors() const { return actors; }
     Actor *getActorById(client_id id);
+    // Remote actor snapshot buffer counters, summed over every actor seen this session.
+    SnapshotBufferStats getInterpolationStats() const;
 };
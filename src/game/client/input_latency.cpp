@@ -0,0 +1,141 @@
+#include "client/input_latency.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace game_client {
+
+namespace {
+
+float Milliseconds(InputLatencyTracker::clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+bool IsInputEvent(const platform::Event &event) {
+    switch (event.type) {
+        case platform::EventType::WindowResize:
+        case platform::EventType::WindowFocus:
+        case platform::EventType::WindowClose:
+            return false;
+        default:
+            return true;
+    }
+}
+
+} // namespace
+
+const std::array<float, InputLatencyTracker::BUCKETS - 1> InputLatencyTracker::EDGES_MS = {
+    4.0f, 8.0f, 12.0f, 16.8f, 25.0f, 33.4f, 50.0f
+};
+
+void InputLatencyTracker::Pending::add(const std::vector<platform::Event> &batch, bool late) {
+    for (const auto &event : batch) {
+        if (!IsInputEvent(event) || event.timestamp == clock::time_point{}) {
+            continue;
+        }
+        if (events == 0) {
+            oldest = event.timestamp;
+            newest = event.timestamp;
+        } else {
+            oldest = std::min(oldest, event.timestamp);
+            newest = std::max(newest, event.timestamp);
+        }
+        ++events;
+        if (late) {
+            ++lateEvents;
+        }
+    }
+}
+
+void InputLatencyTracker::noteEvents(const std::vector<platform::Event> &events, bool late) {
+    pending.add(events, late);
+}
+
+void InputLatencyTracker::noteDeferredEvents(const std::vector<platform::Event> &events) {
+    deferred.add(events, true);
+}
+
+void InputLatencyTracker::framePresented(clock::time_point now) {
+    const Pending frame = pending;
+    pending = deferred;
+    deferred = Pending{};
+    if (frame.events == 0) {
+        return;
+    }
+
+    const float oldestMs = std::max(0.0f, Milliseconds(now - frame.oldest));
+    const float newestMs = std::max(0.0f, Milliseconds(now - frame.newest));
+    std::size_t bucket = 0;
+    while (bucket < EDGES_MS.size() && oldestMs >= EDGES_MS[bucket]) {
+        ++bucket;
+    }
+    ++counts[bucket];
+    ++frameCount;
+    eventCount += frame.events;
+    lateEventCount += frame.lateEvents;
+    totalOldestMs += oldestMs;
+    totalNewestMs += newestMs;
+    maxOldestMs = std::max(maxOldestMs, oldestMs);
+}
+
+void InputLatencyTracker::reset() {
+    *this = InputLatencyTracker{};
+}
+
+float InputLatencyTracker::percentileMs(float fraction) const {
+    if (frameCount == 0) {
+        return 0.0f;
+    }
+    const uint64_t target = static_cast<uint64_t>(fraction * static_cast<float>(frameCount));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < EDGES_MS.size(); ++i) {
+        seen += counts[i];
+        if (seen > target) {
+            return EDGES_MS[i];
+        }
+    }
+    return maxOldestMs;
+}
+
+std::vector<std::string> InputLatencyTracker::describe() const {
+    std::vector<std::string> lines;
+    if (frameCount == 0) {
+        lines.push_back("No input frames recorded.");
+        return lines;
+    }
+
+    const double frames = static_cast<double>(frameCount);
+    char line[192];
+    std::snprintf(line, sizeof(line),
+                  "%llu frames with input, oldest event avg %.2f ms (p50 < %.1f ms, p99 < %.1f ms, max %.1f ms), "
+                  "newest event avg %.2f ms",
+                  static_cast<unsigned long long>(frameCount),
+                  totalOldestMs / frames,
+                  percentileMs(0.5f),
+                  percentileMs(0.99f),
+                  maxOldestMs,
+                  totalNewestMs / frames);
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "%llu events, %llu (%.1f%%) picked up by the late re-poll",
+                  static_cast<unsigned long long>(eventCount),
+                  static_cast<unsigned long long>(lateEventCount),
+                  eventCount > 0 ? 100.0 * static_cast<double>(lateEventCount) / static_cast<double>(eventCount) : 0.0);
+    lines.push_back(line);
+
+    float lower = 0.0f;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        const double share = 100.0 * static_cast<double>(counts[i]) / frames;
+        if (i < EDGES_MS.size()) {
+            std::snprintf(line, sizeof(line), "  %5.1f - %5.1f ms: %8llu (%5.1f%%)",
+                          lower, EDGES_MS[i], static_cast<unsigned long long>(counts[i]), share);
+            lower = EDGES_MS[i];
+        } else {
+            std::snprintf(line, sizeof(line), "  %5.1f ms and up: %8llu (%5.1f%%)",
+                          lower, static_cast<unsigned long long>(counts[i]), share);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+} // namespace game_client
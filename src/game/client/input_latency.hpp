@@ -0,0 +1,61 @@
+#pragma once
+
+#include "karma/platform/events.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game_client {
+
+// Measures how long input events wait between being queued by the OS and the
+// frame that reflects them being submitted, for the /latency console command.
+class InputLatencyTracker {
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t BUCKETS = 8;
+
+    // Called for every batch of polled events the frame being built reflects;
+    // late marks a late-latch re-poll.
+    void noteEvents(const std::vector<platform::Event> &events, bool late);
+    // Late-latch events that only reach the simulation next frame; they are
+    // charged to the frame presented after the current one.
+    void noteDeferredEvents(const std::vector<platform::Event> &events);
+    // Called right after the frame is submitted. Frames without input are not recorded.
+    void framePresented(clock::time_point now);
+    void reset();
+
+    uint64_t frames() const { return frameCount; }
+    // Upper bucket edge below which the given fraction of frames' oldest input fell.
+    float percentileMs(float fraction) const;
+    std::vector<std::string> describe() const;
+
+private:
+    static const std::array<float, BUCKETS - 1> EDGES_MS;
+
+    // Input events waiting for the frame that reflects them.
+    struct Pending {
+        clock::time_point oldest{};
+        clock::time_point newest{};
+        uint32_t events = 0;
+        uint32_t lateEvents = 0;
+
+        void add(const std::vector<platform::Event> &batch, bool late);
+    };
+
+    // Consumed by the frame being built, and by the frame after it.
+    Pending pending;
+    Pending deferred;
+
+    std::array<uint64_t, BUCKETS> counts{};
+    uint64_t frameCount = 0;
+    uint64_t eventCount = 0;
+    uint64_t lateEventCount = 0;
+    double totalOldestMs = 0.0;
+    double totalNewestMs = 0.0;
+    float maxOldestMs = 0.0f;
+};
+
+} // namespace game_client
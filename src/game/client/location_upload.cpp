@@ -0,0 +1,74 @@
+#include "client/location_upload.hpp"
+#include "karma/common/config_helpers.hpp"
+#include <algorithm>
+
+namespace {
+// Extra copies of the update that brings the tank to rest.
+constexpr uint32_t STOP_REPEATS = 2;
+
+bool IsMoving(const glm::vec3 &velocity) {
+    return glm::dot(velocity, velocity) > 1e-6f;
+}
+} // namespace
+
+LocationUploadSettings LocationUploadSettings::Read() {
+    LocationUploadSettings settings;
+    settings.maxRateHz =
+        std::max(1.0f, karma::config::ReadFloatConfig({"game.locationUpload.MaxRateHz"}, 30.0f));
+    settings.keepaliveHz =
+        std::max(0.0f, karma::config::ReadFloatConfig({"game.locationUpload.KeepaliveHz"}, 5.0f));
+    settings.positionTolerance =
+        std::max(0.0f, karma::config::ReadFloatConfig({"game.locationUpload.PositionTolerance"}, 0.1f));
+    settings.rotationToleranceDeg =
+        std::max(0.0f, karma::config::ReadFloatConfig({"game.locationUpload.RotationToleranceDeg"}, 2.0f));
+    return settings;
+}
+
+LocationUploadScheduler::LocationUploadScheduler(LocationUploadSettings settings) : settings(settings) {}
+
+bool LocationUploadScheduler::shouldSend(clock::time_point now,
+                                         const glm::vec3 &position,
+                                         const glm::quat &rotation) const {
+    ++checks;
+    if (!hasSent) {
+        return true;
+    }
+
+    const float elapsed = std::chrono::duration<float>(now - lastSentTime).count();
+    if (elapsed < 1.0f / settings.maxRateHz) {
+        return false;
+    }
+
+    const glm::vec3 extrapolated = lastPosition + lastVelocity * elapsed;
+    if (glm::distance(extrapolated, position) > settings.positionTolerance) {
+        return true;
+    }
+    if (angleBetween(lastRotation, rotation) > settings.rotationToleranceDeg) {
+        return true;
+    }
+    if (stopRepeatsLeft > 0) {
+        return true;
+    }
+
+    return settings.keepaliveHz > 0.0f && elapsed >= 1.0f / settings.keepaliveHz;
+}
+
+void LocationUploadScheduler::markSent(clock::time_point now,
+                                       const glm::vec3 &position,
+                                       const glm::quat &rotation,
+                                       const glm::vec3 &velocity) {
+    if (IsMoving(velocity)) {
+        stopRepeatsLeft = 0;
+    } else if (hasSent && IsMoving(lastVelocity)) {
+        stopRepeatsLeft = STOP_REPEATS;
+    } else if (stopRepeatsLeft > 0) {
+        --stopRepeatsLeft;
+    }
+
+    hasSent = true;
+    lastSentTime = now;
+    lastPosition = position;
+    lastRotation = rotation;
+    lastVelocity = velocity;
+    ++sends;
+}
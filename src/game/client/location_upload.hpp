@@ -0,0 +1,54 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include <chrono>
+#include <cstdint>
+
+struct LocationUploadSettings {
+    // Never send more often than this, whatever the frame rate.
+    float maxRateHz = 30.0f;
+    // Send at least this often, moving or not, so a lost update is repaired.
+    // Keep 1/keepaliveHz below the receivers' game.interpolation.MaxExtrapolationMs,
+    // or they freeze between updates.
+    float keepaliveHz = 5.0f;
+    // How far the receivers' extrapolation may drift from the real pose.
+    float positionTolerance = 0.1f;
+    float rotationToleranceDeg = 2.0f;
+
+    static LocationUploadSettings Read();
+};
+
+// Decides when the local player's location is worth sending. Receivers
+// extrapolate the last sent state along its velocity, so an update is only
+// needed once that extrapolation would be off by more than the tolerance.
+class LocationUploadScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit LocationUploadScheduler(LocationUploadSettings settings = LocationUploadSettings::Read());
+
+    bool shouldSend(clock::time_point now,
+                    const glm::vec3 &position,
+                    const glm::quat &rotation) const;
+    void markSent(clock::time_point now,
+                  const glm::vec3 &position,
+                  const glm::quat &rotation,
+                  const glm::vec3 &velocity);
+    // Forces the next check to send, e.g. after a spawn.
+    void reset() { hasSent = false; }
+
+    uint64_t getChecks() const { return checks; }
+    uint64_t getSends() const { return sends; }
+
+private:
+    LocationUploadSettings settings;
+    bool hasSent = false;
+    clock::time_point lastSentTime;
+    glm::vec3 lastPosition{0.0f};
+    glm::quat lastRotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 lastVelocity{0.0f};
+    // Repeats of a "stopped" update still to send. Locations go out
+    // unreliably, and a lost stop leaves receivers extrapolating a moving tank.
+    uint32_t stopRepeatsLeft = 0;
+    mutable uint64_t checks = 0;
+    uint64_t sends = 0;
+};
@@ -32,8 +32,6 @@
 #include <unistd.h>
 #endif
 
-constexpr TimeUtils::duration MIN_DELTA_TIME = 1.0f / 120.0f;
-
 namespace {
 struct FullscreenState {
     bool active = false;
@@ -198,32 +196,31 @@ public:
 
     void onUpdate(karma::app::EngineContext &, float dt) override {
         lastDt_ = dt;
-        if (dt < MIN_DELTA_TIME) {
-            TimeUtils::sleep(MIN_DELTA_TIME - dt);
-            return;
-        }
 
         engine_.earlyUpdate(dt);
+        serverConnector_.update();
 
-        if (quickStartPending_ && !engine_.network->isConnected()) {
-            const TimeUtils::time now = TimeUtils::GetCurrentTime();
-            if (TimeUtils::GetElapsedTime(quickStartLastAttempt_, now) >= quickStartRetryDelay_) {
-                quickStartLastAttempt_ = now;
-                ++quickStartAttempts_;
-                engine_.setRoamingModeSession(false);
-                if (serverConnector_.connect("localhost",
+        if (quickStartPending_) {
+            if (game_) {
+                quickStartPending_ = false;
+                if (cliOptions_.devQuickStart) {
+                    engine_.ui->console().hide();
+                }
+            } else if (!serverConnector_.isConnecting()) {
+                const TimeUtils::time now = TimeUtils::GetCurrentTime();
+                if (quickStartAttempts_ >= quickStartMaxAttempts_) {
+                    spdlog::error("dev-quick-start: failed to connect after {} attempts.", quickStartAttempts_);
+                    quickStartPending_ = false;
+                } else if (TimeUtils::GetElapsedTime(quickStartLastAttempt_, now) >= quickStartRetryDelay_) {
+                    quickStartLastAttempt_ = now;
+                    ++quickStartAttempts_;
+                    engine_.setRoamingModeSession(false);
+                    serverConnector_.connect("localhost",
                                              cliOptions_.connectPort,
                                              cliOptions_.playerName,
                                              false,
                                              false,
-                                             false)) {
-                    quickStartPending_ = false;
-                    if (cliOptions_.devQuickStart) {
-                        engine_.ui->console().hide();
-                    }
-                } else if (quickStartAttempts_ >= quickStartMaxAttempts_) {
-                    spdlog::error("dev-quick-start: failed to connect after {} attempts.", quickStartAttempts_);
-                    quickStartPending_ = false;
+                                             false);
                 }
             }
         }
@@ -244,6 +241,8 @@ public:
         if (engine_.ui->console().consumeQuitRequest()) {
             if (game_) {
                 engine_.network->disconnect("Disconnected from server.");
+            } else {
+                serverConnector_.cancel();
             }
         }
 
@@ -275,14 +274,23 @@ public:
             game_->earlyUpdate(dt);
         }
 
-        engine_.step(dt);
+        const int steps = engine_.advanceSimulation(dt);
+        const TimeUtils::duration stepDt = engine_.getFixedStepDelta();
+        for (int i = 0; i < steps; ++i) {
+            if (game_) {
+                game_->fixedUpdate(stepDt);
+            }
+            engine_.step(stepDt);
+        }
     }
 
     void onRender(karma::app::EngineContext &) override {
+        engine_.latchLateInput();
         if (game_) {
             game_->lateUpdate(lastDt_);
         }
         engine_.lateUpdate(lastDt_);
+        engine_.framePacer.endFrame(game_ && !engine_.ui->console().isVisible());
     }
 
     bool shouldQuit() const override { return window_.shouldClose(); }
@@ -8,7 +8,6 @@
 #include <utility>
 #include <memory>
 #include "spdlog/spdlog.h"
-#include "shot.hpp"
 
 Player::Player(Game &game,
                client_id id,
@@ -26,16 +25,20 @@ Player::Player(Game &game,
     spawnAudio(audioEngine.loadClip(game.world->resolveAssetPath("audio.player.Spawn").string(), 1)),
     landAudio(audioEngine.loadClip(game.world->resolveAssetPath("audio.player.Land").string(), 1)),
       lastJumpTime(TimeUtils::GetCurrentTime()),
-      jumpCooldown(TimeUtils::getDuration(0.1f)) {
+      jumpCooldown(TimeUtils::getDuration(game_common::TANK_JUMP_COOLDOWN)) {
         setParameters(std::move(params));
+    const PlayerParameterSchema &schema = game.world->parameterSchema();
+    speedParam = schema.find("speed");
+    turnSpeedParam = schema.find("turnSpeed");
+    jumpSpeedParam = schema.find("jumpSpeed");
+    shotSpeedParam = schema.find("shotSpeed");
+    serverMovement = game.world->hasFeature(NET_FEATURE_SERVER_MOVEMENT);
     state.name = name;
     state.registeredUser = registeredUser;
     state.communityAdmin = communityAdmin;
     state.localAdmin = localAdmin;
     state.alive = false;
     state.score = 0;
-    lastPosition = glm::vec3(0.0f);
-    lastRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
 
     renderId = game.engine.render->create();
     game.engine.render->setRadarCircleGraphic(renderId, 1.2f);
@@ -49,6 +52,11 @@ Player::Player(Game &game,
 }
 
 Player::~Player() {
+    if (locationUpload.getChecks() > 0) {
+        spdlog::debug("Player::~Player: Sent {} location update(s) over {} frame(s) alive",
+                      locationUpload.getSends(),
+                      locationUpload.getChecks());
+    }
     game.engine.render->destroy(renderId);
 }
 
@@ -62,46 +70,46 @@ void Player::setExtents(const glm::vec3& extents) {
     }
 }
 
-void Player::earlyUpdate() {
+void Player::fixedUpdate(TimeUtils::duration /*stepDelta*/) {
+    sendSteppedInput();
+
+    prevSimPosition = physics->getPosition();
+    prevSimRotation = physics->getRotation();
+
     bool wasGrounded = grounded;
     grounded = physics->isGrounded();
 
-    game.engine.render->setPosition(renderId, state.position);
-
     if (state.alive) {
-        game.engine.ui->setDialogVisible(false);
-        
+        game_common::TankInput input;
         if (grounded) {
-            glm::vec2 movement(0.0f);
-            if (game.getFocusState() == FOCUS_STATE_GAME)
-                movement = game.engine.getInputState().movement;
-            glm::vec3 movementVector = physics->getForwardVector();
-            movementVector *= movement.y * getParameter("speed");
-            movementVector.y = physics->getVelocity().y;
-
-            physics->setVelocity(movementVector);
-
-            physics->setAngularVelocity(glm::vec3(
-                0.0f,
-                -movement.x * getParameter("turnSpeed"),
-                0.0f
-            ));
-
             if (game.getFocusState() == FOCUS_STATE_GAME) {
-                if (grounded && game.engine.getInputState().jump && TimeUtils::GetElapsedTime(lastJumpTime, TimeUtils::GetCurrentTime()) >= jumpCooldown) {
-                    glm::vec3 velocity = physics->getVelocity();
-                    velocity.y = getParameter("jumpSpeed");
-                    physics->setVelocity(velocity);
+                input.movement = game.engine.getInputState().movement;
+                if (game.engine.getInputState().jump && TimeUtils::GetElapsedTime(lastJumpTime, TimeUtils::GetCurrentTime()) >= jumpCooldown) {
+                    input.jump = true;
                     lastJumpTime = TimeUtils::GetCurrentTime();
-                    grounded = false;
-                    jumpAudio.play(state.position);
+                    jumpAudio.play(prevSimPosition);
                 }
             }
 
+            game_common::ApplyTankInput(*physics, input, movementParams());
+            if (input.jump) {
+                grounded = false;
+            }
+
             if (wasGrounded == false) {
-                landAudio.play(state.position);
+                landAudio.play(prevSimPosition);
             }
         }
+        issueInput(input);
+    } else if (grounded) {
+        physics->setVelocity(glm::vec3(0.0f));
+        physics->setAngularVelocity(glm::vec3(0.0f));
+    }
+}
+
+void Player::earlyUpdate() {
+    if (state.alive) {
+        game.engine.ui->setDialogVisible(false);
 
         if (game.getFocusState() == FOCUS_STATE_GAME) {
             if (game.engine.getInputState().fire) {
@@ -126,7 +134,7 @@ void Player::earlyUpdate() {
                     }
                 }
 
-                glm::vec3 shotVelocity = getForwardVector() * getParameter("shotSpeed") + getVelocity();
+                glm::vec3 shotVelocity = getForwardVector() * getParameter(shotSpeedParam) + getVelocity();
 
                 const glm::vec3 playerHitCenter = state.position + glm::vec3(0.0f, 1.0f, 0.0f);
                 const glm::vec3 toShot = shotPosition - playerHitCenter;
@@ -143,17 +151,11 @@ void Player::earlyUpdate() {
                     shotPosition = playerHitCenter + fwd * minSelfShotDistance;
                 }
 
-                auto shot = std::make_unique<Shot>(game, shotPosition, shotVelocity);
-                game.addShot(std::move(shot));
+                game.shots->fireLocal(shotPosition, shotVelocity);
             }
         }
 
     } else {
-        if (grounded) {
-            physics->setVelocity(glm::vec3(0.0f));
-            physics->setAngularVelocity(glm::vec3(0.0f));
-        }
-
         game.engine.ui->setDialogVisible(true);
 
         if (game.engine.getInputState().spawn) {
@@ -165,36 +167,132 @@ void Player::earlyUpdate() {
 
 void Player::lateUpdate() {
     setLocation(physics->getPosition(), physics->getRotation(), physics->getVelocity());
-    game.engine.render->setCameraPosition(state.position + glm::vec3(0.0f, muzzleOffset.y, 0.0f));
-    game.engine.render->setCameraRotation(state.rotation);
+
+    // Present the tank between the last two simulation steps so motion stays
+    // smooth when the frame rate and the simulation rate differ.
+    const float alpha = game.engine.getInterpolationAlpha();
+    const glm::vec3 presentedPosition = glm::mix(prevSimPosition, state.position, alpha);
+    const glm::quat presentedRotation = glm::slerp(prevSimRotation, state.rotation, alpha);
+
+    game.engine.render->setPosition(renderId, presentedPosition);
+    game.engine.render->setCameraPosition(presentedPosition + glm::vec3(0.0f, muzzleOffset.y, 0.0f));
+    game.engine.render->setCameraRotation(presentedRotation);
     const auto &ctx = game.engine.render->mainContext();
     const float halfVertRad = glm::radians(ctx.fov * 0.5f);
     const float halfHorizRad = std::atan(std::tan(halfVertRad) * ctx.aspect);
     game.engine.render->setRadarFOVLinesAngle(glm::degrees(halfHorizRad * 2.0f));
 
-    if (state.alive) {
-        if (glm::distance(lastPosition, state.position) > POSITION_UPDATE_THRESHOLD ||
-            angleBetween(lastRotation, state.rotation) > ROTATION_UPDATE_THRESHOLD) {
+    if (state.alive && !serverMovement) {
+        const auto now = LocationUploadScheduler::clock::now();
+        if (locationUpload.shouldSend(now, state.position, state.rotation)) {
             ClientMsg_PlayerLocation locMsg;
             locMsg.position = state.position;
             locMsg.rotation = state.rotation;
+            locMsg.velocity = state.velocity;
             game.engine.network->send<ClientMsg_PlayerLocation>(locMsg);
-            lastPosition = state.position;
-            lastRotation = state.rotation;
+            locationUpload.markSent(now, state.position, state.rotation, state.velocity);
         }
     }
 
-    audioEngine.setListenerPosition(state.position);
-    audioEngine.setListenerRotation(state.rotation);
+    audioEngine.setListenerPosition(presentedPosition);
+    audioEngine.setListenerRotation(presentedRotation);
+}
+
+game_common::TankMovementParams Player::movementParams() const {
+    game_common::TankMovementParams params;
+    params.speed = getParameter(speedParam);
+    params.turnSpeed = getParameter(turnSpeedParam);
+    params.jumpSpeed = getParameter(jumpSpeedParam);
+    return params;
+}
+
+void Player::issueInput(const game_common::TankInput &input) {
+    if (!serverMovement) {
+        return;
+    }
+
+    if (issuedInput) {
+        // Physics has not stepped since the last input (very short frame), so
+        // this one replaces it; a jump already applied to the controller stays.
+        issuedInput->movement = input.movement;
+        issuedInput->jump = issuedInput->jump || input.jump;
+        return;
+    }
+
+    ClientMsg_PlayerInput msg;
+    msg.sequence = nextInputSequence++;
+    msg.deltaTime = 0.0f;
+    msg.movement = input.movement;
+    msg.jump = input.jump;
+    issuedInput = msg;
+    issuedAtStep = game.engine.getStepCount();
+}
+
+void Player::sendSteppedInput() {
+    if (!issuedInput || game.engine.getStepCount() == issuedAtStep) {
+        return;
+    }
+
+    // The input was simulated by the physics step(s) since it was issued.
+    issuedInput->deltaTime = game.engine.getLastStepDelta();
+    game.engine.network->send<ClientMsg_PlayerInput>(*issuedInput);
+    unackedInputs.push_back(*issuedInput);
+    issuedInput.reset();
+
+    // The server never queues more than this, so older inputs can no longer be acked.
+    constexpr std::size_t MAX_UNACKED_INPUTS = 128;
+    while (unackedInputs.size() > MAX_UNACKED_INPUTS) {
+        unackedInputs.pop_front();
+    }
+}
+
+void Player::reconcile(const ServerMsg_InputAck &ack) {
+    if (!serverMovement || !state.alive) {
+        return;
+    }
+    if (ack.sequence <= lastAckedSequence || ack.sequence < spawnSequence) {
+        return;
+    }
+    lastAckedSequence = ack.sequence;
+
+    while (!unackedInputs.empty() && unackedInputs.front().sequence <= ack.sequence) {
+        unackedInputs.pop_front();
+    }
+
+    const glm::vec3 predicted = physics->getPosition();
+    physics->setPosition(ack.position);
+    physics->setRotation(ack.rotation);
+    physics->setVelocity(ack.velocity);
+
+    const game_common::TankMovementParams params = movementParams();
+    for (const auto &input : unackedInputs) {
+        game_common::ApplyTankInput(*physics, {input.movement, input.jump}, params);
+        physics->update(input.deltaTime);
+    }
+    if (issuedInput) {
+        game_common::ApplyTankInput(*physics, {issuedInput->movement, issuedInput->jump}, params);
+    }
+
+    const float correction = glm::distance(predicted, physics->getPosition());
+    constexpr float CORRECTION_LOG_THRESHOLD = 0.01f;
+    if (correction > CORRECTION_LOG_THRESHOLD) {
+        spdlog::trace("Player::reconcile: Corrected prediction by {:.3f}m at sequence {} ({} replayed)",
+                      correction,
+                      ack.sequence,
+                      unackedInputs.size());
+    }
 }
 
 void Player::update(TimeUtils::duration /*deltaTime*/) {
+    sendSteppedInput();
     earlyUpdate();
     lateUpdate();
 }
 
 void Player::setState(const PlayerState &newState) {
     state = newState;
+    prevSimPosition = state.position;
+    prevSimRotation = state.rotation;
     if (physics) {
         physics->setPosition(state.position);
         physics->setRotation(state.rotation);
@@ -210,16 +308,23 @@ void Player::die() {
     dieAudio.play(state.position);
     state.alive = false;
     auto vel = physics->getVelocity();
-    physics->setVelocity(glm::vec3(vel.x, getParameter("jumpSpeed"), vel.z));
+    physics->setVelocity(glm::vec3(vel.x, getParameter(jumpSpeedParam), vel.z));
 }
 
 void Player::spawn(glm::vec3 position, glm::quat rotation, glm::vec3 velocity) {
     spawnAudio.play(position);
     state.alive = true;
     setLocation(position, rotation, velocity);
+    prevSimPosition = position;
+    prevSimRotation = rotation;
+    locationUpload.reset();
 
     physics->setPosition(position);
     physics->setRotation(rotation);
     physics->setVelocity(velocity);
     physics->setAngularVelocity(glm::vec3(0.0f));
+
+    issuedInput.reset();
+    unackedInputs.clear();
+    spawnSequence = nextInputSequence;
 }
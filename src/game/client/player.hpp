@@ -5,12 +5,14 @@
 #include "game/net/messages.hpp"
 #include "karma/physics/player_controller.hpp"
 #include "karma/audio/audio.hpp"
+#include "game/common/tank_movement.hpp"
 #include <spdlog/spdlog.h>
+#include <cstdint>
+#include <deque>
+#include <optional>
 
 #include "actor.hpp"
-
-#define POSITION_UPDATE_THRESHOLD 0.01f
-#define ROTATION_UPDATE_THRESHOLD 0.01f
+#include "location_upload.hpp"
 
 class Game;
 
@@ -28,12 +30,38 @@ private:
     TimeUtils::time lastJumpTime;
     TimeUtils::duration jumpCooldown;
 
-    glm::vec3 lastPosition;
-    glm::quat lastRotation;
+    LocationUploadScheduler locationUpload;
+
+    // Controller pose before the most recent simulation step, for interpolation.
+    glm::vec3 prevSimPosition{0.0f};
+    glm::quat prevSimRotation{1.0f, 0.0f, 0.0f, 0.0f};
 
     render_id renderId;
     glm::vec3 muzzleOffset{0.0f, 1.18f, 2.22f};
 
+    // Parameters read every frame, looked up in the schema once.
+    PlayerParameterId speedParam;
+    PlayerParameterId turnSpeedParam;
+    PlayerParameterId jumpSpeedParam;
+    PlayerParameterId shotSpeedParam;
+
+    // Server movement (NET_FEATURE_SERVER_MOVEMENT): the local tank is
+    // predicted from input and reconciled against the server's acks.
+    bool serverMovement = false;
+    uint32_t nextInputSequence = 1;
+    uint32_t lastAckedSequence = 0;
+    // Acks for inputs issued before the latest spawn describe the previous life.
+    uint32_t spawnSequence = 0;
+    // Input applied to the controller but not yet stepped by physics.
+    std::optional<ClientMsg_PlayerInput> issuedInput;
+    uint64_t issuedAtStep = 0;
+    // Inputs sent and stepped locally that the server has not acked yet.
+    std::deque<ClientMsg_PlayerInput> unackedInputs;
+
+    game_common::TankMovementParams movementParams() const;
+    void issueInput(const game_common::TankInput &input);
+    void sendSteppedInput();
+
 public:
     Player(Game &game,
            client_id,
@@ -56,9 +84,16 @@ public:
     void setScore(int score) { Actor::setScore(score); }
 
     void setExtents(const glm::vec3& extents);
+    // Fixed simulation step: driving input, before physics steps.
+    void fixedUpdate(TimeUtils::duration stepDelta);
+    // Per frame: firing, spawn requests and UI.
     void earlyUpdate();
+    // Per frame: reads the simulated pose and presents it interpolated.
     void lateUpdate();
 
+    // Rewinds the controller to the server's state and replays unacked input on top.
+    void reconcile(const ServerMsg_InputAck &ack);
+
     void update(TimeUtils::duration deltaTime) override;
     void setState(const PlayerState &newState) override;
     void die() override;
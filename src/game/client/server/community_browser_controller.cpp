@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <unordered_map>
@@ -374,6 +375,20 @@ void CommunityBrowserController::rebuildEntries() {
         entries.push_back(std::move(entry));
     }
 
+    // Probes only servers without a fresh cached result, so rebuilding on every
+    // pong or list refresh does not ping the same servers again.
+    std::vector<ServerPinger::Target> pingTargets;
+    pingTargets.reserve(entries.size());
+    for (auto &entry : entries) {
+        pingTargets.push_back(ServerPinger::Target{entry.host, entry.port});
+        if (auto ping = pinger.getResult(entry.host, entry.port)) {
+            entry.pingMs = ping->rttMs >= 0.0f ? static_cast<int>(std::lround(ping->rttMs)) : -1;
+            entry.jitterMs = ping->jitterMs >= 0.0f ? static_cast<int>(std::lround(ping->jitterMs)) : -1;
+            entry.lossPercent = static_cast<int>(std::lround(ping->lossPercent));
+        }
+    }
+    pinger.probe(pingTargets);
+
     lastGuiEntries = entries;
     browser.setEntries(lastGuiEntries);
     if (!entries.empty()) {
@@ -424,6 +439,12 @@ void CommunityBrowserController::update() {
         }
     }
 
+    auto pingGeneration = pinger.getGeneration();
+    if (pingGeneration != lastPingGeneration) {
+        lastPingGeneration = pingGeneration;
+        entriesDirty = true;
+    }
+
     if (entriesDirty) {
         rebuildEntries();
     }
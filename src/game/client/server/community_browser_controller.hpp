@@ -15,6 +15,7 @@
 #include "client/server/community_auth_client.hpp"
 #include "client/server/server_discovery.hpp"
 #include "client/server/server_list_fetcher.hpp"
+#include "client/server/server_pinger.hpp"
 #include "game/engine/client_engine.hpp"
 #include "ui/console/console_interface.hpp"
 
@@ -66,6 +67,7 @@ private:
     std::string clientConfigPath;
     ServerConnector &connector;
     ServerDiscovery discovery;
+    ServerPinger pinger;
     std::unique_ptr<ServerListFetcher> serverListFetcher;
     std::vector<ServerListFetcher::ServerRecord> cachedRemoteServers;
     std::vector<ServerListFetcher::SourceStatus> cachedSourceStatuses;
@@ -111,4 +113,5 @@ private:
 
     std::size_t lastDiscoveryVersion = 0;
     std::size_t lastServerListGeneration = 0;
+    std::size_t lastPingGeneration = 0;
 };
@@ -22,38 +22,95 @@ bool ServerConnector::connect(const std::string &targetHost,
                               bool registeredUser,
                               bool communityAdmin,
                               bool localAdmin) {
+    cancel();
+
     std::string status = "Connecting to " + targetHost + ":" + std::to_string(targetPort) + "...";
     auto &browser = engine.ui->console();
     browser.setStatus(status, false);
     spdlog::info("Attempting to connect to {}:{}", targetHost, targetPort);
 
-    const std::string resolvedName = playerName.empty() ? defaultPlayerName : playerName;
+    PendingConnect attempt;
+    attempt.host = targetHost;
+    attempt.port = targetPort;
+    attempt.playerName = playerName.empty() ? defaultPlayerName : playerName;
+    attempt.registeredUser = registeredUser;
+    attempt.communityAdmin = communityAdmin;
+    attempt.localAdmin = localAdmin;
+
     const uint16_t connectTimeoutMs = karma::config::ReadUInt16Config({"network.ConnectTimeoutMs"}, 2000);
-    if (engine.network->connect(targetHost, targetPort, static_cast<int>(connectTimeoutMs))) {
-        spdlog::info("Connected to server at {}:{}", targetHost, targetPort);
-        spdlog::info("Join mode: {} user", registeredUser ? "registered" : "anonymous");
-        spdlog::info("Join flags: community_admin={}, local_admin={}", communityAdmin, localAdmin);
-        browser.setConnectionState({true, targetHost, targetPort});
-        game = std::make_unique<Game>(engine, resolvedName, worldDir, registeredUser, communityAdmin, localAdmin);
-        spdlog::trace("Game initialized successfully");
-
-        ClientMsg_PlayerJoin joinMsg{};
-        joinMsg.clientId = 0; // server will overwrite based on connection
-        joinMsg.name = resolvedName;
-        joinMsg.protocolVersion = NET_PROTOCOL_VERSION;
-        joinMsg.ip = ""; // client does not know its external IP
-        joinMsg.registeredUser = registeredUser;
-        joinMsg.communityAdmin = communityAdmin;
-        joinMsg.localAdmin = localAdmin;
-        engine.network->send<ClientMsg_PlayerJoin>(joinMsg);
-
-        browser.hide();
-        return true;
+    if (!engine.network->beginConnect({ClientNetwork::ServerEndpointInfo{targetHost, targetPort}},
+                                      static_cast<int>(connectTimeoutMs))) {
+        failConnect(attempt);
+        return false;
+    }
+    pending = std::move(attempt);
+    return true;
+}
+
+void ServerConnector::update() {
+    if (!pending) {
+        return;
     }
 
-    spdlog::error("Failed to connect to server at {}:{}", targetHost, targetPort);
-    std::string errorMsg = "Unable to reach " + targetHost + ":" + std::to_string(targetPort) + ".";
+    switch (engine.network->getConnectState()) {
+    case ClientNetwork::ConnectState::Connecting:
+        return;
+    case ClientNetwork::ConnectState::Connected: {
+        const PendingConnect attempt = std::move(*pending);
+        pending.reset();
+        finishConnect(attempt);
+        return;
+    }
+    default: {
+        const PendingConnect attempt = std::move(*pending);
+        pending.reset();
+        failConnect(attempt);
+        return;
+    }
+    }
+}
+
+void ServerConnector::cancel() {
+    if (!pending) {
+        return;
+    }
+    spdlog::info("Cancelled connecting to {}:{}", pending->host, pending->port);
+    engine.network->cancelConnect();
+    pending.reset();
+    engine.ui->console().setStatus("Connection cancelled.", false);
+}
+
+void ServerConnector::finishConnect(const PendingConnect &attempt) {
+    auto &browser = engine.ui->console();
+    spdlog::info("Connected to server at {}:{}", attempt.host, attempt.port);
+    spdlog::info("Join mode: {} user", attempt.registeredUser ? "registered" : "anonymous");
+    spdlog::info("Join flags: community_admin={}, local_admin={}", attempt.communityAdmin, attempt.localAdmin);
+    browser.setConnectionState({true, attempt.host, attempt.port});
+    game = std::make_unique<Game>(engine,
+                                  attempt.playerName,
+                                  worldDir,
+                                  attempt.registeredUser,
+                                  attempt.communityAdmin,
+                                  attempt.localAdmin);
+    spdlog::trace("Game initialized successfully");
+
+    ClientMsg_PlayerJoin joinMsg{};
+    joinMsg.clientId = 0; // server will overwrite based on connection
+    joinMsg.name = attempt.playerName;
+    joinMsg.protocolVersion = NET_PROTOCOL_VERSION;
+    joinMsg.ip = ""; // client does not know its external IP
+    joinMsg.registeredUser = attempt.registeredUser;
+    joinMsg.communityAdmin = attempt.communityAdmin;
+    joinMsg.localAdmin = attempt.localAdmin;
+    engine.network->send<ClientMsg_PlayerJoin>(joinMsg);
+
+    browser.hide();
+}
+
+void ServerConnector::failConnect(const PendingConnect &attempt) {
+    auto &browser = engine.ui->console();
+    spdlog::error("Failed to connect to server at {}:{}", attempt.host, attempt.port);
+    std::string errorMsg = "Unable to reach " + attempt.host + ":" + std::to_string(attempt.port) + ".";
     browser.setStatus(errorMsg, true);
     browser.setConnectionState({});
-    return false;
 }
@@ -2,11 +2,15 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 class ClientEngine;
 class Game;
 
+// Drives a connection attempt from the frame loop. connect() only starts it;
+// update() watches the handshake and creates the Game once it completes, so
+// the UI keeps running while the server is resolved and reached.
 class ServerConnector {
 public:
     ServerConnector(ClientEngine &engine,
@@ -14,16 +18,34 @@ public:
                     std::string worldDir,
                     std::unique_ptr<Game> &game);
 
+    // Replaces any attempt in progress. Returns false if it could not be started.
     bool connect(const std::string &host,
                  uint16_t port,
                  const std::string &playerName,
                  bool registeredUser,
                  bool communityAdmin,
                  bool localAdmin);
+    // Call once per frame after the network update.
+    void update();
+    void cancel();
+    bool isConnecting() const { return pending.has_value(); }
 
 private:
+    struct PendingConnect {
+        std::string host;
+        uint16_t port = 0;
+        std::string playerName;
+        bool registeredUser = false;
+        bool communityAdmin = false;
+        bool localAdmin = false;
+    };
+
+    void finishConnect(const PendingConnect &attempt);
+    void failConnect(const PendingConnect &attempt);
+
     ClientEngine &engine;
     std::unique_ptr<Game> &game;
     std::string defaultPlayerName;
     std::string worldDir;
+    std::optional<PendingConnect> pending;
 };
@@ -0,0 +1,383 @@
+#include "client/server/server_pinger.hpp"
+#include "game/net/discovery_protocol.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+#if defined(_WIN32)
+void setNonBlocking(SOCKET fd) {
+    u_long mode = 1;
+    ioctlsocket(fd, FIONBIO, &mode);
+}
+#else
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        flags = 0;
+    }
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+#endif
+
+#if defined(_WIN32)
+void closeSocketHandle(SOCKET fd) {
+    if (fd != INVALID_SOCKET) {
+        closesocket(fd);
+    }
+}
+#else
+void closeSocketHandle(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+#endif
+
+std::string makeAddressKey(const std::string &host, uint16_t port) {
+    return host + ":" + std::to_string(port);
+}
+
+bool resolveAddress(const std::string &host, uint16_t port, sockaddr_in &out) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *results = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &results) != 0 || !results) {
+        return false;
+    }
+    std::memcpy(&out, results->ai_addr, sizeof(out));
+    out.sin_port = htons(port);
+    freeaddrinfo(results);
+    return true;
+}
+
+// Upper bound on how long one pass of the worker waits for pongs.
+constexpr std::chrono::milliseconds RECEIVE_SLICE{10};
+} // namespace
+
+struct ServerPinger::Probe {
+    std::string key;
+    sockaddr_in address{};
+    uint32_t token = 0;
+    std::vector<clock::time_point> sentAt;
+    std::vector<float> rttMs;   // indexed by sequence, negative until answered
+    int received = 0;
+    clock::time_point nextSend{};
+};
+
+ServerPingSettings ServerPingSettings::Read() {
+    ServerPingSettings settings;
+    settings.pingsPerServer = std::max<int>(1,
+        karma::config::ReadUInt16Config({"network.ServerPing.PingsPerServer"}, 5));
+    settings.interval = std::chrono::milliseconds(
+        karma::config::ReadUInt16Config({"network.ServerPing.IntervalMs"}, 200));
+    settings.maxPingsPerSecond = std::max<int>(1,
+        karma::config::ReadUInt16Config({"network.ServerPing.MaxPingsPerSecond"}, 50));
+    settings.timeout = std::chrono::milliseconds(
+        karma::config::ReadUInt16Config({"network.ServerPing.TimeoutMs"}, 1000));
+    settings.cacheLifetime = std::chrono::seconds(
+        karma::config::ReadUInt16Config({"network.ServerPing.CacheSeconds"}, 60));
+    return settings;
+}
+
+ServerPinger::ServerPinger(ServerPingSettings settings) : settings(settings) {
+#if defined(_WIN32)
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        spdlog::warn("ServerPinger: Failed to initialize Winsock.");
+    }
+#endif
+    worker = std::thread(&ServerPinger::workerProc, this);
+}
+
+ServerPinger::~ServerPinger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+void ServerPinger::probe(const std::vector<Target> &targets) {
+    const auto now = clock::now();
+    bool queuedAny = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &target : targets) {
+            if (target.host.empty() || target.port == 0) {
+                continue;
+            }
+            std::string key = makeAddressKey(target.host, target.port);
+            if (inFlight.count(key) > 0) {
+                continue;
+            }
+            auto it = results.find(key);
+            if (it != results.end() && now - it->second.measuredAt < settings.cacheLifetime) {
+                continue;
+            }
+            inFlight.insert(std::move(key));
+            queued.push_back(target);
+            queuedAny = true;
+        }
+        if (queuedAny) {
+            probing.store(true);
+        }
+    }
+    if (queuedAny) {
+        wake.notify_one();
+    }
+}
+
+std::optional<ServerPinger::Result> ServerPinger::getResult(const std::string &host, uint16_t port) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = results.find(makeAddressKey(host, port));
+    if (it == results.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::size_t ServerPinger::getGeneration() const {
+    return generation.load();
+}
+
+bool ServerPinger::isProbing() const {
+    return probing.load();
+}
+
+bool ServerPinger::openSocket() {
+    if (socketFd >= 0) {
+        return true;
+    }
+
+    socketFd = static_cast<int>(socket(AF_INET, SOCK_DGRAM, 0));
+    if (socketFd < 0) {
+        spdlog::warn("ServerPinger: Unable to create socket for latency probes.");
+        return false;
+    }
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = 0;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(socketFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+        spdlog::warn("ServerPinger: Failed to bind probe socket.");
+        closeSocket();
+        return false;
+    }
+
+    setNonBlocking(socketFd);
+    return true;
+}
+
+void ServerPinger::closeSocket() {
+    closeSocketHandle(socketFd);
+    socketFd = -1;
+}
+
+void ServerPinger::workerProc() {
+    std::mt19937 rng(std::random_device{}());
+    std::vector<Probe> active;
+
+    // Token bucket for the global send rate. A tenth of a second of burst keeps
+    // a freshly listed batch of servers from being pinged all at once.
+    const double bucketCapacity = std::max(1.0, settings.maxPingsPerSecond / 10.0);
+    double tokens = bucketCapacity;
+    auto lastRefill = clock::now();
+
+    auto publish = [&](const std::string &key, const Result &result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[key] = result;
+        inFlight.erase(key);
+        generation++;
+    };
+
+    while (true) {
+        std::vector<Target> incoming;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (active.empty()) {
+                if (queued.empty()) {
+                    probing.store(false);
+                }
+                wake.wait(lock, [&]() { return stopping || !queued.empty(); });
+            }
+            if (stopping) {
+                break;
+            }
+            incoming.assign(queued.begin(), queued.end());
+            queued.clear();
+        }
+
+        for (const auto &target : incoming) {
+            Probe probe;
+            probe.key = makeAddressKey(target.host, target.port);
+            if (!resolveAddress(target.host, target.port, probe.address)) {
+                spdlog::debug("ServerPinger: Could not resolve {}", target.host);
+                Result unreachable;
+                unreachable.measuredAt = clock::now();
+                publish(probe.key, unreachable);
+                continue;
+            }
+            probe.token = rng();
+            probe.sentAt.reserve(settings.pingsPerServer);
+            probe.rttMs.reserve(settings.pingsPerServer);
+            active.push_back(std::move(probe));
+        }
+
+        if (active.empty()) {
+            continue;
+        }
+
+        if (!openSocket()) {
+            for (const auto &probe : active) {
+                Result failed;
+                failed.measuredAt = clock::now();
+                publish(probe.key, failed);
+            }
+            active.clear();
+            continue;
+        }
+
+        auto now = clock::now();
+        tokens = std::min(bucketCapacity,
+                          tokens + std::chrono::duration<double>(now - lastRefill).count() * settings.maxPingsPerSecond);
+        lastRefill = now;
+
+        for (auto &probe : active) {
+            if (tokens < 1.0) {
+                break;
+            }
+            if (static_cast<int>(probe.sentAt.size()) >= settings.pingsPerServer || now < probe.nextSend) {
+                continue;
+            }
+            DiscoveryProtocol::PingPacket ping;
+            ping.token = probe.token;
+            ping.sequence = static_cast<uint32_t>(probe.sentAt.size());
+            sendto(socketFd, reinterpret_cast<const char*>(&ping), sizeof(ping), 0,
+                reinterpret_cast<const sockaddr*>(&probe.address), sizeof(probe.address));
+            probe.sentAt.push_back(now);
+            probe.rttMs.push_back(-1.0f);
+            probe.nextSend = now + settings.interval;
+            tokens -= 1.0;
+        }
+
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(socketFd, &readSet);
+        timeval wait{};
+        wait.tv_sec = 0;
+        wait.tv_usec = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(RECEIVE_SLICE).count());
+        select(socketFd + 1, &readSet, nullptr, nullptr, &wait);
+
+        while (true) {
+            DiscoveryProtocol::PongPacket pong;
+            sockaddr_in from{};
+            socklen_t fromLen = sizeof(from);
+            int received = static_cast<int>(recvfrom(socketFd, reinterpret_cast<char*>(&pong), sizeof(pong), 0,
+                reinterpret_cast<sockaddr*>(&from), &fromLen));
+            if (received < 0) {
+#if defined(_WIN32)
+                int err = WSAGetLastError();
+                if (err != WSAEWOULDBLOCK && err != WSAECONNRESET) {
+                    spdlog::debug("ServerPinger: recvfrom failed ({})", err);
+                }
+                if (err == WSAECONNRESET) {
+                    // An ICMP unreachable from one server; keep draining.
+                    continue;
+                }
+#else
+                if (errno != EWOULDBLOCK && errno != EAGAIN) {
+                    spdlog::debug("ServerPinger: recvfrom failed ({})", errno);
+                }
+#endif
+                break;
+            }
+            if (received < static_cast<int>(sizeof(pong)) || !DiscoveryProtocol::isPong(pong)) {
+                continue;
+            }
+
+            const auto arrived = clock::now();
+            auto it = std::find_if(active.begin(), active.end(), [&](const Probe &probe) {
+                return probe.token == pong.token;
+            });
+            if (it == active.end() || pong.sequence >= it->sentAt.size() || it->rttMs[pong.sequence] >= 0.0f) {
+                continue;
+            }
+            it->rttMs[pong.sequence] =
+                std::chrono::duration<float, std::milli>(arrived - it->sentAt[pong.sequence]).count();
+            ++it->received;
+        }
+
+        now = clock::now();
+        for (auto it = active.begin(); it != active.end(); ) {
+            const int sent = static_cast<int>(it->sentAt.size());
+            const bool allSent = sent >= settings.pingsPerServer;
+            const bool finished = allSent &&
+                (it->received == sent || now - it->sentAt.back() >= settings.timeout);
+            if (!finished) {
+                ++it;
+                continue;
+            }
+
+            Result result;
+            result.sent = sent;
+            result.received = it->received;
+            result.lossPercent = 100.0f * static_cast<float>(sent - it->received) / static_cast<float>(sent);
+            result.measuredAt = now;
+            if (it->received > 0) {
+                // Mean RTT, and jitter as the mean change between consecutive answered pings.
+                float total = 0.0f;
+                float deltas = 0.0f;
+                int deltaCount = 0;
+                float previous = -1.0f;
+                for (float rtt : it->rttMs) {
+                    if (rtt < 0.0f) {
+                        continue;
+                    }
+                    total += rtt;
+                    if (previous >= 0.0f) {
+                        deltas += std::fabs(rtt - previous);
+                        ++deltaCount;
+                    }
+                    previous = rtt;
+                }
+                result.rttMs = total / static_cast<float>(it->received);
+                result.jitterMs = deltaCount > 0 ? deltas / static_cast<float>(deltaCount) : 0.0f;
+            }
+            publish(it->key, result);
+            it = active.erase(it);
+        }
+
+        if (active.empty()) {
+            closeSocket();
+        }
+    }
+
+    closeSocket();
+}
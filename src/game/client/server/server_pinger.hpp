@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct ServerPingSettings {
+    // Pings sent to each server per probe; RTT, jitter and loss come from these.
+    int pingsPerServer = 5;
+    // Spacing between pings to the same server.
+    std::chrono::milliseconds interval{200};
+    // Cap on pings per second across all servers, so a long list does not burst.
+    int maxPingsPerSecond = 50;
+    // How long to wait for the last pong before counting the rest as lost.
+    std::chrono::milliseconds timeout{1000};
+    // Results younger than this are reused instead of probing again.
+    std::chrono::seconds cacheLifetime{60};
+
+    static ServerPingSettings Read();
+};
+
+// Measures round trip time to listed servers with the UDP ping in
+// DiscoveryProtocol. Probes run concurrently on a worker thread; results are
+// cached by host:port so refreshing the browser does not ping everything again.
+class ServerPinger {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Target {
+        std::string host;
+        uint16_t port = 0;
+    };
+
+    struct Result {
+        // Negative when no pong came back.
+        float rttMs = -1.0f;
+        float jitterMs = -1.0f;
+        float lossPercent = 100.0f;
+        int sent = 0;
+        int received = 0;
+        clock::time_point measuredAt{};
+    };
+
+    explicit ServerPinger(ServerPingSettings settings = ServerPingSettings::Read());
+    ~ServerPinger();
+
+    // Queues a probe for every target without a fresh cached result.
+    void probe(const std::vector<Target> &targets);
+    std::optional<Result> getResult(const std::string &host, uint16_t port) const;
+    std::size_t getGeneration() const;
+    bool isProbing() const;
+
+private:
+    struct Probe;
+
+    void workerProc();
+    bool openSocket();
+    void closeSocket();
+
+    ServerPingSettings settings;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Target> queued;
+    std::unordered_set<std::string> inFlight;
+    std::unordered_map<std::string, Result> results;
+    std::atomic<std::size_t> generation{0};
+    std::atomic<bool> probing{false};
+    bool stopping = false;
+    std::thread worker;
+    int socketFd = -1;
+};
@@ -0,0 +1,187 @@
+#include "client/shot_system.hpp"
+#include "client/game.hpp"
+#include "spdlog/spdlog.h"
+#include <utility>
+
+namespace {
+
+// Proxies and slots created up front; a burst beyond this grows the pool once.
+constexpr std::size_t INITIAL_CAPACITY = 64;
+
+// Nudge off a surface after a ricochet so the next cast does not hit it again.
+constexpr float RICOCHET_OFFSET = 1e-3f;
+
+} // namespace
+
+ShotSystem::ShotSystem(Game &game)
+    : game(game),
+      modelPath(game.world->resolveAssetPath("shotModel").string()),
+      fireAudio(game.engine.audio->loadClip(game.world->resolveAssetPath("audio.shot.Fire").string(), 20)),
+      ricochetAudio(game.engine.audio->loadClip(game.world->resolveAssetPath("audio.shot.Ricochet").string(), 20)) {
+    reserve(INITIAL_CAPACITY);
+}
+
+ShotSystem::~ShotSystem() {
+    for (render_id proxy : allProxies) {
+        game.engine.render->destroy(proxy);
+    }
+}
+
+void ShotSystem::reserve(std::size_t capacity) {
+    ids.reserve(capacity);
+    globalIds.reserve(capacity);
+    positions.reserve(capacity);
+    prevPositions.reserve(capacity);
+    velocities.reserve(capacity);
+    proxies.reserve(capacity);
+    localIndex.reserve(capacity);
+    globalIndex.reserve(capacity);
+    spareNodes.reserve(capacity);
+    queries.rays.reserve(capacity);
+    hits.rays.reserve(capacity);
+
+    freeProxies.reserve(capacity);
+    allProxies.reserve(capacity);
+    while (allProxies.size() < capacity) {
+        freeProxies.push_back(createProxy());
+    }
+}
+
+render_id ShotSystem::createProxy() {
+    const render_id proxy = game.engine.render->create(modelPath, false);
+    game.engine.render->setScale(proxy, glm::vec3(0.6f));
+    game.engine.render->setTransparency(proxy, true);
+    game.engine.render->setRadarCircleGraphic(proxy, 0.5f);
+    game.engine.render->setVisible(proxy, false);
+    allProxies.push_back(proxy);
+    return proxy;
+}
+
+render_id ShotSystem::acquireProxy() {
+    if (freeProxies.empty()) {
+        const std::size_t capacity = allProxies.size() * 2;
+        spdlog::debug("ShotSystem: Growing shot pool to {}", capacity);
+        reserve(capacity);
+    }
+    const render_id proxy = freeProxies.back();
+    freeProxies.pop_back();
+    return proxy;
+}
+
+void ShotSystem::fireLocal(const glm::vec3 &position, const glm::vec3 &velocity) {
+    const shot_id localId = nextLocalShotId++;
+    add(localId, false, position, velocity);
+
+    ClientMsg_CreateShot createShotMsg;
+    createShotMsg.localShotId = localId;
+    createShotMsg.position = position;
+    createShotMsg.velocity = velocity;
+    game.engine.network->send<ClientMsg_CreateShot>(createShotMsg);
+}
+
+void ShotSystem::spawnGlobal(shot_id globalId, const glm::vec3 &position, const glm::vec3 &velocity) {
+    add(globalId, true, position, velocity);
+}
+
+void ShotSystem::add(shot_id id, bool isGlobalId, const glm::vec3 &position, const glm::vec3 &velocity) {
+    Index &index = indexFor(isGlobalId);
+    if (index.count(id) > 0) {
+        spdlog::warn("ShotSystem::add: Duplicate {} shot id {}", isGlobalId ? "global" : "local", id);
+        return;
+    }
+
+    const render_id proxy = acquireProxy();
+    const std::size_t slot = ids.size();
+    ids.push_back(id);
+    globalIds.push_back(isGlobalId ? 1 : 0);
+    positions.push_back(position);
+    prevPositions.push_back(position);
+    velocities.push_back(velocity);
+    proxies.push_back(proxy);
+
+    if (!spareNodes.empty()) {
+        Index::node_type node = std::move(spareNodes.back());
+        spareNodes.pop_back();
+        node.key() = id;
+        node.mapped() = slot;
+        index.insert(std::move(node));
+    } else {
+        index.emplace(id, slot);
+    }
+
+    game.engine.render->setPosition(proxy, position);
+    game.engine.render->setVisible(proxy, true);
+    fireAudio.play(position);
+}
+
+void ShotSystem::remove(shot_id id, bool isGlobalId) {
+    Index &index = indexFor(isGlobalId);
+    auto it = index.find(id);
+    if (it == index.end()) {
+        return;
+    }
+    const std::size_t slot = it->second;
+    spareNodes.push_back(index.extract(it));
+
+    game.engine.render->setVisible(proxies[slot], false);
+    freeProxies.push_back(proxies[slot]);
+
+    // Shot order does not matter, so fill the gap with the last shot.
+    const std::size_t last = ids.size() - 1;
+    if (slot != last) {
+        ids[slot] = ids[last];
+        globalIds[slot] = globalIds[last];
+        positions[slot] = positions[last];
+        prevPositions[slot] = prevPositions[last];
+        velocities[slot] = velocities[last];
+        proxies[slot] = proxies[last];
+        indexFor(globalIds[slot] != 0)[ids[slot]] = slot;
+    }
+    ids.pop_back();
+    globalIds.pop_back();
+    positions.pop_back();
+    prevPositions.pop_back();
+    velocities.pop_back();
+    proxies.pop_back();
+}
+
+void ShotSystem::update(TimeUtils::duration deltaTime) {
+    if (ids.empty()) {
+        return;
+    }
+
+    // Cast across the full step segment to avoid tunneling.
+    queries.clear();
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        queries.rays.push_back(PhysicsRayQuery{positions[i], positions[i] + velocities[i] * deltaTime, {}});
+    }
+    game.engine.physics->query(queries, hits);
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        prevPositions[i] = positions[i];
+
+        const PhysicsQueryHit &hit = hits.rays[i];
+        if (!hit.hit) {
+            positions[i] = queries.rays[i].to;
+            continue;
+        }
+
+        const float speed = glm::length(velocities[i]);
+        const glm::vec3 n = glm::normalize(hit.normal);
+        const glm::vec3 dir = speed > 0.f ? velocities[i] / speed : velocities[i];
+
+        // Snap to contact and nudge off the surface.
+        positions[i] = hit.point + n * RICOCHET_OFFSET;
+        velocities[i] = glm::reflect(dir, n) * speed;
+
+        ricochetAudio.play(hit.point);
+        spdlog::trace("ShotSystem::update: Shot {} ricocheted at ({:.3f}, {:.3f}, {:.3f})",
+                      ids[i], hit.point.x, hit.point.y, hit.point.z);
+    }
+}
+
+void ShotSystem::present(float alpha) {
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        game.engine.render->setPosition(proxies[i], glm::mix(prevPositions[i], positions[i], alpha));
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include "game/net/messages.hpp"
+#include "karma/audio/audio.hpp"
+#include "karma/physics/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Game;
+
+// All client-side projectiles, kept as parallel arrays. Render proxies come
+// from a pool created with the system and are hidden rather than destroyed,
+// the fire and ricochet clips are loaded once per world, and every step casts
+// all shots in one physics query. Once warmed up, spawning and removing a
+// shot does not allocate.
+class ShotSystem {
+public:
+    explicit ShotSystem(Game &game);
+    ~ShotSystem();
+
+    // Fires a shot from the local player and tells the server about it.
+    void fireLocal(const glm::vec3 &position, const glm::vec3 &velocity);
+    // Adds a shot announced by the server.
+    void spawnGlobal(shot_id globalId, const glm::vec3 &position, const glm::vec3 &velocity);
+    void remove(shot_id id, bool isGlobalId);
+
+    // Fixed simulation step.
+    void update(TimeUtils::duration deltaTime);
+    // Places every shot between its previous and current step position.
+    void present(float alpha);
+
+    std::size_t size() const { return ids.size(); }
+
+private:
+    using Index = std::unordered_map<shot_id, std::size_t>;
+
+    Game &game;
+
+    // One entry per live shot, all indexed by the same slot.
+    std::vector<shot_id> ids;
+    std::vector<uint8_t> globalIds;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> prevPositions;
+    std::vector<glm::vec3> velocities;
+    std::vector<render_id> proxies;
+
+    // Slot by id; local and global ids are separate spaces. Removed nodes are
+    // kept and reused so inserts do not allocate.
+    Index localIndex;
+    Index globalIndex;
+    std::vector<Index::node_type> spareNodes;
+
+    std::string modelPath;
+    std::vector<render_id> freeProxies;
+    std::vector<render_id> allProxies;
+
+    AudioClip fireAudio;
+    AudioClip ricochetAudio;
+
+    PhysicsQueryBatch queries;
+    PhysicsQueryResults hits;
+
+    shot_id nextLocalShotId = 1;
+
+    Index &indexFor(bool isGlobalId) { return isGlobalId ? globalIndex : localIndex; }
+    void add(shot_id id, bool isGlobalId, const glm::vec3 &position, const glm::vec3 &velocity);
+    void reserve(std::size_t capacity);
+    render_id createProxy();
+    render_id acquireProxy();
+};
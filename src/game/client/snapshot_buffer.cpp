@@ -0,0 +1,140 @@
+#include "client/snapshot_buffer.hpp"
+#include "karma/common/config_helpers.hpp"
+#include <algorithm>
+
+namespace {
+
+float Seconds(SnapshotBuffer::clock::duration duration) {
+    return std::chrono::duration<float>(duration).count();
+}
+
+// Cubic hermite between p0 and p1 with endpoint velocities v0, v1 over span seconds.
+glm::vec3 Hermite(const glm::vec3 &p0, const glm::vec3 &v0,
+                  const glm::vec3 &p1, const glm::vec3 &v1,
+                  float span, float t) {
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    const float h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+    const float h10 = t3 - 2.0f * t2 + t;
+    const float h01 = -2.0f * t3 + 3.0f * t2;
+    const float h11 = t3 - t2;
+    return h00 * p0 + h10 * span * v0 + h01 * p1 + h11 * span * v1;
+}
+
+} // namespace
+
+SnapshotBufferSettings SnapshotBufferSettings::Read() {
+    SnapshotBufferSettings settings;
+    settings.interpolationDelay =
+        std::max(0.0f, karma::config::ReadFloatConfig({"game.interpolation.DelayMs"}, 100.0f)) / 1000.0f;
+    settings.maxExtrapolation =
+        std::max(0.0f, karma::config::ReadFloatConfig({"game.interpolation.MaxExtrapolationMs"}, 250.0f)) / 1000.0f;
+    return settings;
+}
+
+SnapshotBufferStats &SnapshotBufferStats::operator+=(const SnapshotBufferStats &other) {
+    samples += other.samples;
+    interpolated += other.interpolated;
+    extrapolated += other.extrapolated;
+    held += other.held;
+    underruns += other.underruns;
+    outOfOrder += other.outOfOrder;
+    return *this;
+}
+
+SnapshotBuffer::SnapshotBuffer(SnapshotBufferSettings settings) : settings(settings) {}
+
+void SnapshotBuffer::push(clock::time_point time,
+                          const glm::vec3 &position,
+                          const glm::quat &rotation,
+                          const glm::vec3 &velocity) {
+    if (count > 0 && time < at(count - 1).time) {
+        ++stats.outOfOrder;
+        return;
+    }
+
+    if (count == CAPACITY) {
+        head = (head + 1) % CAPACITY;
+        --count;
+    }
+    ring[(head + count) % CAPACITY] = Snapshot{time, position, rotation, velocity};
+    ++count;
+}
+
+void SnapshotBuffer::reset(clock::time_point time,
+                           const glm::vec3 &position,
+                           const glm::quat &rotation,
+                           const glm::vec3 &velocity) {
+    head = 0;
+    count = 0;
+    // Backdate so the spawn pose is shown immediately rather than after the delay.
+    const auto delay = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(settings.interpolationDelay));
+    push(time - delay, position, rotation, velocity);
+}
+
+bool SnapshotBuffer::sample(clock::time_point now, Snapshot &out) {
+    if (count == 0) {
+        ++stats.underruns;
+        return false;
+    }
+    ++stats.samples;
+
+    const auto delay = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(settings.interpolationDelay));
+    const clock::time_point renderTime = now - delay;
+
+    // Drop snapshots that are entirely behind the render time, keeping one before it.
+    while (count >= 2 && at(1).time <= renderTime) {
+        head = (head + 1) % CAPACITY;
+        --count;
+    }
+
+    const Snapshot &from = at(0);
+    if (renderTime <= from.time) {
+        out = from;
+        out.time = renderTime;
+        ++stats.held;
+        return true;
+    }
+
+    if (count >= 2) {
+        const Snapshot &to = at(1);
+        const float span = Seconds(to.time - from.time);
+        const float t = span > 0.0f ? std::clamp(Seconds(renderTime - from.time) / span, 0.0f, 1.0f) : 1.0f;
+        out.time = renderTime;
+        out.position = Hermite(from.position, from.velocity, to.position, to.velocity, span, t);
+        out.rotation = glm::slerp(from.rotation, to.rotation, t);
+        out.velocity = glm::mix(from.velocity, to.velocity, t);
+        ++stats.interpolated;
+        return true;
+    }
+
+    // Ran out of snapshots: dead-reckon along the last velocity, then hold.
+    const float ahead = Seconds(renderTime - from.time);
+    out = from;
+    out.time = renderTime;
+    if (ahead <= settings.maxExtrapolation) {
+        ++stats.extrapolated;
+        out.position = from.position + from.velocity * ahead;
+    } else {
+        ++stats.underruns;
+        out.position = from.position + from.velocity * settings.maxExtrapolation;
+    }
+    return true;
+}
+
+ServerClockEstimate::clock::time_point ServerClockEstimate::observe(double serverTime, clock::time_point arrival) {
+    const double arrivalSeconds = std::chrono::duration<double>(arrival.time_since_epoch()).count();
+    const double sample = arrivalSeconds - serverTime;
+    if (!valid) {
+        offset = sample;
+        valid = true;
+    } else {
+        const double elapsed = std::max(0.0, std::chrono::duration<double>(arrival - lastArrival).count());
+        offset = std::min(sample, offset + OFFSET_CREEP * elapsed);
+    }
+    lastArrival = arrival;
+    return clock::time_point(std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(serverTime + offset)));
+}
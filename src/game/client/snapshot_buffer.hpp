@@ -0,0 +1,90 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct SnapshotBufferSettings {
+    // How far behind the newest snapshot remote actors are rendered.
+    float interpolationDelay = 0.1f;
+    // How long to keep extrapolating along the last velocity once snapshots stop arriving.
+    float maxExtrapolation = 0.25f;
+
+    static SnapshotBufferSettings Read();
+};
+
+struct SnapshotBufferStats {
+    uint64_t samples = 0;
+    uint64_t interpolated = 0;
+    uint64_t extrapolated = 0;
+    // Render time before the oldest snapshot (e.g. right after a reset): the actor held its pose.
+    uint64_t held = 0;
+    // Samples past the extrapolation limit (or with nothing buffered): the actor froze.
+    uint64_t underruns = 0;
+    // Snapshots that arrived older than one already buffered and were dropped.
+    uint64_t outOfOrder = 0;
+
+    SnapshotBufferStats &operator+=(const SnapshotBufferStats &other);
+};
+
+// Jitter buffer of timestamped location snapshots for one remote actor.
+// Snapshots are stamped with the server's send time mapped onto the local
+// clock (ServerClockEstimate); sample() renders the actor interpolationDelay
+// in the past, so a late or lost packet is covered by the ones around it
+// instead of showing up as a snap.
+class SnapshotBuffer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Snapshot {
+        clock::time_point time;
+        glm::vec3 position{0.0f};
+        glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 velocity{0.0f};
+    };
+
+    explicit SnapshotBuffer(SnapshotBufferSettings settings = SnapshotBufferSettings::Read());
+
+    void push(clock::time_point time, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    // Forgets history, e.g. on spawn, so the actor does not slide from its old position.
+    void reset(clock::time_point time, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    bool empty() const { return count == 0; }
+
+    // Returns false when nothing has been buffered yet.
+    bool sample(clock::time_point now, Snapshot &out);
+
+    const SnapshotBufferStats &getStats() const { return stats; }
+
+private:
+    static constexpr std::size_t CAPACITY = 32;
+
+    const Snapshot &at(std::size_t index) const { return ring[(head + index) % CAPACITY]; }
+
+    SnapshotBufferSettings settings;
+    std::array<Snapshot, CAPACITY> ring{};
+    std::size_t head = 0;
+    std::size_t count = 0;
+    SnapshotBufferStats stats;
+};
+
+// Maps server timeline seconds onto the local clock, shared by every actor of
+// one connection. The offset is the smallest (arrival - server time) seen,
+// i.e. the least delayed packet, so network jitter does not move snapshots.
+// It creeps up slowly so clock drift and a slower route are still followed.
+class ServerClockEstimate {
+public:
+    using clock = SnapshotBuffer::clock;
+
+    // Folds in one packet and returns its server time on the local clock.
+    clock::time_point observe(double serverTime, clock::time_point arrival);
+    void reset() { valid = false; }
+
+private:
+    // Seconds per second the offset may rise by when no packet confirms it.
+    static constexpr double OFFSET_CREEP = 0.01;
+
+    bool valid = false;
+    double offset = 0.0;
+    clock::time_point lastArrival{};
+};
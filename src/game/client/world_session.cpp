@@ -5,6 +5,7 @@
 #include "karma/common/data_path_resolver.hpp"
 #include "karma/common/config_helpers.hpp"
 #include "karma/common/config_store.hpp"
+#include <algorithm>
 
 ClientWorldSession::ClientWorldSession(Game &game, std::string worldDir)
         : game(game), backend_(world_backend::CreateWorldBackend()) {
@@ -23,7 +24,8 @@ ClientWorldSession::ClientWorldSession(Game &game, std::string worldDir)
                                      std::filesystem::path(worldDir),
                                      std::string{},
                                      "ClientWorldSession");
-    defaultPlayerParameters_ = game_world::ExtractDefaultPlayerParameters(content_.config);
+    parameterSchema_ = PlayerParameterSchema::FromDefaults(
+        game_world::ExtractDefaultPlayerParameters(content_.config), defaultPlayerParameters_);
 }
 
 ClientWorldSession::~ClientWorldSession() {
@@ -53,10 +55,10 @@ void ClientWorldSession::update() {
             game.engine.network->disconnect("Protocol version mismatch.");
             return;
         }
-        defaultPlayerParameters_.clear();
-        for (const auto& [key, val] : initMsg.defaultPlayerParams) {
-            defaultPlayerParameters_[key] = val;
-        }
+        // Ids on the wire index the server's schema, so adopt it wholesale.
+        parameterSchema_ = PlayerParameterSchema(initMsg.playerParameterNames);
+        defaultPlayerParameters_ = initMsg.defaultPlayerParams;
+        defaultPlayerParameters_.resize(parameterSchema_.size());
         playerId = initMsg.clientId;
 
         if (!initMsg.worldData.empty()) {
@@ -84,8 +86,9 @@ void ClientWorldSession::update() {
                     } else {
                         karma::data::MergeJsonObjects(content_.config, *worldConfigOpt);
                         content_.mergeLayer(*worldConfigOpt, downloadsDir);
-                        if (defaultPlayerParameters_.empty()) {
-                            defaultPlayerParameters_ = game_world::ExtractDefaultPlayerParameters(content_.config);
+                        if (parameterSchema_.empty()) {
+                            parameterSchema_ = PlayerParameterSchema::FromDefaults(
+                                game_world::ExtractDefaultPlayerParameters(content_.config), defaultPlayerParameters_);
                         }
                     }
                 }
@@ -107,6 +110,10 @@ void ClientWorldSession::update() {
     }
 }
 
+bool ClientWorldSession::hasFeature(const std::string &feature) const {
+    return std::find(features.begin(), features.end(), feature) != features.end();
+}
+
 std::filesystem::path ClientWorldSession::resolveAssetPath(const std::string &assetName) const {
     return content_.resolveAssetPath(assetName, "ClientWorldSession");
 }
@@ -22,6 +22,7 @@ private:
     render_id renderId{};
     PhysicsStaticBody physics;
     world::WorldContent content_;
+    PlayerParameterSchema parameterSchema_;
     PlayerParameters defaultPlayerParameters_;
     bool initialized = false;
 
@@ -39,7 +40,10 @@ public:
     bool isInitialized() const;
     void update();
     std::filesystem::path resolveAssetPath(const std::string &assetName) const;
+    // Whether the server advertised the feature in its init message.
+    bool hasFeature(const std::string &feature) const;
 
+    const PlayerParameterSchema &parameterSchema() const { return parameterSchema_; }
     PlayerParameters defaultPlayerParameters() const {
         return defaultPlayerParameters_;
     }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "karma/physics/player_controller.hpp"
+
+#include <glm/glm.hpp>
+
+namespace game_common {
+
+// One frame of driving input, as the client sends it with server movement.
+struct TankInput {
+    glm::vec2 movement{0.0f}; // x: turn, y: forward/backward, each in [-1, 1].
+    bool jump = false;
+};
+
+// Shortest time between two jumps. The client only sends jump input once it
+// has passed; the server enforces it again for server movement.
+constexpr float TANK_JUMP_COOLDOWN = 0.1f;
+
+struct TankMovementParams {
+    float speed = 0.0f;
+    float turnSpeed = 0.0f;
+    float jumpSpeed = 0.0f;
+};
+
+// Sets the controller's velocities for the next physics step. The client
+// runs this for prediction and replay and the server for authority, so the
+// two stay in step. Airborne tanks keep their momentum.
+inline void ApplyTankInput(PhysicsPlayerController &controller,
+                           const TankInput &input,
+                           const TankMovementParams &params) {
+    if (!controller.isGrounded()) {
+        return;
+    }
+
+    const glm::vec2 movement = glm::clamp(input.movement, glm::vec2(-1.0f), glm::vec2(1.0f));
+    glm::vec3 velocity = controller.getForwardVector() * (movement.y * params.speed);
+    velocity.y = input.jump ? params.jumpSpeed : controller.getVelocity().y;
+    controller.setVelocity(velocity);
+    controller.setAngularVelocity(glm::vec3(0.0f, -movement.x * params.turnSpeed, 0.0f));
+}
+
+} // namespace game_common
@@ -7,6 +7,8 @@
 #include "karma/ui/bridges/renderer_bridge.hpp"
 #include "karma/common/config_store.hpp"
 #include "karma/common/config_helpers.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include "karma/common/i18n.hpp"
 #include <cstdint>
@@ -81,6 +83,11 @@ ClientEngine::ClientEngine(platform::Window &window) {
     audio = new Audio();
     spdlog::trace("ClientEngine: Audio initialized successfully");
     ecsWorld = nullptr;
+
+    const float tickRate = karma::config::ReadFloatConfig({"game.simulation.TickRate"}, 120.0f);
+    fixedStepDelta = 1.0f / std::clamp(tickRate, 10.0f, 1000.0f);
+    maxStepsPerFrame = std::max<int>(1, karma::config::ReadUInt16Config({"game.simulation.MaxStepsPerFrame"}, 8));
+    lateLatchInput = karma::config::ReadBoolConfig({"performance.LateLatchInput"}, true);
 }
 
 ClientEngine::~ClientEngine() {
@@ -99,12 +106,20 @@ void ClientEngine::earlyUpdate(TimeUtils::duration deltaTime) {
     const std::vector<platform::Event> emptyEvents;
     const auto &events = window ? window->events() : emptyEvents;
     lastEvents = events;
+    inputLatency.noteEvents(events, false);
     if (ui) {
         ui->handleEvents(events);
     }
     if (input) {
-        input->update(events);
+        if (latchedEvents.empty()) {
+            input->update(events);
+        } else {
+            inputEvents = latchedEvents;
+            inputEvents.insert(inputEvents.end(), events.begin(), events.end());
+            input->update(inputEvents);
+        }
     }
+    latchedEvents.clear();
     inputState = game_input::BuildInputState(*input);
     if (window) {
         window->clearEvents();
@@ -112,8 +127,64 @@ void ClientEngine::earlyUpdate(TimeUtils::duration deltaTime) {
     network->update();
 }
 
+int ClientEngine::advanceSimulation(TimeUtils::duration frameDelta) {
+    simulationAdvancedAt = std::chrono::steady_clock::now();
+    presentationLead = 0.0f;
+    simulationAccumulator += std::max(frameDelta, 0.0f);
+    int steps = static_cast<int>(simulationAccumulator / fixedStepDelta);
+    if (steps > maxStepsPerFrame) {
+        spdlog::debug("ClientEngine::advanceSimulation: Dropping {:.1f}ms of simulation time",
+                      (simulationAccumulator - maxStepsPerFrame * fixedStepDelta) * 1000.0f);
+        steps = maxStepsPerFrame;
+        simulationAccumulator = fixedStepDelta * static_cast<float>(steps);
+    }
+    simulationAccumulator -= fixedStepDelta * static_cast<float>(steps);
+    simulationAccumulator = std::clamp(simulationAccumulator, 0.0f, fixedStepDelta);
+    return steps;
+}
+
 void ClientEngine::step(TimeUtils::duration deltaTime) {
     physics->update(deltaTime);
+    ++stepCount;
+    lastStepDelta = deltaTime;
+}
+
+void ClientEngine::latchLateInput() {
+    if (!lateLatchInput || !window) {
+        return;
+    }
+
+    // Present the simulation as of now rather than as of the frame's start.
+    if (simulationAdvancedAt != std::chrono::steady_clock::time_point{}) {
+        presentationLead = std::chrono::duration<float>(std::chrono::steady_clock::now() - simulationAdvancedAt).count();
+    }
+
+    window->pollEvents();
+    const auto &events = window->events();
+    if (!events.empty()) {
+        // Only the roaming camera's mouse look reads these in this frame; the
+        // rest reach the simulation in the next earlyUpdate.
+        std::vector<platform::Event> lookEvents;
+        std::vector<platform::Event> deferredEvents;
+        deferredEvents.reserve(events.size());
+        for (const auto &event : events) {
+            if (roamingMode && event.type == platform::EventType::MouseMove) {
+                lookEvents.push_back(event);
+            } else {
+                deferredEvents.push_back(event);
+            }
+        }
+        inputLatency.noteEvents(lookEvents, true);
+        inputLatency.noteDeferredEvents(deferredEvents);
+        if (ui) {
+            ui->handleEvents(events);
+        }
+        // Mouse look for this frame's camera sees the new motion; held keys are
+        // read live from the window, so they are already current.
+        lastEvents.insert(lastEvents.end(), events.begin(), events.end());
+        latchedEvents.insert(latchedEvents.end(), events.begin(), events.end());
+    }
+    window->clearEvents();
 }
 
 void ClientEngine::lateUpdate(TimeUtils::duration deltaTime) {
@@ -134,6 +205,7 @@ void ClientEngine::lateUpdate(TimeUtils::duration deltaTime) {
     }
     lastBrightness = ui->getRenderBrightness();
     render->present();
+    inputLatency.framePresented(std::chrono::steady_clock::now());
 
     if (ui->consumeKeybindingsReloadRequest()) {
         input->reloadKeyBindings();
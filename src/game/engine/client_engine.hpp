@@ -8,9 +8,13 @@
 #include "game/input/state.hpp"
 #include "ui/core/system.hpp"
 #include "client/roaming_camera.hpp"
+#include "client/frame_pacer.hpp"
+#include "client/input_latency.hpp"
 #include "karma/ecs/world.hpp"
 #include "karma/audio/audio.hpp"
 #include "karma/platform/window.hpp"
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <memory>
 #include <vector>
@@ -28,6 +32,20 @@ private:
     bool roamingMode = false;
     bool roamingModeInitialized = false;
     std::vector<platform::Event> lastEvents;
+    // Re-poll input just before presenting (performance.LateLatchInput). Events
+    // picked up late are handed to Input again next frame so triggers are not lost.
+    bool lateLatchInput = true;
+    std::vector<platform::Event> latchedEvents;
+    std::vector<platform::Event> inputEvents;
+    uint64_t stepCount = 0;
+    TimeUtils::duration lastStepDelta = 0.0f;
+    // Fixed-rate simulation clock (game.simulation).
+    TimeUtils::duration fixedStepDelta = 1.0f / 120.0f;
+    int maxStepsPerFrame = 8;
+    TimeUtils::duration simulationAccumulator = 0.0f;
+    std::chrono::steady_clock::time_point simulationAdvancedAt{};
+    // Time between advanceSimulation and the late latch, added to the interpolation alpha.
+    TimeUtils::duration presentationLead = 0.0f;
     game_client::RoamingCameraController roamingCamera;
 
 public:
@@ -39,6 +57,8 @@ public:
     UiSystem *ui;
     Audio *audio;
     ecs::World *ecsWorld = nullptr;
+    game_client::FramePacer framePacer;
+    game_client::InputLatencyTracker inputLatency;
 
     void setRoamingModeSession(bool enabled);
     bool isRoamingModeSession() const { return roamingMode; }
@@ -47,9 +67,23 @@ public:
     ~ClientEngine();
 
     void earlyUpdate(TimeUtils::duration deltaTime);
+    // Banks a frame's time and returns how many fixed simulation steps are due.
+    // Time beyond maxStepsPerFrame steps is dropped so a long stall cannot snowball.
+    int advanceSimulation(TimeUtils::duration frameDelta);
     void step(TimeUtils::duration deltaTime);
+    // Polls events that arrived during the frame, right before the camera is
+    // posed for rendering, and moves the presentation time up to now.
+    void latchLateInput();
     void lateUpdate(TimeUtils::duration deltaTime);
     void updateRoamingCamera(TimeUtils::duration deltaTime, bool allowInput);
 
     const game_input::InputState& getInputState() const { return inputState; }
+    // Physics steps taken so far, and the length of the most recent one.
+    uint64_t getStepCount() const { return stepCount; }
+    TimeUtils::duration getLastStepDelta() const { return lastStepDelta; }
+    TimeUtils::duration getFixedStepDelta() const { return fixedStepDelta; }
+    // How far the frame is between the last two simulation states, in [0, 1].
+    float getInterpolationAlpha() const {
+        return std::min(1.0f, (simulationAccumulator + presentationLead) / fixedStepDelta);
+    }
 };
@@ -19,6 +19,7 @@ void ServerEngine::earlyUpdate(TimeUtils::duration deltaTime) {
 }
 
 void ServerEngine::lateUpdate(TimeUtils::duration deltaTime) {
+    network->flushOutbound();
     physics->update(deltaTime);
     network->flushPeekedMessages();
     karma::config::ConfigStore::Tick();
@@ -2,6 +2,7 @@
 
 #include "game/net/messages.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -19,6 +20,13 @@ struct ServerEndpointInfo {
     uint16_t port = 0;
 };
 
+enum class ConnectState {
+    Idle,
+    Connecting,
+    Connected,
+    Failed
+};
+
 struct ClientMsgData {
     ServerMsg* msg = nullptr;
     bool peeked = false;
@@ -33,7 +41,10 @@ class ClientBackend {
 public:
     virtual ~ClientBackend() = default;
 
-    virtual bool connect(const std::string& address, uint16_t port, int timeoutMs) = 0;
+    // Non-blocking; update() advances the attempt. Candidates are tried in parallel.
+    virtual bool beginConnect(const std::vector<ServerEndpointInfo>& candidates, int timeoutMs) = 0;
+    virtual void cancelConnect() = 0;
+    virtual ConnectState getConnectState() const = 0;
     virtual void disconnect(const std::string& reason) = 0;
     virtual std::optional<DisconnectEvent> consumeDisconnectEvent() = 0;
     virtual bool isConnected() const = 0;
@@ -53,8 +64,15 @@ public:
     virtual void update() = 0;
     virtual void flushPeekedMessages() = 0;
     virtual void sendImpl(client_id clientId, const ServerMsg& input, bool flush) = 0;
+    // Submits an already encoded message; type only selects the delivery mode.
+    virtual void sendEncoded(client_id clientId,
+                             const std::byte* data,
+                             std::size_t size,
+                             ServerMsg_Type type,
+                             bool flush) = 0;
     virtual void disconnectClient(client_id clientId, const std::string& reason) = 0;
     virtual std::vector<client_id> getClients() const = 0;
+    virtual std::optional<uint32_t> getClientRoundTripMs(client_id clientId) const = 0;
 
     virtual std::vector<ServerMsgData>& receivedMessages() = 0;
 };
@@ -51,6 +51,16 @@ void EnetClientBackend::update() {
 
     for (const auto &evt : events) {
         switch (evt.type) {
+        case ::net::Event::Type::Connect: {
+            spdlog::info("Connected to server.");
+            const ServerEndpointInfo fallback = requestedEndpoint_.value_or(ServerEndpointInfo{});
+            serverEndpoint_ = ServerEndpointInfo{
+                transport_->getRemoteIp().value_or(fallback.host),
+                transport_->getRemotePort().value_or(fallback.port)
+            };
+            connectState_ = ConnectState::Connected;
+            break;
+        }
         case ::net::Event::Type::Receive: {
             if (evt.payload.empty()) {
                 break;
@@ -69,6 +79,7 @@ void EnetClientBackend::update() {
             spdlog::info("{}", kDisconnectReason);
             pendingDisconnect_ = DisconnectEvent{ kDisconnectReason };
             serverEndpoint_.reset();
+            connectState_ = ConnectState::Idle;
             for (auto &msgData : receivedMessages_) {
                 delete msgData.msg;
             }
@@ -79,6 +90,7 @@ void EnetClientBackend::update() {
             spdlog::info("{}", kTimeoutReason);
             pendingDisconnect_ = DisconnectEvent{ kTimeoutReason };
             serverEndpoint_.reset();
+            connectState_ = ConnectState::Idle;
             for (auto &msgData : receivedMessages_) {
                 delete msgData.msg;
             }
@@ -89,39 +101,65 @@ void EnetClientBackend::update() {
             break;
         }
     }
+
+    if (connectState_ == ConnectState::Connecting &&
+        transport_->getConnectState() == ::net::ConnectState::Failed) {
+        spdlog::info("Connection to server failed.");
+        serverEndpoint_.reset();
+        connectState_ = ConnectState::Failed;
+    }
 }
 
-bool EnetClientBackend::connect(const std::string &addr, uint16_t port, int timeoutMs) {
+bool EnetClientBackend::beginConnect(const std::vector<ServerEndpointInfo> &candidates, int timeoutMs) {
     if (!transport_) {
-        spdlog::error("ClientNetwork::connect: transport is not initialized.");
+        spdlog::error("ClientNetwork::beginConnect: transport is not initialized.");
         return false;
     }
 
     pendingDisconnect_.reset();
+    serverEndpoint_.reset();
     for (auto &msgData : receivedMessages_) {
         delete msgData.msg;
     }
     receivedMessages_.clear();
 
-    if (!transport_->connect(addr, port, timeoutMs)) {
+    std::vector<::net::ConnectCandidate> transportCandidates;
+    transportCandidates.reserve(candidates.size());
+    for (const auto &candidate : candidates) {
+        transportCandidates.push_back(::net::ConnectCandidate{ candidate.host, candidate.port });
+    }
+    requestedEndpoint_ = candidates.empty() ? std::nullopt : std::optional<ServerEndpointInfo>(candidates.front());
+
+    if (!transport_->beginConnect(transportCandidates, timeoutMs)) {
         spdlog::info("Connection to server failed.");
-        serverEndpoint_.reset();
+        connectState_ = ConnectState::Failed;
         return false;
     }
-
-    spdlog::info("Connected to server.");
-    auto remoteIp = transport_->getRemoteIp();
-    auto remotePort = transport_->getRemotePort();
-    serverEndpoint_ = ServerEndpointInfo{ remoteIp.value_or(addr), remotePort.value_or(port) };
+    connectState_ = ConnectState::Connecting;
     return true;
 }
 
+void EnetClientBackend::cancelConnect() {
+    if (connectState_ != ConnectState::Connecting) {
+        return;
+    }
+    if (transport_) {
+        transport_->cancelConnect();
+    }
+    connectState_ = ConnectState::Idle;
+}
+
+ConnectState EnetClientBackend::getConnectState() const {
+    return connectState_;
+}
+
 void EnetClientBackend::disconnect(const std::string &reason) {
     if (!transport_ || !transport_->isConnected()) {
         return;
     }
 
     transport_->disconnect();
+    connectState_ = ConnectState::Idle;
     pendingDisconnect_ = DisconnectEvent{ reason.empty() ? kDisconnectReason : reason };
     serverEndpoint_.reset();
     for (auto &msgData : receivedMessages_) {
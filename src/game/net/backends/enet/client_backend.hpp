@@ -13,7 +13,9 @@ public:
     EnetClientBackend();
     ~EnetClientBackend() override;
 
-    bool connect(const std::string& address, uint16_t port, int timeoutMs) override;
+    bool beginConnect(const std::vector<ServerEndpointInfo>& candidates, int timeoutMs) override;
+    void cancelConnect() override;
+    ConnectState getConnectState() const override;
     void disconnect(const std::string& reason) override;
     std::optional<DisconnectEvent> consumeDisconnectEvent() override;
     bool isConnected() const override;
@@ -31,6 +33,8 @@ private:
     std::unique_ptr<::net::IClientTransport> transport_;
     std::optional<DisconnectEvent> pendingDisconnect_;
     std::optional<ServerEndpointInfo> serverEndpoint_;
+    std::optional<ServerEndpointInfo> requestedEndpoint_;
+    ConnectState connectState_ = ConnectState::Idle;
     std::vector<ClientMsgData> receivedMessages_;
 };
 
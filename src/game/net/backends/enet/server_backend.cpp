@@ -1,10 +1,32 @@
 #include "game/net/backends/enet/server_backend.hpp"
 
+#include "game/net/discovery_protocol.hpp"
 #include "game/net/proto_codec.hpp"
 #include "karma/network/transport_factory.hpp"
 #include "spdlog/spdlog.h"
 
 #include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Answers server browser latency probes on the game port.
+bool AnswerPing(const std::byte *data, std::size_t size, std::vector<std::byte> &reply) {
+    if (size < sizeof(DiscoveryProtocol::PingPacket)) {
+        return false;
+    }
+    DiscoveryProtocol::PingPacket ping;
+    std::memcpy(&ping, data, sizeof(ping));
+    if (!DiscoveryProtocol::isPing(ping)) {
+        return false;
+    }
+    const DiscoveryProtocol::PongPacket pong = DiscoveryProtocol::makePong(ping);
+    reply.resize(sizeof(pong));
+    std::memcpy(reply.data(), &pong, sizeof(pong));
+    return true;
+}
+
+} // namespace
 
 namespace game::net {
 
@@ -14,6 +36,7 @@ EnetServerBackend::EnetServerBackend(uint16_t port, int maxClients, int numChann
         spdlog::error("ServerNetwork::ServerNetwork: Failed to initialize server transport.");
         return;
     }
+    transport_->setDatagramHandler(AnswerPing);
 
     spdlog::info("Server started on port {}", port);
 }
@@ -141,6 +164,17 @@ std::vector<client_id> EnetServerBackend::getClients() const {
     return clientIds;
 }
 
+std::optional<uint32_t> EnetServerBackend::getClientRoundTripMs(client_id clientId) const {
+    if (!transport_) {
+        return std::nullopt;
+    }
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) {
+        return std::nullopt;
+    }
+    return transport_->getRoundTripTimeMs(it->second);
+}
+
 void EnetServerBackend::disconnectClient(client_id clientId, const std::string &reason) {
     auto it = clients_.find(clientId);
     if (it == clients_.end()) {
@@ -171,24 +205,36 @@ void EnetServerBackend::sendImpl(client_id clientId, const ServerMsg &input, boo
         return;
     }
 
+    auto encoded = ::net::encodeServerMsg(input);
+    if (!encoded.has_value()) {
+        logUnsupportedMessageType();
+        return;
+    }
+
+    sendEncoded(clientId, encoded->data(), encoded->size(), input.type, flush);
+}
+
+void EnetServerBackend::sendEncoded(client_id clientId,
+                                    const std::byte *data,
+                                    std::size_t size,
+                                    ServerMsg_Type type,
+                                    bool flush) {
+    if (!transport_) {
+        return;
+    }
+
     auto it = clients_.find(clientId);
     if (it == clients_.end()) {
         return;
     }
 
     ::net::Delivery delivery = ::net::Delivery::Reliable;
-    if (input.type == ServerMsg_Type_PLAYER_LOCATION) {
+    if (type == ServerMsg_Type_PLAYER_LOCATION || type == ServerMsg_Type_INPUT_ACK) {
         delivery = ::net::Delivery::Unreliable;
     }
 
-    auto encoded = ::net::encodeServerMsg(input);
-    if (!encoded.has_value()) {
-        logUnsupportedMessageType();
-        return;
-    }
-
-    const bool shouldFlush = flush || (input.type == ServerMsg_Type_INIT);
-    transport_->send(it->second, encoded->data(), encoded->size(), delivery, shouldFlush);
+    const bool shouldFlush = flush || (type == ServerMsg_Type_INIT);
+    transport_->send(it->second, data, size, delivery, shouldFlush);
 }
 
 } // namespace game::net
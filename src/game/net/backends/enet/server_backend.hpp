@@ -17,8 +17,14 @@ public:
     void update() override;
     void flushPeekedMessages() override;
     void sendImpl(client_id clientId, const ServerMsg& input, bool flush) override;
+    void sendEncoded(client_id clientId,
+                     const std::byte* data,
+                     std::size_t size,
+                     ServerMsg_Type type,
+                     bool flush) override;
     void disconnectClient(client_id clientId, const std::string& reason) override;
     std::vector<client_id> getClients() const override;
+    std::optional<uint32_t> getClientRoundTripMs(client_id clientId) const override;
 
     std::vector<ServerMsgData>& receivedMessages() override { return receivedMessages_; }
 
@@ -18,11 +18,21 @@ void ClientNetwork::update() {
     }
 }
 
-bool ClientNetwork::connect(const std::string &addr, uint16_t port, int timeoutMs) {
+bool ClientNetwork::beginConnect(const std::vector<ServerEndpointInfo> &candidates, int timeoutMs) {
     if (!backend_) {
         return false;
     }
-    return backend_->connect(addr, port, timeoutMs);
+    return backend_->beginConnect(candidates, timeoutMs);
+}
+
+void ClientNetwork::cancelConnect() {
+    if (backend_) {
+        backend_->cancelConnect();
+    }
+}
+
+ClientNetwork::ConnectState ClientNetwork::getConnectState() const {
+    return backend_ ? backend_->getConnectState() : ConnectState::Idle;
 }
 
 void ClientNetwork::disconnect(const std::string &reason) {
@@ -49,6 +59,41 @@ std::optional<ClientNetwork::ServerEndpointInfo> ClientNetwork::getServerEndpoin
     return backend_->getServerEndpoint();
 }
 
+void ClientNetwork::setHandlerImpl(ServerMsg_Type type, MessageHandler handler) {
+    const auto index = static_cast<std::size_t>(type);
+    if (index >= handlers_.size()) {
+        handlers_.resize(index + 1);
+    }
+    handlers_[index] = std::move(handler);
+}
+
+void ClientNetwork::clearHandlers() {
+    handlers_.clear();
+}
+
+std::size_t ClientNetwork::dispatchMessages() {
+    if (!backend_ || handlers_.empty()) {
+        return 0;
+    }
+
+    auto &receivedMessages = backend_->receivedMessages();
+    std::size_t dispatched = 0;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < receivedMessages.size(); ++i) {
+        auto &msgData = receivedMessages[i];
+        const auto index = msgData.msg ? static_cast<std::size_t>(msgData.msg->type) : handlers_.size();
+        if (index < handlers_.size() && handlers_[index] && !msgData.peeked) {
+            handlers_[index](*msgData.msg);
+            delete msgData.msg;
+            ++dispatched;
+            continue;
+        }
+        receivedMessages[kept++] = msgData;
+    }
+    receivedMessages.resize(kept);
+    return dispatched;
+}
+
 void ClientNetwork::sendImpl(const ClientMsg &input, bool flush) {
     if (backend_) {
         backend_->sendImpl(input, flush);
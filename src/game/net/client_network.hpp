@@ -16,9 +16,15 @@ class ClientNetwork {
 public:
     using DisconnectEvent = game::net::DisconnectEvent;
     using ServerEndpointInfo = game::net::ServerEndpointInfo;
+    using ConnectState = game::net::ConnectState;
+    using MessageHandler = std::function<void(const ServerMsg&)>;
 
 private:
     std::unique_ptr<game::net::ClientBackend> backend_;
+    // Indexed by ServerMsg_Type.
+    std::vector<MessageHandler> handlers_;
+
+    void setHandlerImpl(ServerMsg_Type type, MessageHandler handler);
 
     ClientNetwork();
     ~ClientNetwork();
@@ -28,7 +34,12 @@ private:
     void sendImpl(const ClientMsg &input, bool flush);
 
 public:
-    bool connect(const std::string &address, uint16_t port, int timeoutMs = 5000);
+    // Starts connecting without blocking the frame; update() advances the
+    // attempt and getConnectState() reports how it went. Every candidate, and
+    // every address a candidate resolves to, is tried at once.
+    bool beginConnect(const std::vector<ServerEndpointInfo> &candidates, int timeoutMs = 5000);
+    void cancelConnect();
+    ConnectState getConnectState() const;
     void disconnect(const std::string &reason = "");
     std::optional<DisconnectEvent> consumeDisconnectEvent();
     bool isConnected() const;
@@ -80,6 +91,26 @@ public:
         return results;
     }
 
+    // Registers the handler dispatchMessages() calls for every message of type T.
+    // An empty handler unregisters it.
+    template<typename T> void setHandler(std::function<void(const T&)> handler) {
+        static_assert(std::is_base_of_v<ServerMsg, T>, "T must be a subclass of ServerMsg");
+        if (!handler) {
+            setHandlerImpl(T::Type, nullptr);
+            return;
+        }
+        setHandlerImpl(T::Type, [handler = std::move(handler)](const ServerMsg &msg) {
+            handler(static_cast<const T&>(msg));
+        });
+    }
+    void clearHandlers();
+
+    // Hands every received message with a registered handler to it, in
+    // arrival order, in a single pass. Messages without a handler stay queued
+    // for consumeMessages(). Handlers must not consume messages or disconnect.
+    // Returns the number dispatched.
+    std::size_t dispatchMessages();
+
     template<typename T> void send(const T &input, bool flush = false) {
         static_assert(std::is_base_of_v<ClientMsg, T>, "T must be a subclass of ClientMsg");
         sendImpl(input, flush);
@@ -9,7 +9,9 @@ constexpr uint16_t PORT = 47800;
 
 enum class PacketType : uint16_t {
     Request = 1,
-    Response = 2
+    Response = 2,
+    Ping = 3,
+    Pong = 4
 };
 
 #pragma pack(push, 1)
@@ -39,6 +41,30 @@ struct ResponsePacket : PacketHeader {
     char serverName[64];
     char worldName[64];
 };
+
+// Latency probe for the server browser. Answered by the discovery beacon and,
+// outside the ENet protocol, on the game port. The server echoes both fields.
+struct PingPacket : PacketHeader {
+    PingPacket() {
+        type = static_cast<uint16_t>(PacketType::Ping);
+        token = 0;
+        sequence = 0;
+    }
+
+    uint32_t token;      // chosen by the prober per server
+    uint32_t sequence;
+};
+
+struct PongPacket : PacketHeader {
+    PongPacket() {
+        type = static_cast<uint16_t>(PacketType::Pong);
+        token = 0;
+        sequence = 0;
+    }
+
+    uint32_t token;
+    uint32_t sequence;
+};
 #pragma pack(pop)
 
 inline bool isValid(const PacketHeader &header) {
@@ -53,4 +79,19 @@ inline bool isResponse(const PacketHeader &header) {
     return isValid(header) && header.type == static_cast<uint16_t>(PacketType::Response);
 }
 
+inline bool isPing(const PacketHeader &header) {
+    return isValid(header) && header.type == static_cast<uint16_t>(PacketType::Ping);
+}
+
+inline bool isPong(const PacketHeader &header) {
+    return isValid(header) && header.type == static_cast<uint16_t>(PacketType::Pong);
+}
+
+inline PongPacket makePong(const PingPacket &ping) {
+    PongPacket pong;
+    pong.token = ping.token;
+    pong.sequence = ping.sequence;
+    return pong;
+}
+
 } // namespace DiscoveryProtocol
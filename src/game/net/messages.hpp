@@ -1,6 +1,7 @@
 #pragma once
 
 #include "karma/core/types.hpp"
+#include "game/world/player_parameters.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -15,7 +16,10 @@ constexpr client_id SERVER_CLIENT_ID = 0;
 constexpr client_id BROADCAST_CLIENT_ID = 1;
 constexpr client_id FIRST_CLIENT_ID = 2;
 
-constexpr uint32_t NET_PROTOCOL_VERSION = 4;
+constexpr uint32_t NET_PROTOCOL_VERSION = 8;
+
+// ServerMsg_Init feature: the server simulates movement from ClientMsg_PlayerInput.
+constexpr const char *NET_FEATURE_SERVER_MOVEMENT = "server_movement";
 
 struct PlayerState {
     std::string name;
@@ -46,7 +50,8 @@ enum ServerMsg_Type {
     ServerMsg_Type_CREATE_SHOT,
     ServerMsg_Type_REMOVE_SHOT,
     ServerMsg_Type_INIT,
-    ServerMsg_Type_CHAT
+    ServerMsg_Type_CHAT,
+    ServerMsg_Type_INPUT_ACK
 };
 
 struct ServerMsg {
@@ -78,7 +83,8 @@ struct ServerMsg_PlayerParameters : ServerMsg {
     static constexpr ServerMsg_Type Type = ServerMsg_Type_PLAYER_PARAMETERS;
     ServerMsg_PlayerParameters() { type = Type; }
     client_id clientId;
-    PlayerParameters params;
+    // Every change made to the player during one server tick.
+    std::vector<PlayerParameterChange> changes;
 };
 
 struct ServerMsg_PlayerLocation : ServerMsg {
@@ -88,6 +94,9 @@ struct ServerMsg_PlayerLocation : ServerMsg {
     glm::vec3 position;
     glm::quat rotation;
     glm::vec3 velocity;
+    // Seconds on the server's tick timeline when it took this pose; clients
+    // interpolate on it instead of on packet arrival times.
+    double serverTime = 0.0;
 };
 
 struct ServerMsg_PlayerSpawn : ServerMsg {
@@ -135,6 +144,16 @@ struct ServerMsg_Chat : ServerMsg {
     std::string text;
 };
 
+// Sent to a player's own client: their state after the server ran every input up to `sequence`.
+struct ServerMsg_InputAck : ServerMsg {
+    static constexpr ServerMsg_Type Type = ServerMsg_Type_INPUT_ACK;
+    ServerMsg_InputAck() { type = Type; }
+    uint32_t sequence;
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 velocity;
+};
+
 struct ServerMsg_Init : ServerMsg {
     static constexpr ServerMsg_Type Type = ServerMsg_Type_INIT;
     ServerMsg_Init() { type = Type; }
@@ -143,6 +162,8 @@ struct ServerMsg_Init : ServerMsg {
     std::string worldName;
     uint32_t protocolVersion = NET_PROTOCOL_VERSION;
     std::vector<std::string> features;
+    // Parameter names in id order, and their default values.
+    std::vector<std::string> playerParameterNames;
     PlayerParameters defaultPlayerParams;
     std::vector<std::byte> worldData;
 };
@@ -157,7 +178,8 @@ enum ClientMsg_Type {
     ClientMsg_Type_REQUEST_PLAYER_SPAWN,
     ClientMsg_Type_PLAYER_LOCATION,
     ClientMsg_Type_CREATE_SHOT,
-    ClientMsg_Type_CHAT
+    ClientMsg_Type_CHAT,
+    ClientMsg_Type_PLAYER_INPUT
 };
 
 struct ClientMsg {
@@ -192,6 +214,19 @@ struct ClientMsg_PlayerLocation : ClientMsg {
     ClientMsg_PlayerLocation() { type = Type; }
     glm::vec3 position;
     glm::quat rotation;
+    // Lets receivers dead-reckon between the client's rate-limited updates.
+    glm::vec3 velocity;
+};
+
+// One simulation step of driving input, replacing ClientMsg_PlayerLocation
+// when the server has NET_FEATURE_SERVER_MOVEMENT.
+struct ClientMsg_PlayerInput : ClientMsg {
+    static constexpr ClientMsg_Type Type = ClientMsg_Type_PLAYER_INPUT;
+    ClientMsg_PlayerInput() { type = Type; }
+    uint32_t sequence;
+    float deltaTime;
+    glm::vec2 movement;
+    bool jump;
 };
 
 struct ClientMsg_CreateShot : ClientMsg {
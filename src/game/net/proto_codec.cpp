@@ -2,6 +2,7 @@
 
 #include "messages.pb.h"
 
+#include <algorithm>
 #include <string>
 
 namespace net {
@@ -48,10 +49,7 @@ void decodePlayerState(const karma::PlayerState &input, PlayerState &output) {
     output.registeredUser = input.registered_user();
     output.communityAdmin = input.community_admin();
     output.localAdmin = input.local_admin();
-    output.params.clear();
-    for (const auto &[key, val] : input.params().params()) {
-        output.params[key] = val;
-    }
+    output.params.assign(input.params().values().begin(), input.params().values().end());
 }
 
 void encodePlayerState(const PlayerState &input, karma::PlayerState *output) {
@@ -64,10 +62,7 @@ void encodePlayerState(const PlayerState &input, karma::PlayerState *output) {
     output->set_registered_user(input.registeredUser);
     output->set_community_admin(input.communityAdmin);
     output->set_local_admin(input.localAdmin);
-    auto *params = output->mutable_params();
-    for (const auto &[key, val] : input.params) {
-        (*params->mutable_params())[key] = val;
-    }
+    output->mutable_params()->mutable_values()->Add(input.params.begin(), input.params.end());
 }
 
 } // namespace
@@ -106,9 +101,15 @@ std::unique_ptr<ServerMsg> decodeServerMsg(const std::byte *data, std::size_t si
 
     case karma::ServerMsg::kPlayerParameters: {
         auto out = std::make_unique<ServerMsg_PlayerParameters>();
-        out->clientId = msg.player_parameters().client_id();
-        for (const auto& [key, val] : msg.player_parameters().params().params()) {
-            out->params[key] = val;
+        const auto &params = msg.player_parameters();
+        out->clientId = params.client_id();
+        const int count = std::min(params.ids_size(), params.values_size());
+        out->changes.reserve(static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            if (params.ids(i) >= INVALID_PLAYER_PARAMETER) {
+                continue;
+            }
+            out->changes.push_back({static_cast<PlayerParameterId>(params.ids(i)), params.values(i)});
         }
         return out;
     }
@@ -119,6 +120,7 @@ std::unique_ptr<ServerMsg> decodeServerMsg(const std::byte *data, std::size_t si
         decodeVec3(msg.player_location().position(), out->position);
         decodeQuat(msg.player_location().rotation(), out->rotation);
         decodeVec3(msg.player_location().velocity(), out->velocity);
+        out->serverTime = msg.player_location().server_time();
         return out;
     }
 
@@ -166,9 +168,10 @@ std::unique_ptr<ServerMsg> decodeServerMsg(const std::byte *data, std::size_t si
         out->worldName = msg.init().world_name();
         out->protocolVersion = msg.init().protocol_version();
         out->features.assign(msg.init().features().begin(), msg.init().features().end());
-        for (const auto& [key, val] : msg.init().default_player_params().params()) {
-            out->defaultPlayerParams[key] = val;
-        }
+        out->playerParameterNames.assign(msg.init().player_parameter_names().begin(),
+                                         msg.init().player_parameter_names().end());
+        out->defaultPlayerParams.assign(msg.init().default_player_params().values().begin(),
+                                        msg.init().default_player_params().values().end());
 
         const std::string &worldDataStr = msg.init().world_data();
         const auto *dataPtr = reinterpret_cast<const std::byte*>(worldDataStr.data());
@@ -176,6 +179,15 @@ std::unique_ptr<ServerMsg> decodeServerMsg(const std::byte *data, std::size_t si
         return out;
     }
 
+    case karma::ServerMsg::kInputAck: {
+        auto out = std::make_unique<ServerMsg_InputAck>();
+        out->sequence = msg.input_ack().sequence();
+        decodeVec3(msg.input_ack().position(), out->position);
+        decodeQuat(msg.input_ack().rotation(), out->rotation);
+        decodeVec3(msg.input_ack().velocity(), out->velocity);
+        return out;
+    }
+
     case karma::ServerMsg::kChat: {
         auto out = std::make_unique<ServerMsg_Chat>();
         out->fromId = msg.chat().from_id();
@@ -214,6 +226,17 @@ std::unique_ptr<ClientMsg> decodeClientMsg(const std::byte *data, std::size_t si
         out->clientId = msg.client_id();
         decodeVec3(msg.player_location().position(), out->position);
         decodeQuat(msg.player_location().rotation(), out->rotation);
+        decodeVec3(msg.player_location().velocity(), out->velocity);
+        return out;
+    }
+
+    case karma::ClientMsg::kPlayerInput: {
+        auto out = std::make_unique<ClientMsg_PlayerInput>();
+        out->clientId = msg.client_id();
+        out->sequence = msg.player_input().sequence();
+        out->deltaTime = msg.player_input().delta_time();
+        out->movement = glm::vec2(msg.player_input().move_x(), msg.player_input().move_y());
+        out->jump = msg.player_input().jump();
         return out;
     }
 
@@ -286,6 +309,18 @@ std::optional<std::vector<std::byte>> encodeClientMsg(const ClientMsg &input) {
         auto* loc = msg.mutable_player_location();
         encodeVec3(typed.position, loc->mutable_position());
         encodeQuat(typed.rotation, loc->mutable_rotation());
+        encodeVec3(typed.velocity, loc->mutable_velocity());
+        break;
+    }
+    case ClientMsg_Type_PLAYER_INPUT: {
+        msg.set_type(karma::ClientMsg::PLAYER_INPUT);
+        const auto &typed = static_cast<const ClientMsg_PlayerInput&>(input);
+        auto* playerInput = msg.mutable_player_input();
+        playerInput->set_sequence(typed.sequence);
+        playerInput->set_delta_time(typed.deltaTime);
+        playerInput->set_move_x(typed.movement.x);
+        playerInput->set_move_y(typed.movement.y);
+        playerInput->set_jump(typed.jump);
         break;
     }
     case ClientMsg_Type_REQUEST_PLAYER_SPAWN: {
@@ -347,9 +382,11 @@ std::optional<std::vector<std::byte>> encodeServerMsg(const ServerMsg &input) {
         const auto &typed = static_cast<const ServerMsg_PlayerParameters&>(input);
         auto* pp = msg.mutable_player_parameters();
         pp->set_client_id(typed.clientId);
-        auto* params = pp->mutable_params();
-        for (const auto& [key, val] : typed.params) {
-            (*params->mutable_params())[key] = val;
+        pp->mutable_ids()->Reserve(static_cast<int>(typed.changes.size()));
+        pp->mutable_values()->Reserve(static_cast<int>(typed.changes.size()));
+        for (const auto &change : typed.changes) {
+            pp->add_ids(change.id);
+            pp->add_values(change.value);
         }
         break;
     }
@@ -361,6 +398,7 @@ std::optional<std::vector<std::byte>> encodeServerMsg(const ServerMsg &input) {
         encodeVec3(typed.position, loc->mutable_position());
         encodeQuat(typed.rotation, loc->mutable_rotation());
         encodeVec3(typed.velocity, loc->mutable_velocity());
+        loc->set_server_time(typed.serverTime);
         break;
     }
     case ServerMsg_Type_PLAYER_SPAWN: {
@@ -404,6 +442,16 @@ std::optional<std::vector<std::byte>> encodeServerMsg(const ServerMsg &input) {
         remove->set_is_global_id(typed.isGlobalId);
         break;
     }
+    case ServerMsg_Type_INPUT_ACK: {
+        msg.set_type(karma::ServerMsg::INPUT_ACK);
+        const auto &typed = static_cast<const ServerMsg_InputAck&>(input);
+        auto* ack = msg.mutable_input_ack();
+        ack->set_sequence(typed.sequence);
+        encodeVec3(typed.position, ack->mutable_position());
+        encodeQuat(typed.rotation, ack->mutable_rotation());
+        encodeVec3(typed.velocity, ack->mutable_velocity());
+        break;
+    }
     case ServerMsg_Type_CHAT: {
         msg.set_type(karma::ServerMsg::CHAT);
         const auto &typed = static_cast<const ServerMsg_Chat&>(input);
@@ -424,10 +472,11 @@ std::optional<std::vector<std::byte>> encodeServerMsg(const ServerMsg &input) {
         for (const auto &feature : typed.features) {
             init->add_features(feature);
         }
-        auto* params = init->mutable_default_player_params();
-        for (const auto& [key, val] : typed.defaultPlayerParams) {
-            (*params->mutable_params())[key] = val;
+        for (const auto &name : typed.playerParameterNames) {
+            init->add_player_parameter_names(name);
         }
+        init->mutable_default_player_params()->mutable_values()->Add(typed.defaultPlayerParams.begin(),
+                                                                     typed.defaultPlayerParams.end());
         init->set_world_data(typed.worldData.data(), typed.worldData.size());
         break;
     }
@@ -1,4 +1,15 @@
 #include "game/net/server_network.hpp"
+#include "game/net/proto_codec.hpp"
+#include "karma/common/worker_pool.hpp"
+#include "spdlog/spdlog.h"
+
+namespace {
+
+// Below these sizes a worker hand-off costs more than doing the work inline.
+constexpr std::size_t ENCODE_MESSAGES_PER_TASK = 4;
+constexpr std::size_t ROUTE_CLIENTS_PER_TASK = 8;
+
+} // namespace
 
 ServerNetwork::ServerNetwork(uint16_t port, int maxClients, int numChannels) {
     backend_ = game::net::CreateServerBackend(port, maxClients, numChannels);
@@ -18,14 +29,68 @@ void ServerNetwork::update() {
     }
 }
 
-void ServerNetwork::sendImpl(client_id clientId, const ServerMsg &input, bool flush) {
-    if (backend_) {
-        backend_->sendImpl(clientId, input, flush);
+void ServerNetwork::flushOutbound() {
+    if (!backend_ || outbound_.empty()) {
+        return;
+    }
+
+    auto &pool = karma::jobs::SharedWorkerPool();
+
+    OutboundTickView building;
+    building.messages.swap(outbound_);
+    // Recipients are fixed for the whole stage; connects and disconnects are
+    // only processed in update().
+    building.recipients = backend_->getClients();
+    // Encode each queued message once, however many clients receive it.
+    building.encoded.resize(building.messages.size());
+    pool.parallelFor(building.messages.size(), [&](std::size_t i) {
+        building.encoded[i] = ::net::encodeServerMsg(*building.messages[i].msg);
+    }, ENCODE_MESSAGES_PER_TASK);
+    const OutboundTickView view = std::move(building);
+
+    for (std::size_t i = 0; i < view.messages.size(); ++i) {
+        if (!view.encoded[i].has_value()) {
+            spdlog::error("ServerNetwork::flushOutbound: Unsupported message type {}", static_cast<int>(view.messages[i].msg->type));
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> perRecipient(view.recipients.size());
+    pool.parallelFor(view.recipients.size(), [&](std::size_t r) {
+        perRecipient[r] = assemblePackets(view, r);
+    }, ROUTE_CLIENTS_PER_TASK);
+
+    // The transport is not thread-safe, so submission stays on this thread.
+    for (std::size_t r = 0; r < view.recipients.size(); ++r) {
+        for (uint32_t i : perRecipient[r]) {
+            const auto &payload = *view.encoded[i];
+            backend_->sendEncoded(view.recipients[r], payload.data(), payload.size(), view.messages[i].msg->type, false);
+        }
+    }
+}
+
+std::vector<uint32_t> ServerNetwork::assemblePackets(const OutboundTickView &view, std::size_t r) {
+    const client_id recipient = view.recipients[r];
+    std::vector<uint32_t> packets;
+    for (std::size_t i = 0; i < view.messages.size(); ++i) {
+        if (!view.encoded[i].has_value()) {
+            continue;
+        }
+        const OutboundMessage &entry = view.messages[i];
+        const bool addressed =
+            entry.scope == OutboundScope::All ||
+            (entry.scope == OutboundScope::One && entry.clientId == recipient) ||
+            (entry.scope == OutboundScope::AllExcept && entry.clientId != recipient);
+        if (addressed) {
+            packets.push_back(static_cast<uint32_t>(i));
+        }
     }
+    return packets;
 }
 
 void ServerNetwork::disconnectClient(client_id clientId, const std::string &reason) {
     if (backend_) {
+        // Deliver whatever this tick already queued before the peer goes away.
+        flushOutbound();
         backend_->disconnectClient(clientId, reason);
     }
 }
@@ -36,3 +101,10 @@ std::vector<client_id> ServerNetwork::getClients() const {
     }
     return backend_->getClients();
 }
+
+std::optional<uint32_t> ServerNetwork::getClientRoundTripMs(client_id clientId) const {
+    if (!backend_) {
+        return std::nullopt;
+    }
+    return backend_->getClientRoundTripMs(clientId);
+}
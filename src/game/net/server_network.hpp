@@ -3,10 +3,12 @@
 #include "game/net/backend.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <map>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -15,7 +17,35 @@ class ServerNetwork {
     friend class ServerEngine;
 
 private:
+    enum class OutboundScope {
+        One,
+        All,
+        AllExcept
+    };
+
+    // A send queued during the tick; it is encoded and fanned out to
+    // recipients in flushOutbound().
+    struct OutboundMessage {
+        std::unique_ptr<ServerMsg> msg;
+        OutboundScope scope = OutboundScope::One;
+        client_id clientId = 0;
+    };
+
+    // Read-only view of one tick's outbound state: the message copies taken
+    // at send time, their encodings and the recipients. Built once on the
+    // tick thread; workers assemble per-recipient packet lists from it
+    // without touching live game or transport state.
+    struct OutboundTickView {
+        std::vector<OutboundMessage> messages;
+        std::vector<std::optional<std::vector<std::byte>>> encoded;
+        std::vector<client_id> recipients;
+    };
+
     std::unique_ptr<game::net::ServerBackend> backend_;
+    std::vector<OutboundMessage> outbound_;
+
+    // Indices into view.messages that recipient view.recipients[r] receives, in send order.
+    static std::vector<uint32_t> assemblePackets(const OutboundTickView &view, std::size_t r);
 
     ServerNetwork(
         uint16_t port,
@@ -26,7 +56,18 @@ private:
 
     void flushPeekedMessages();
     void update();
-    void sendImpl(client_id clientId, const ServerMsg &input, bool flush);
+    void flushOutbound();
+
+    template<typename T> void queueOutbound(const T *input, OutboundScope scope, client_id clientId) {
+        if (!backend_ || !input) {
+            return;
+        }
+        OutboundMessage entry;
+        entry.msg = std::make_unique<T>(*input);
+        entry.scope = scope;
+        entry.clientId = clientId;
+        outbound_.push_back(std::move(entry));
+    }
 
 public:
     template<typename T> T* peekMessage(std::function<bool(const T&)> predicate = [](const T&) { return true; }) {
@@ -82,44 +123,20 @@ public:
             sendAll<T>(input);
             return;
         }
-
-        if (!backend_) {
-            return;
-        }
-        const auto clients = backend_->getClients();
-        if (std::find(clients.begin(), clients.end(), clientId) == clients.end()) {
-            return;
-        }
-
-        sendImpl(clientId, *input, false);
+        queueOutbound<T>(input, OutboundScope::One, clientId);
     };
 
     template<typename T> void sendExcept(client_id client, const T *input) {
         static_assert(std::is_base_of_v<ServerMsg, T>, "T must be a subclass of ServerMsg");
-
-        if (!backend_) {
-            return;
-        }
-        const auto clients = backend_->getClients();
-        for (const auto& id : clients) {
-            if (id != client) {
-                send<T>(id, input);
-            }
-        }
+        queueOutbound<T>(input, OutboundScope::AllExcept, client);
     };
 
     template<typename T> void sendAll(const T *input) {
         static_assert(std::is_base_of_v<ServerMsg, T>, "T must be a subclass of ServerMsg");
-
-        if (!backend_) {
-            return;
-        }
-        const auto clients = backend_->getClients();
-        for (const auto& id : clients) {
-            send<T>(id, input);
-        }
+        queueOutbound<T>(input, OutboundScope::All, BROADCAST_CLIENT_ID);
     };
 
     void disconnectClient(client_id clientId, const std::string &reason = "");
     std::vector<client_id> getClients() const;
+    std::optional<uint32_t> getClientRoundTripMs(client_id clientId) const;
 };
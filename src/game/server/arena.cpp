@@ -0,0 +1,187 @@
+#include "server/arena.hpp"
+#include "game/engine/server_engine.hpp"
+#include "server/game.hpp"
+#include "server/community_heartbeat.hpp"
+#include "server/server_discovery.hpp"
+#include "server/terminal_commands.hpp"
+#include "plugin.hpp"
+#include "karma/common/config_store.hpp"
+#include "karma/common/data_path_resolver.hpp"
+#include "spdlog/spdlog.h"
+#include <set>
+
+extern thread_local Game *g_game;
+extern thread_local ServerEngine *g_engine;
+extern std::atomic<bool> g_running;
+
+Arena::Arena(ArenaSpec spec, std::string communityOverride)
+    : spec(std::move(spec)),
+      communityOverride(std::move(communityOverride)) {
+}
+
+Arena::~Arena() {
+    stop();
+}
+
+void Arena::start() {
+    if (worker.joinable()) {
+        return;
+    }
+    running = true;
+    worker = std::thread(&Arena::run, this);
+}
+
+void Arena::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    // Anything still queued will never be picked up by the tick thread.
+    std::lock_guard<std::mutex> lock(commandMutex);
+    for (auto &[line, promise] : pendingCommands) {
+        promise.set_value("Arena '" + spec.name + "' is not running.");
+    }
+    pendingCommands.clear();
+}
+
+std::future<std::string> Arena::submitCommand(std::string line) {
+    std::promise<std::string> promise;
+    std::future<std::string> future = promise.get_future();
+    if (!running) {
+        promise.set_value("Arena '" + spec.name + "' is not running.");
+        return future;
+    }
+
+    std::lock_guard<std::mutex> lock(commandMutex);
+    pendingCommands.emplace_back(std::move(line), std::move(promise));
+    return future;
+}
+
+void Arena::drainCommands() {
+    std::vector<std::pair<std::string, std::promise<std::string>>> commands;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        commands.swap(pendingCommands);
+    }
+    for (auto &[line, promise] : commands) {
+        promise.set_value(processTerminalInput(line));
+    }
+}
+
+void Arena::run() {
+    const std::filesystem::path configPath = spec.worldDir / "config.json";
+    auto worldConfigOpt = karma::data::LoadJsonFile(configPath, "world config", spdlog::level::err);
+    if (!worldConfigOpt || !worldConfigOpt->is_object()) {
+        spdlog::error("Arena::run: [{}] Failed to load world config object from {}", spec.name, configPath.string());
+        running = false;
+        return;
+    }
+
+    // The single-world server layers the world config into ConfigStore; arenas
+    // can't share that layer, so each builds its own merged view instead.
+    karma::json::Value arenaConfig = karma::config::ConfigStore::Merged();
+    arenaConfig.merge_patch(*worldConfigOpt);
+
+    std::string serverName = spec.name;
+    if (auto it = worldConfigOpt->find("serverName"); it != worldConfigOpt->end() && it->is_string()) {
+        serverName = it->get<std::string>();
+    }
+    std::string worldName = spec.worldDir.filename().string();
+    if (auto it = worldConfigOpt->find("worldName"); it != worldConfigOpt->end() && it->is_string()) {
+        worldName = it->get<std::string>();
+    }
+
+    {
+        ServerEngine engine(spec.port);
+        Game game(engine, serverName, worldName, *worldConfigOpt, spec.worldDir.string(), spec.customWorld);
+        g_engine = &engine;
+        g_game = &game;
+
+        ServerDiscoveryBeacon discoveryBeacon(spec.port, serverName, worldName);
+
+        CommunityHeartbeat communityHeartbeat;
+        communityHeartbeat.configureFromConfig(arenaConfig, spec.port, communityOverride);
+
+        std::unique_ptr<PluginHost> pluginHost;
+        if (PluginHost::Enabled()) {
+            pluginHost = std::make_unique<PluginHost>(arenaConfig, true);
+        } else {
+            PluginAPI::loadPythonPlugins(arenaConfig, true);
+        }
+        NativePlugins::load(arenaConfig);
+        spdlog::info("Arena::run: [{}] Serving '{}' on port {}", spec.name, worldName, spec.port);
+
+        TimeUtils::time lastTick = TimeUtils::GetCurrentTime();
+        while (running && g_running) {
+            const TimeUtils::time now = TimeUtils::GetCurrentTime();
+            const TimeUtils::duration dt = TimeUtils::GetElapsedTime(lastTick, now);
+            if (dt < SERVER_MIN_TICK_SECONDS) {
+                TimeUtils::sleep(SERVER_MIN_TICK_SECONDS - dt);
+                continue;
+            }
+            lastTick = now;
+
+            drainCommands();
+
+            engine.earlyUpdate(dt);
+            game.update(dt);
+            engine.lateUpdate(dt);
+            communityHeartbeat.update(game);
+        }
+
+        NativePlugins::unload();
+        if (pluginHost) {
+            pluginHost.reset();
+        } else {
+            PluginAPI::unloadPythonPlugins();
+        }
+        g_game = nullptr;
+        g_engine = nullptr;
+    }
+
+    running = false;
+    spdlog::info("Arena::run: [{}] Stopped", spec.name);
+}
+
+std::vector<ArenaSpec> Arena::LoadSpecs(const karma::json::Value &mergedConfig) {
+    std::vector<ArenaSpec> specs;
+    auto arenasIt = mergedConfig.find("arenas");
+    if (arenasIt == mergedConfig.end() || !arenasIt->is_array()) {
+        return specs;
+    }
+
+    std::set<uint16_t> usedPorts;
+    for (const auto &entry : *arenasIt) {
+        if (!entry.is_object()) {
+            spdlog::warn("Arena::LoadSpecs: Skipping arena entry because it is not an object.");
+            continue;
+        }
+
+        auto worldIt = entry.find("world");
+        auto portIt = entry.find("port");
+        if (worldIt == entry.end() || !worldIt->is_string() ||
+            portIt == entry.end() || !portIt->is_number_unsigned()) {
+            spdlog::warn("Arena::LoadSpecs: Skipping arena entry missing a string 'world' or numeric 'port'.");
+            continue;
+        }
+
+        ArenaSpec spec;
+        spec.worldDir = karma::data::Resolve(worldIt->get<std::string>());
+        spec.port = static_cast<uint16_t>(portIt->get<unsigned int>());
+        spec.name = entry.value("name", spec.worldDir.filename().string());
+        spec.customWorld = !entry.value("bundledWorld", false);
+
+        if (!std::filesystem::is_directory(spec.worldDir)) {
+            spdlog::warn("Arena::LoadSpecs: Skipping arena '{}': world directory not found: {}", spec.name, spec.worldDir.string());
+            continue;
+        }
+        if (!usedPorts.insert(spec.port).second) {
+            spdlog::warn("Arena::LoadSpecs: Skipping arena '{}': port {} is already taken", spec.name, spec.port);
+            continue;
+        }
+
+        specs.push_back(std::move(spec));
+    }
+    return specs;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "karma/common/json.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct ArenaSpec {
+    std::string name;
+    std::filesystem::path worldDir;
+    uint16_t port = 0;
+    bool customWorld = true;
+};
+
+// One independent game instance (network port, physics world, Game, plugins)
+// ticking on its own thread. Several arenas can share a process; server-side
+// globals are thread-local, so everything an arena touches must run on its
+// thread, including terminal commands routed to it.
+class Arena {
+private:
+    ArenaSpec spec;
+    std::string communityOverride;
+
+    std::thread worker;
+    std::atomic<bool> running{false};
+
+    std::mutex commandMutex;
+    std::vector<std::pair<std::string, std::promise<std::string>>> pendingCommands;
+
+    void run();
+    void drainCommands();
+
+public:
+    Arena(ArenaSpec spec, std::string communityOverride);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void start();
+    void stop();
+
+    bool isRunning() const { return running.load(); }
+    const ArenaSpec &getSpec() const { return spec; }
+
+    // Runs a terminal command on the arena's tick thread.
+    std::future<std::string> submitCommand(std::string line);
+
+    static std::vector<ArenaSpec> LoadSpecs(const karma::json::Value &mergedConfig);
+};
@@ -1,6 +1,13 @@
 #include "client.hpp"
 #include "spdlog/spdlog.h"
 #include "server/game.hpp"
+#include <algorithm>
+
+namespace {
+// Longest a reported position is carried forward along its velocity; a
+// client that stops reporting stays put after this.
+constexpr double MAX_EXTRAPOLATION_SECONDS = 0.25;
+} // namespace
 
 Client::Client(Game &game,
                client_id id,
@@ -14,7 +21,8 @@ Client::Client(Game &game,
       ip(std::move(ip)),
       registeredUser(registeredUser),
       communityAdmin(communityAdmin),
-      localAdmin(localAdmin) {
+      localAdmin(localAdmin),
+      history(game.lagCompensation->historyCapacity()) {
     state.name = std::move(name);
     state.position = glm::vec3(0.0f, 0.0f, 0.0f);
     state.rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
@@ -48,27 +56,54 @@ std::string Client::getName() const {
     return state.name;
 }
 
+glm::vec3 Client::getPosition() const {
+    if (!state.alive) {
+        return state.position;
+    }
+    const double elapsed = std::clamp(game.lagCompensation->getServerTime() - locationTime,
+                                      0.0, MAX_EXTRAPOLATION_SECONDS);
+    return state.position + state.velocity * static_cast<float>(elapsed);
+}
+
 void Client::applyLocation(const glm::vec3 &position, const glm::quat &rotation) {
     state.position = position;
     state.rotation = rotation;
+    locationTime = game.lagCompensation->getServerTime();
 
     ServerMsg_PlayerLocation updateMsg;
     updateMsg.clientId = id;
     updateMsg.position = state.position;
     updateMsg.rotation = state.rotation;
     updateMsg.velocity = state.velocity;
+    updateMsg.serverTime = game.lagCompensation->getServerTime();
     game.engine.network->sendExcept<ServerMsg_PlayerLocation>(id, &updateMsg);
 }
 
-void Client::trySpawn(const Location &spawnLocation) {
+void Client::applyLocation(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity) {
+    state.velocity = velocity;
+    applyLocation(position, rotation);
+}
+
+void Client::correctLocation(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity) {
+    applyLocation(position, rotation, velocity);
+
+    // Location updates don't move the owner's own controller; a full state does.
+    ServerMsg_PlayerState stateMsg;
+    stateMsg.clientId = id;
+    stateMsg.state = state;
+    game.engine.network->send<ServerMsg_PlayerState>(id, &stateMsg);
+}
+
+bool Client::trySpawn(const Location &spawnLocation) {
     if (state.alive) {
         spdlog::warn("Client::trySpawn: Client id {} requested spawn while already alive", id);
-        return;
+        return false;
     }
 
     state.position = spawnLocation.position;
     state.rotation = spawnLocation.rotation;
     state.velocity = glm::vec3(0.0f);
+    locationTime = game.lagCompensation->getServerTime();
 
     ServerMsg_PlayerSpawn spawnRespMsg;
     spawnRespMsg.clientId = id;
@@ -78,11 +113,13 @@ void Client::trySpawn(const Location &spawnLocation) {
     game.engine.network->sendAll<ServerMsg_PlayerSpawn>(&spawnRespMsg);
 
     state.alive = true;
+    return true;
 }
 
 void Client::die() {
     if (state.alive) {
         state.alive = false;
+        game.flags->drop(id);
 
         // Broadcast to everyone else
         ServerMsg_PlayerDeath deathMsg;
@@ -101,17 +138,40 @@ void Client::setScore(int newScore) {
 }
 
 bool Client::setParameter(const std::string &param, float value) {
-    if (state.params.find(param) == state.params.end()) {
+    const PlayerParameterId paramId = game.world->parameterSchema().find(param);
+    if (paramId == INVALID_PLAYER_PARAMETER) {
         spdlog::warn("Client::setParameter: Client id {} attempted to set unknown parameter '{}'", id, param);
         return false;
     }
+    return setParameter(paramId, value);
+}
+
+bool Client::setParameter(PlayerParameterId param, float value) {
+    if (param >= state.params.size()) {
+        spdlog::warn("Client::setParameter: Client id {} attempted to set unknown parameter id {}", id, param);
+        return false;
+    }
 
     state.params[param] = value;
 
+    for (auto &change : pendingParameterChanges) {
+        if (change.id == param) {
+            change.value = value;
+            return true;
+        }
+    }
+    pendingParameterChanges.push_back({param, value});
+    return true;
+}
+
+void Client::flushParameterChanges() {
+    if (pendingParameterChanges.empty()) {
+        return;
+    }
+
     // Broadcast updated parameters to all clients
     ServerMsg_PlayerParameters paramMsg;
     paramMsg.clientId = id;
-    paramMsg.params[param] = value;
+    paramMsg.changes.swap(pendingParameterChanges);
     game.engine.network->sendAll<ServerMsg_PlayerParameters>(&paramMsg);
-    return true;
 }
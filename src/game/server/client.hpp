@@ -2,6 +2,7 @@
 #include <string>
 #include "karma/core/types.hpp"
 #include "game/net/messages.hpp"
+#include "server/lag_compensation.hpp"
 
 class Game;
 
@@ -15,6 +16,12 @@ private:
     bool localAdmin = false;
 
     PlayerState state;
+    // Server time at which state.position was received; getPosition()
+    // extrapolates from it along state.velocity.
+    double locationTime = 0.0;
+    PlayerHistory history;
+    // Parameter changes made this tick, sent together by flushParameterChanges.
+    std::vector<PlayerParameterChange> pendingParameterChanges;
 
 public:
     Client(Game &game,
@@ -36,12 +43,23 @@ public:
     bool isRegisteredUser() const { return registeredUser; }
     bool isCommunityAdmin() const { return communityAdmin; }
     bool isLocalAdmin() const { return localAdmin; }
-    glm::vec3 getPosition() const { return state.position; }
+    // The last reported position, extrapolated to the current server time.
+    glm::vec3 getPosition() const;
+    const PlayerHistory &getHistory() const { return history; }
+    void recordHistory(server_tick tick) { history.record(tick, state, getPosition()); }
 
     void applyLocation(const glm::vec3 &position, const glm::quat &rotation);
-    void trySpawn(const Location &spawnLocation);
+    void applyLocation(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    // Overrides a rejected move; velocity replaces the claimed one so nothing
+    // extrapolates along it.
+    void correctLocation(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    // Returns false when the player is already alive and nothing changed.
+    bool trySpawn(const Location &spawnLocation);
 
     void die();
     void setScore(int newScore);
     bool setParameter(const std::string &param, float value);
+    bool setParameter(PlayerParameterId param, float value);
+    // Called once per tick; broadcasts this tick's parameter changes as one message.
+    void flushParameterChanges();
 };
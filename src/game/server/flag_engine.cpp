@@ -0,0 +1,261 @@
+#include "server/flag_engine.hpp"
+#include "server/game.hpp"
+#include "karma/common/data_path_resolver.hpp"
+#include "spdlog/spdlog.h"
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+namespace {
+
+constexpr const char *DEFINITION_FILE_NAME = "flag.json";
+
+std::optional<FlagDefinition> ParseDefinition(const karma::json::Value &json, const std::string &source) {
+    if (!json.is_object() || !json.contains("cname") || !json["cname"].is_string()) {
+        spdlog::error("FlagCatalog: {} has no string 'cname'", source);
+        return std::nullopt;
+    }
+
+    FlagDefinition definition;
+    definition.cname = json["cname"].get<std::string>();
+    definition.duration = std::max(0.0f, json.value("duration", 0.0f));
+
+    if (json.contains("parameters") && json["parameters"].is_object()) {
+        for (const auto &[param, modifierJson] : json["parameters"].items()) {
+            if (!modifierJson.is_object()) {
+                spdlog::warn("FlagCatalog: {} parameter '{}' is not an object; ignoring", source, param);
+                continue;
+            }
+            FlagParameterModifier modifier;
+            modifier.param = param;
+            if (modifierJson.contains("set")) {
+                modifier.set = modifierJson["set"].get<float>();
+            }
+            modifier.multiply = modifierJson.value("multiply", 1.0f);
+            modifier.add = modifierJson.value("add", 0.0f);
+            definition.parameters.push_back(std::move(modifier));
+        }
+    }
+
+    if (json.contains("shots") && json["shots"].is_object()) {
+        const auto &shots = json["shots"];
+        definition.shotCount = std::max(1u, shots.value("count", 1u));
+        definition.shotSpread = std::max(0.0f, shots.value("spread", 0.0f));
+        definition.shotMaxDelay = std::max(0.0f, shots.value("maxDelay", 0.0f));
+        const std::string pattern = shots.value("pattern", std::string("fan"));
+        if (pattern == "cone") {
+            definition.shotPattern = FlagShotPattern::Cone;
+        } else if (pattern != "fan") {
+            spdlog::warn("FlagCatalog: {} has unknown shot pattern '{}'; using fan", source, pattern);
+        }
+    }
+
+    return definition;
+}
+
+// Turns a shot velocity by yaw about world up, then by pitch about the shot's right axis.
+glm::vec3 RotateShot(const glm::vec3 &velocity, float yaw, float pitch) {
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+    glm::vec3 rotated = glm::angleAxis(yaw, up) * velocity;
+    const glm::vec3 right = glm::cross(rotated, up);
+    if (pitch != 0.0f && glm::length(right) > 1e-4f) {
+        rotated = glm::angleAxis(pitch, glm::normalize(right)) * rotated;
+    }
+    return rotated;
+}
+
+} // namespace
+
+const FlagCatalog &FlagCatalog::Shared() {
+    static const FlagCatalog catalog;
+    return catalog;
+}
+
+FlagCatalog::FlagCatalog() {
+    namespace fs = std::filesystem;
+
+    const fs::path flagsDir = karma::data::DataRoot() / "plugins" / "flags";
+    std::error_code ec;
+    if (!fs::is_directory(flagsDir, ec)) {
+        spdlog::debug("FlagCatalog: No flag directory at {}", flagsDir.string());
+        return;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto &entry : fs::directory_iterator(flagsDir, ec)) {
+        const fs::path file = entry.path() / DEFINITION_FILE_NAME;
+        if (entry.is_directory() && fs::exists(file)) {
+            files.push_back(file);
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (const auto &file : files) {
+        auto json = karma::data::LoadJsonFile(file, "flag definition", spdlog::level::warn);
+        if (!json) {
+            continue;
+        }
+        auto definition = ParseDefinition(*json, file.string());
+        if (!definition) {
+            continue;
+        }
+        if (byName_.count(definition->cname) > 0) {
+            spdlog::warn("FlagCatalog: Duplicate flag '{}' in {}; ignoring", definition->cname, file.string());
+            continue;
+        }
+        byName_[definition->cname] = definitions_.size();
+        definitions_.push_back(std::move(*definition));
+    }
+
+    spdlog::info("FlagCatalog: Loaded {} native flag definition(s)", definitions_.size());
+}
+
+const FlagDefinition *FlagCatalog::find(const std::string &cname) const {
+    auto it = byName_.find(cname);
+    if (it == byName_.end()) {
+        return nullptr;
+    }
+    return &definitions_[it->second];
+}
+
+FlagEngine::FlagEngine(Game &game) : game(game), rng(std::random_device{}()) {}
+
+bool FlagEngine::grant(client_id id, const std::string &cname) {
+    const FlagDefinition *definition = FlagCatalog::Shared().find(cname);
+    if (!definition) {
+        spdlog::warn("FlagEngine::grant: Unknown flag '{}'", cname);
+        return false;
+    }
+    Client *client = game.getClient(id);
+    if (!client) {
+        return false;
+    }
+
+    drop(id);
+
+    const PlayerParameterSchema &schema = game.world->parameterSchema();
+    const PlayerParameters &defaults = game.world->defaultPlayerParameters();
+    for (const auto &modifier : definition->parameters) {
+        const PlayerParameterId param = schema.find(modifier.param);
+        if (param == INVALID_PLAYER_PARAMETER) {
+            spdlog::warn("FlagEngine::grant: Flag '{}' modifies unknown parameter '{}'", cname, modifier.param);
+            continue;
+        }
+        const float base = modifier.set ? *modifier.set : defaults[param];
+        client->setParameter(param, base * modifier.multiply + modifier.add);
+    }
+
+    held[id] = HeldFlag{definition, definition->duration};
+    spdlog::debug("FlagEngine::grant: Client id {} now holds '{}'", id, cname);
+    return true;
+}
+
+void FlagEngine::drop(client_id id) {
+    auto it = held.find(id);
+    if (it == held.end()) {
+        return;
+    }
+    const FlagDefinition *definition = it->second.definition;
+    held.erase(it);
+
+    pendingShots.erase(
+        std::remove_if(pendingShots.begin(), pendingShots.end(),
+                       [id](const PendingShot &pending) { return pending.ownerId == id; }),
+        pendingShots.end());
+
+    Client *client = game.getClient(id);
+    if (!client) {
+        return;
+    }
+    const PlayerParameterSchema &schema = game.world->parameterSchema();
+    const PlayerParameters &defaults = game.world->defaultPlayerParameters();
+    for (const auto &modifier : definition->parameters) {
+        const PlayerParameterId param = schema.find(modifier.param);
+        if (param != INVALID_PLAYER_PARAMETER) {
+            client->setParameter(param, defaults[param]);
+        }
+    }
+    spdlog::debug("FlagEngine::drop: Client id {} dropped '{}'", id, definition->cname);
+}
+
+void FlagEngine::forget(client_id id) {
+    held.erase(id);
+    pendingShots.erase(
+        std::remove_if(pendingShots.begin(), pendingShots.end(),
+                       [id](const PendingShot &pending) { return pending.ownerId == id; }),
+        pendingShots.end());
+}
+
+const FlagDefinition *FlagEngine::heldBy(client_id id) const {
+    auto it = held.find(id);
+    return it == held.end() ? nullptr : it->second.definition;
+}
+
+void FlagEngine::onShotFired(client_id ownerId,
+                             const glm::vec3 &position,
+                             const glm::vec3 &velocity,
+                             server_tick rewindTicks) {
+    const FlagDefinition *definition = heldBy(ownerId);
+    if (!definition || definition->shotCount <= 1) {
+        return;
+    }
+
+    const uint32_t extraShots = definition->shotCount - 1;
+    const float spread = definition->shotSpread;
+    std::uniform_real_distribution<float> angle(-spread, spread);
+    std::uniform_real_distribution<float> delay(0.0f, definition->shotMaxDelay);
+
+    for (uint32_t i = 1; i <= extraShots; ++i) {
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        float wait = 0.0f;
+        if (definition->shotPattern == FlagShotPattern::Fan) {
+            // Alternate sides, widening out to the full spread: -1, +1, -2, +2, ...
+            const float steps = std::ceil(static_cast<float>(extraShots) / 2.0f);
+            const float side = (i % 2 == 1) ? -1.0f : 1.0f;
+            yaw = side * static_cast<float>((i + 1) / 2) * spread / steps;
+        } else {
+            yaw = angle(rng);
+            pitch = angle(rng);
+            wait = delay(rng);
+        }
+
+        const glm::vec3 shotVelocity = RotateShot(velocity, yaw, pitch);
+        if (wait > 0.0f) {
+            pendingShots.push_back(PendingShot{ownerId, position, shotVelocity, rewindTicks, wait});
+        } else {
+            game.spawnShot(ownerId, position, shotVelocity, rewindTicks);
+        }
+    }
+}
+
+void FlagEngine::update(TimeUtils::duration deltaTime) {
+    std::vector<client_id> expired;
+    for (auto &[id, flag] : held) {
+        if (flag.definition->duration <= 0.0f) {
+            continue;
+        }
+        flag.remaining -= deltaTime;
+        if (flag.remaining <= 0.0f) {
+            expired.push_back(id);
+        }
+    }
+    for (client_id id : expired) {
+        drop(id);
+    }
+
+    std::vector<PendingShot> ready;
+    for (auto it = pendingShots.begin(); it != pendingShots.end(); ) {
+        it->delay -= deltaTime;
+        if (it->delay <= 0.0f) {
+            ready.push_back(*it);
+            it = pendingShots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto &pending : ready) {
+        game.spawnShot(pending.ownerId, pending.position, pending.velocity, pending.rewindTicks);
+    }
+}
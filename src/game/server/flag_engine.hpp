@@ -0,0 +1,93 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include "game/net/messages.hpp"
+#include "server/lag_compensation.hpp"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Game;
+
+// How a flag changes one player parameter, relative to the world default:
+// value = (set ? *set : default) * multiply + add.
+struct FlagParameterModifier {
+    std::string param;
+    std::optional<float> set;
+    float multiply = 1.0f;
+    float add = 0.0f;
+};
+
+// The fired shot always keeps the client's aim. Its owner already draws it
+// locally, so re-aiming it here would split the owner's view from the hit checks.
+enum class FlagShotPattern {
+    Fan,  // Extra shots spread evenly left and right of the fired one.
+    Cone  // Extra shots at random yaw/pitch inside the spread, optionally staggered.
+};
+
+struct FlagDefinition {
+    std::string cname;
+    // Seconds until the flag drops by itself; 0 keeps it until dropped.
+    float duration = 0.0f;
+    std::vector<FlagParameterModifier> parameters;
+    // Total shots per trigger pull, including the one the client fired.
+    uint32_t shotCount = 1;
+    FlagShotPattern shotPattern = FlagShotPattern::Fan;
+    float shotSpread = 0.0f;   // Radians.
+    float shotMaxDelay = 0.0f; // Seconds.
+};
+
+// Flag definitions read from data/plugins/flags/<Name>/flag.json. Loaded once
+// and read-only afterwards, so any arena or plugin thread may use it.
+class FlagCatalog {
+public:
+    static const FlagCatalog &Shared();
+
+    const FlagDefinition *find(const std::string &cname) const;
+    const std::vector<FlagDefinition> &definitions() const { return definitions_; }
+
+private:
+    FlagCatalog();
+
+    std::vector<FlagDefinition> definitions_;
+    std::unordered_map<std::string, std::size_t> byName_;
+};
+
+// Applies held flags on the tick: parameter modifiers when a flag is granted
+// or dropped, expiry, and extra shots when a flag holder fires.
+class FlagEngine {
+public:
+    explicit FlagEngine(Game &game);
+
+    // Replaces any flag the player already holds.
+    bool grant(client_id id, const std::string &cname);
+    // Restores the player's parameters to the world defaults.
+    void drop(client_id id);
+    // Forgets a player who left, without sending anything.
+    void forget(client_id id);
+    const FlagDefinition *heldBy(client_id id) const;
+
+    void onShotFired(client_id ownerId, const glm::vec3 &position, const glm::vec3 &velocity, server_tick rewindTicks);
+    void update(TimeUtils::duration deltaTime);
+
+private:
+    struct HeldFlag {
+        const FlagDefinition *definition;
+        float remaining;
+    };
+
+    struct PendingShot {
+        client_id ownerId;
+        glm::vec3 position;
+        glm::vec3 velocity;
+        server_tick rewindTicks;
+        float delay;
+    };
+
+    Game &game;
+    std::unordered_map<client_id, HeldFlag> held;
+    std::vector<PendingShot> pendingShots;
+    std::mt19937 rng;
+};
@@ -50,6 +50,9 @@ Game::Game(ServerEngine &engine,
            std::string worldDir,
            bool enableWorldZipping)
     : engine(engine) {
+    lagCompensation = new LagCompensation(SERVER_MIN_TICK_SECONDS);
+    movementValidator = new MovementValidator(*this);
+    inputAuthority = new InputAuthority(*this);
     world = new ServerWorldSession(*this,
                       std::move(serverName),
                       std::move(worldName),
@@ -57,6 +60,7 @@ Game::Game(ServerEngine &engine,
                       std::move(worldDir),
                       enableWorldZipping);
     chat = new Chat(*this);
+    flags = new FlagEngine(*this);
 }
 
 Game::~Game() {
@@ -66,9 +70,27 @@ Game::~Game() {
 
     delete world;
     delete chat;
+    delete lagCompensation;
+    delete movementValidator;
+    delete inputAuthority;
+    delete flags;
+}
+
+shot_id Game::spawnShot(client_id ownerId, glm::vec3 position, glm::vec3 velocity, server_tick rewindTicks) {
+    auto shot = std::make_unique<Shot>(*this, ownerId, 0, position, velocity, rewindTicks, true);
+    const shot_id globalShotId = shot->getGlobalId();
+    shots.push_back(std::move(shot));
+
+    Event_CreateShot event;
+    event.shotId = globalShotId;
+    g_triggerPluginEvent<Event_CreateShot>(EventType_CreateShot, event);
+    return globalShotId;
 }
 
 void Game::update(TimeUtils::duration deltaTime) {
+    lagCompensation->beginTick(deltaTime);
+    PluginAPI::beginTick();
+
     for (const auto &connMsg : engine.network->consumeMessages<ClientMsg_PlayerJoin>()) {
         spdlog::debug("Game::update: New client connection with id {} from IP {}",
                       connMsg.clientId,
@@ -110,6 +132,7 @@ void Game::update(TimeUtils::duration deltaTime) {
 
     for (const auto &disconnMsg : engine.network->consumeMessages<ClientMsg_PlayerLeave>()) {
         spdlog::info("Game::update: Client with id {} disconnected", disconnMsg.clientId);
+        flags->forget(disconnMsg.clientId);
         removeClient(disconnMsg.clientId);
 
         Event_PlayerLeave event;
@@ -124,32 +147,53 @@ void Game::update(TimeUtils::duration deltaTime) {
         event.fromId = chatMsg.clientId;
         event.toId = chatMsg.toId;
         event.message = chatMsg.text;
-        bool handled = g_triggerPluginEvent<Event_Chat>(EventType_Chat, event);
-        if (handled) {
-            return;
+        g_triggerPluginVeto<Event_Chat>(EventType_Chat, event, [this, event](bool allowed) {
+            if (!allowed) {
+                return;
+            }
+            ServerMsg_Chat serverChatMsg;
+            serverChatMsg.fromId = event.fromId;
+            serverChatMsg.toId = event.toId;
+            serverChatMsg.text = event.message;
+
+            if (event.toId == BROADCAST_CLIENT_ID) {
+                engine.network->sendExcept<ServerMsg_Chat>(event.fromId, &serverChatMsg);
+            } else {
+                engine.network->send<ServerMsg_Chat>(event.toId, &serverChatMsg);
+            }
+        });
+    }
+
+    for (const auto &locMsg : engine.network->consumeMessages<ClientMsg_PlayerLocation>()) {
+        Client *client = getClient(locMsg.clientId);
+        if (!client) {
+            continue;
         }
 
-        ServerMsg_Chat serverChatMsg;
-        serverChatMsg.fromId = chatMsg.clientId;
-        serverChatMsg.toId = chatMsg.toId;
-        serverChatMsg.text = chatMsg.text;
+        // With server movement the position comes from the client's input instead.
+        if (inputAuthority->isEnabled()) {
+            continue;
+        }
 
-        if (chatMsg.toId == BROADCAST_CLIENT_ID) {
-            engine.network->sendExcept<ServerMsg_Chat>(chatMsg.clientId, &serverChatMsg);
+        if (movementValidator->isEnabled()) {
+            movementValidator->submit(*client, locMsg.position, locMsg.rotation, locMsg.velocity);
         } else {
-            engine.network->send<ServerMsg_Chat>(chatMsg.toId, &serverChatMsg);
+            client->applyLocation(locMsg.position, locMsg.rotation, locMsg.velocity);
         }
     }
 
-    for (const auto &locMsg : engine.network->consumeMessages<ClientMsg_PlayerLocation>()) {
-        Client *client = getClient(locMsg.clientId);
-        if (!client) {
+    movementValidator->update(deltaTime);
+
+    for (const auto &inputMsg : engine.network->consumeMessages<ClientMsg_PlayerInput>()) {
+        Client *client = getClient(inputMsg.clientId);
+        if (!client || !inputAuthority->isEnabled()) {
             continue;
         }
-
-        client->applyLocation(locMsg.position, locMsg.rotation);
+        inputAuthority->submit(*client, inputMsg);
     }
 
+    inputAuthority->update(deltaTime);
+
     for (const auto &spawnMsg : engine.network->consumeMessages<ClientMsg_RequestPlayerSpawn>()) {
         Client *client = getClient(spawnMsg.clientId);
         if (!client) {
@@ -158,16 +202,29 @@ void Game::update(TimeUtils::duration deltaTime) {
 
         Event_PlayerSpawn event;
         event.playerId = spawnMsg.clientId;
-        bool handled = g_triggerPluginEvent<Event_PlayerSpawn>(EventType_PlayerSpawn, event);
-        if (handled) {
-            continue;
-        }
+        g_triggerPluginVeto<Event_PlayerSpawn>(EventType_PlayerSpawn, event, [this, playerId = event.playerId](bool allowed) {
+            // A deferred answer can arrive after the player left.
+            Client *spawning = allowed ? getClient(playerId) : nullptr;
+            if (spawning && spawning->trySpawn(world->pickSpawnLocation(playerId))) {
+                movementValidator->teleport(*spawning);
+                inputAuthority->teleport(*spawning);
+            }
+        });
+    }
 
-        client->trySpawn(world->pickSpawnLocation());
+    // Snapshot every player once per tick so shots can be checked against
+    // where targets were from the shooter's point of view.
+    const server_tick tick = lagCompensation->currentTick();
+    for (const auto &client : clients) {
+        client->recordHistory(tick);
     }
 
+    flags->update(deltaTime);
+
     for (const auto &shotMsg : engine.network->consumeMessages<ClientMsg_CreateShot>()) {
         shot_id globalShotId = 0;
+        const server_tick rewindTicks =
+            lagCompensation->rewindTicksFor(engine.network->getClientRoundTripMs(shotMsg.clientId));
 
         // Make the shot here before pushing it (using unique pointer)
         auto shot = std::make_unique<Shot>(
@@ -175,7 +232,8 @@ void Game::update(TimeUtils::duration deltaTime) {
             shotMsg.clientId,
             shotMsg.localShotId,
             shotMsg.position,
-            shotMsg.velocity
+            shotMsg.velocity,
+            rewindTicks
         );
         globalShotId = shot->getGlobalId();
         shots.push_back(std::move(shot));
@@ -183,43 +241,55 @@ void Game::update(TimeUtils::duration deltaTime) {
         Event_CreateShot event;
         event.shotId = globalShotId;
         g_triggerPluginEvent<Event_CreateShot>(EventType_CreateShot, event);
+
+        flags->onShotFired(shotMsg.clientId, shotMsg.position, shotMsg.velocity, rewindTicks);
     }
 
+    shotQueries.clear();
+    for (const auto &shot : shots) {
+        shotQueries.rays.push_back(shot->movementRay(deltaTime));
+    }
+    engine.physics->query(shotQueries, shotHits);
+
+    std::size_t shotIndex = 0;
     for (auto it = shots.begin(); it != shots.end(); ) {
         Shot *shot = it->get();
-        shot->update(deltaTime);
+        shot->update(deltaTime, shotHits.rays[shotIndex++]);
 
         bool expired = shot->isExpired();
         bool hit = false;
         if (!expired) {
             for (const auto &client : clients) {
-                if (client->getState().alive == false) {
+                if (client->getState().alive == false || pendingDeaths.count(client->getId()) > 0) {
                     continue;
                 }
 
-                if (shot->hits(client.get())) {
+                const glm::vec3 targetPosition = lagCompensation->rewindPosition(*client, shot->getRewindTicks());
+                if (shot->hits(targetPosition)) {
                     client_id victimId = client->getId();
                     client_id killerId = shot->getOwnerId();
 
-                    // Apply authoritative score changes
-                    if (Client* killer = getClient(killerId)) {
-                        if (killerId != victimId) {
-                            killer->setScore(killer->getScore() + 1);
-                        }
-                    }
-
                     Event_PlayerDie event;
                     event.victimPlayerId = victimId;
                     event.shotId = shot->getGlobalId();
-                    bool handled = g_triggerPluginEvent<Event_PlayerDie>(EventType_PlayerDie, event);
-
-                    if (handled) {
-                        break;
-                    }
+                    // Until a deferred verdict arrives the victim can't be hit again.
+                    pendingDeaths.insert(victimId);
+                    const PluginVerdict verdict = g_triggerPluginVeto<Event_PlayerDie>(EventType_PlayerDie, event, [this, victimId, killerId](bool allowed) {
+                        pendingDeaths.erase(victimId);
+                        Client *victim = allowed ? getClient(victimId) : nullptr;
+                        if (victim && victim->getState().alive) {
+                            // Apply authoritative score changes
+                            Client *killer = getClient(killerId);
+                            if (killer && killerId != victimId) {
+                                killer->setScore(killer->getScore() + 1);
+                            }
+                            victim->setScore(victim->getScore() - 1);
+                            victim->die();
+                        }
+                    });
 
-                    client->setScore(client->getScore() - 1);
-                    client->die();
-                    hit = true;
+                    // A vetoed shot flies on; a deferred one is spent either way.
+                    hit = verdict != PluginVerdict::Vetoed;
                     break;
                 }
             }
@@ -232,5 +302,9 @@ void Game::update(TimeUtils::duration deltaTime) {
         }
     }
 
+    PluginAPI::endTick();
+    for (const auto &client : clients) {
+        client->flushParameterChanges();
+    }
     world->update();
 }
@@ -6,9 +6,18 @@
 #include "shot.hpp"
 #include "world_session.hpp"
 #include "chat.hpp"
+#include "lag_compensation.hpp"
+#include "movement_validator.hpp"
+#include "input_authority.hpp"
+#include "flag_engine.hpp"
+#include <atomic>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 
+// Shortest server tick; the main and arena loops sleep until this much time has passed.
+constexpr TimeUtils::duration SERVER_MIN_TICK_SECONDS = 1.0f / 120.0f;
+
 class Game {
 private:
     std::vector<std::unique_ptr<Client>> clients;
@@ -16,9 +25,13 @@ private:
     void removeClient(client_id id);
 
     std::vector<std::unique_ptr<Shot>> shots;
+    PhysicsQueryBatch shotQueries;
+    PhysicsQueryResults shotHits;
+    // Victims whose death a plugin host has not ruled on yet.
+    std::unordered_set<client_id> pendingDeaths;
 
     client_id getNextClientId() {
-        static client_id nextId = 4;
+        static std::atomic<client_id> nextId{4};
         return nextId++;
     }
 
@@ -26,6 +39,10 @@ public:
     ServerEngine &engine;
     ServerWorldSession *world;
     Chat *chat;
+    LagCompensation *lagCompensation;
+    MovementValidator *movementValidator;
+    InputAuthority *inputAuthority;
+    FlagEngine *flags;
 
     const std::vector<std::unique_ptr<Client>> &getClients() const { return clients; }
     Client *getClient(client_id id);
@@ -40,5 +57,8 @@ public:
             bool enableWorldZipping);
     ~Game();
 
+    // Adds a shot fired on a player's behalf by the server rather than by their client.
+    shot_id spawnShot(client_id ownerId, glm::vec3 position, glm::vec3 velocity, server_tick rewindTicks);
+
     void update(TimeUtils::duration deltaTime);
 };
@@ -0,0 +1,214 @@
+#include "server/input_authority.hpp"
+#include "server/game.hpp"
+#include "game/common/tank_movement.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Inputs buffered per client beyond what the server has simulated yet.
+constexpr std::size_t MAX_QUEUED_INPUTS = 64;
+// Longest single input step, and the most unspent time a client may bank.
+constexpr TimeUtils::duration MAX_INPUT_STEP = 0.1f;
+constexpr TimeUtils::duration MAX_CREDIT = 0.25f;
+
+float paramOr(const PlayerParameters &params, PlayerParameterId id, float fallback) {
+    return id < params.size() ? params[id] : fallback;
+}
+
+} // namespace
+
+InputAuthority::InputAuthority(Game &game) : game(game) {
+    const std::string authority = karma::config::ReadStringConfig("movement.Authority", "client");
+    if (authority == "server") {
+        enabled = true;
+    } else if (authority != "client") {
+        spdlog::warn("InputAuthority: Unknown movement authority '{}', falling back to 'client'", authority);
+    }
+
+    // Query-only backends (bvh) cannot simulate characters; every position
+    // would come out as the origin, so stay with client movement instead.
+    if (enabled && !game.engine.physics->createPlayerController(glm::vec3(1.0f, 2.0f, 1.0f)).isValid()) {
+        spdlog::error("InputAuthority: The physics backend cannot simulate players, "
+                      "server-authoritative movement stays disabled");
+        enabled = false;
+    }
+
+    if (enabled) {
+        spdlog::info("InputAuthority: Server-authoritative movement enabled");
+    }
+}
+
+InputAuthority::~InputAuthority() {
+    tracked.clear();
+}
+
+InputAuthority::Tracked &InputAuthority::track(const Client &client) {
+    auto it = tracked.find(client.getId());
+    if (it != tracked.end()) {
+        return it->second;
+    }
+
+    if (!paramIdsResolved) {
+        const PlayerParameterSchema &schema = game.world->parameterSchema();
+        paramIds.speed = schema.find("speed");
+        paramIds.turnSpeed = schema.find("turnSpeed");
+        paramIds.jumpSpeed = schema.find("jumpSpeed");
+        paramIds.xExtent = schema.find("x_extent");
+        paramIds.yExtent = schema.find("y_extent");
+        paramIds.zExtent = schema.find("z_extent");
+        paramIdsResolved = true;
+    }
+
+    const PlayerParameters &params = client.getState().params;
+    const glm::vec3 size(paramOr(params, paramIds.xExtent, 1.0f),
+                         paramOr(params, paramIds.yExtent, 2.0f),
+                         paramOr(params, paramIds.zExtent, 1.0f));
+
+    Tracked entry;
+    entry.controller = game.engine.physics->createPlayerController(size);
+    entry.controller.setPosition(client.getPosition());
+    entry.controller.setRotation(client.getState().rotation);
+    return tracked.emplace(client.getId(), std::move(entry)).first->second;
+}
+
+void InputAuthority::submit(const Client &client, const ClientMsg_PlayerInput &input) {
+    Tracked &entry = track(client);
+    if (input.sequence <= entry.lastSequence ||
+        (!entry.queue.empty() && input.sequence <= entry.queue.back().sequence)) {
+        return;
+    }
+    if (entry.queue.size() >= MAX_QUEUED_INPUTS) {
+        ++entry.droppedInputs;
+        spdlog::debug("InputAuthority: Client id {} input queue full, dropping sequence {} (dropped: {})",
+                      client.getId(),
+                      input.sequence,
+                      entry.droppedInputs);
+        return;
+    }
+    entry.queue.push_back(input);
+}
+
+void InputAuthority::teleport(const Client &client) {
+    if (!enabled) {
+        return;
+    }
+
+    Tracked &entry = track(client);
+    entry.controller.setPosition(client.getPosition());
+    entry.controller.setRotation(client.getState().rotation);
+    entry.controller.setVelocity(glm::vec3(0.0f));
+    entry.controller.setAngularVelocity(glm::vec3(0.0f));
+    if (!entry.queue.empty()) {
+        entry.lastSequence = entry.queue.back().sequence;
+        entry.queue.clear();
+    }
+    entry.credit = 0.0f;
+}
+
+void InputAuthority::update(TimeUtils::duration deltaTime) {
+    if (!enabled) {
+        return;
+    }
+
+    std::vector<std::pair<Client *, Tracked *>> active;
+    active.reserve(tracked.size());
+    for (auto it = tracked.begin(); it != tracked.end();) {
+        Client *client = game.getClient(it->first);
+        if (!client) {
+            it = tracked.erase(it);
+            continue;
+        }
+        Tracked &entry = it->second;
+        ++it;
+
+        entry.credit = std::min(entry.credit + deltaTime, MAX_CREDIT);
+        entry.stepped = false;
+        if (!entry.queue.empty()) {
+            active.emplace_back(client, &entry);
+        }
+    }
+
+    // Each round takes the next input of every client with input and credit
+    // left, so all characters are still stepped in one batch per round.
+    std::vector<PhysicsPlayerStep> steps;
+    steps.reserve(active.size());
+    while (!active.empty()) {
+        steps.clear();
+        for (auto it = active.begin(); it != active.end();) {
+            Client *client = it->first;
+            Tracked &entry = *it->second;
+            if (entry.queue.empty() || entry.credit <= 0.0f) {
+                it = active.erase(it);
+                continue;
+            }
+            ++it;
+
+            ClientMsg_PlayerInput &input = entry.queue.front();
+            if (!client->getState().alive) {
+                entry.lastSequence = input.sequence;
+                entry.queue.pop_front();
+                continue;
+            }
+
+            // Without enough credit the input runs for what is left and the
+            // rest stays at the front for the next tick.
+            const TimeUtils::duration remaining = std::min(std::max(input.deltaTime, 0.0f), MAX_INPUT_STEP);
+            const TimeUtils::duration stepTime = std::min(remaining, entry.credit);
+            entry.credit -= stepTime;
+
+            game_common::TankInput tankInput{input.movement, false};
+            if (input.jump && entry.sinceJump >= game_common::TANK_JUMP_COOLDOWN &&
+                entry.controller.isGrounded()) {
+                tankInput.jump = true;
+                entry.sinceJump = 0.0f;
+            }
+            entry.sinceJump += stepTime;
+
+            const PlayerParameters &params = client->getState().params;
+            game_common::TankMovementParams movement;
+            movement.speed = paramOr(params, paramIds.speed, 0.0f);
+            movement.turnSpeed = paramOr(params, paramIds.turnSpeed, 0.0f);
+            movement.jumpSpeed = paramOr(params, paramIds.jumpSpeed, 0.0f);
+            game_common::ApplyTankInput(entry.controller, tankInput, movement);
+
+            if (stepTime < remaining) {
+                input.deltaTime = remaining - stepTime;
+                // The jump was taken (or refused) on the first part.
+                input.jump = false;
+            } else {
+                entry.lastSequence = input.sequence;
+                entry.queue.pop_front();
+            }
+
+            steps.push_back({&entry.controller, stepTime});
+            entry.stepped = true;
+        }
+
+        if (!steps.empty()) {
+            game.engine.physics->updatePlayers(steps);
+        }
+    }
+
+    for (auto &[id, entry] : tracked) {
+        if (!entry.stepped) {
+            continue;
+        }
+        Client *client = game.getClient(id);
+        if (!client) {
+            continue;
+        }
+
+        ServerMsg_InputAck ack;
+        ack.sequence = entry.lastSequence;
+        ack.position = entry.controller.getPosition();
+        ack.rotation = entry.controller.getRotation();
+        ack.velocity = entry.controller.getVelocity();
+        client->applyLocation(ack.position, ack.rotation, ack.velocity);
+        game.engine.network->send<ServerMsg_InputAck>(id, &ack);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include "game/net/messages.hpp"
+#include "karma/physics/player_controller.hpp"
+#include "game/common/tank_movement.hpp"
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+class Game;
+class Client;
+
+// Opt-in server-authoritative movement (movement.Authority = "server").
+// Clients send their driving input instead of their position; every input is
+// run through a server-side character with the same ApplyTankInput the client
+// predicts with, and the result is acked back to the owner for reconciliation.
+// Each client may only simulate as much time as has passed on the server, so
+// speed hacks and input flooding cannot move a tank faster than real time.
+class InputAuthority {
+private:
+    struct Tracked {
+        PhysicsPlayerController controller;
+        std::deque<ClientMsg_PlayerInput> queue;
+        // Seconds of simulation this client may still consume.
+        TimeUtils::duration credit = 0.0f;
+        // Last fully consumed input; the queue front may be partly run already.
+        uint32_t lastSequence = 0;
+        // Simulated seconds since the last jump, for the jump cooldown.
+        TimeUtils::duration sinceJump = game_common::TANK_JUMP_COOLDOWN;
+        bool stepped = false;
+        uint64_t droppedInputs = 0;
+    };
+
+    Game &game;
+    bool enabled = false;
+    std::unordered_map<client_id, Tracked> tracked;
+
+    struct ParameterIds {
+        PlayerParameterId speed = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId turnSpeed = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId jumpSpeed = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId xExtent = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId yExtent = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId zExtent = INVALID_PLAYER_PARAMETER;
+    };
+    ParameterIds paramIds;
+    bool paramIdsResolved = false;
+
+    Tracked &track(const Client &client);
+
+public:
+    InputAuthority(Game &game);
+    ~InputAuthority();
+
+    bool isEnabled() const { return enabled; }
+
+    void submit(const Client &client, const ClientMsg_PlayerInput &input);
+    // Moves the server character to the client's state and forgets queued input, e.g. on spawn.
+    void teleport(const Client &client);
+    void update(TimeUtils::duration deltaTime);
+};
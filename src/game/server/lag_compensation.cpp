@@ -0,0 +1,116 @@
+#include "server/lag_compensation.hpp"
+#include "server/client.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PlayerHistory::PlayerHistory(std::size_t capacity)
+    : samples(std::max<std::size_t>(capacity, 1)) {
+}
+
+void PlayerHistory::record(server_tick tick, const PlayerState &state, const glm::vec3 &position) {
+    PlayerHistorySample &sample = samples[tick % samples.size()];
+    sample.tick = tick;
+    sample.position = position;
+    sample.rotation = state.rotation;
+    sample.alive = state.alive;
+    sample.valid = true;
+
+    newestTick = tick;
+    empty = false;
+}
+
+std::optional<PlayerHistorySample> PlayerHistory::sampleAt(server_tick tick) const {
+    if (empty) {
+        return std::nullopt;
+    }
+
+    const server_tick cap = static_cast<server_tick>(samples.size());
+    if (tick > newestTick) {
+        tick = newestTick;
+    }
+    if (newestTick - tick >= cap) {
+        tick = newestTick - cap + 1;
+    }
+
+    // Ticks missing from the ring (late join, skipped record) resolve to the
+    // next newer sample we do have.
+    for (server_tick t = tick; ; ++t) {
+        const PlayerHistorySample &sample = samples[t % cap];
+        if (sample.valid && sample.tick == t) {
+            return sample;
+        }
+        if (t == newestTick) {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+void PlayerHistory::clear() {
+    for (auto &sample : samples) {
+        sample.valid = false;
+    }
+    newestTick = 0;
+    empty = true;
+}
+
+LagCompensation::LagCompensation(TimeUtils::duration minTickSeconds) {
+    enabled = karma::config::ReadBoolConfig({"lagCompensation.Enabled"}, true);
+    const float maxRewindMs = karma::config::ReadFloatConfig({"lagCompensation.MaxRewindMs"}, 250.0f);
+
+    maxRewindSeconds = std::max(0.0f, maxRewindMs) / 1000.0f;
+    // One extra slot so the oldest rewindable tick is never the one being overwritten.
+    const float tickSeconds = std::max(static_cast<float>(minTickSeconds), 1e-3f);
+    historyCapacity_ = static_cast<std::size_t>(std::ceil(maxRewindSeconds / tickSeconds)) + 2;
+    tickTimes.assign(historyCapacity_, -std::numeric_limits<double>::infinity());
+
+    spdlog::debug("LagCompensation: enabled={}, max rewind {} ms, {} history slots per player",
+                  enabled,
+                  maxRewindMs,
+                  historyCapacity_);
+}
+
+void LagCompensation::beginTick(TimeUtils::duration deltaTime) {
+    ++currentTick_;
+    serverTime += static_cast<double>(deltaTime);
+    tickTimes[currentTick_ % tickTimes.size()] = serverTime;
+}
+
+server_tick LagCompensation::rewindTicksFor(std::optional<uint32_t> roundTripMs) const {
+    if (!enabled || !roundTripMs.has_value()) {
+        return 0;
+    }
+
+    // Positions are recorded when they reach the server. The shooter saw them
+    // half a round trip later, and its shot needs another half to arrive, so
+    // the full RTT is how far behind the shooter's view is.
+    const double rewindSeconds = std::min(static_cast<double>(*roundTripMs) / 1000.0,
+                                          static_cast<double>(maxRewindSeconds));
+    const double targetTime = serverTime - rewindSeconds;
+
+    const server_tick maxTicks = std::min<server_tick>(static_cast<server_tick>(tickTimes.size() - 1), currentTick_);
+    server_tick ticks = 0;
+    while (ticks < maxTicks) {
+        const double previousTime = tickTimes[(currentTick_ - ticks - 1) % tickTimes.size()];
+        if (previousTime < targetTime) {
+            break;
+        }
+        ++ticks;
+    }
+    return ticks;
+}
+
+glm::vec3 LagCompensation::rewindPosition(const Client &client, server_tick rewindTicks) const {
+    if (!enabled || rewindTicks == 0) {
+        return client.getPosition();
+    }
+
+    const auto sample = client.getHistory().sampleAt(currentTick_ - std::min(rewindTicks, currentTick_));
+    if (!sample.has_value() || !sample->alive) {
+        return client.getPosition();
+    }
+    return sample->position;
+}
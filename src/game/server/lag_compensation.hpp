@@ -0,0 +1,64 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include "game/net/messages.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using server_tick = uint32_t;
+
+class Client;
+
+struct PlayerHistorySample {
+    server_tick tick = 0;
+    glm::vec3 position{0.0f};
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+    bool alive = false;
+    bool valid = false;
+};
+
+// Fixed-size ring of per-tick player poses; slot = tick % capacity.
+class PlayerHistory {
+private:
+    std::vector<PlayerHistorySample> samples;
+    server_tick newestTick = 0;
+    bool empty = true;
+
+public:
+    explicit PlayerHistory(std::size_t capacity);
+
+    // position is the pose at this tick, which may be extrapolated past state.position.
+    void record(server_tick tick, const PlayerState &state, const glm::vec3 &position);
+    std::optional<PlayerHistorySample> sampleAt(server_tick tick) const;
+    void clear();
+
+    std::size_t capacity() const { return samples.size(); }
+};
+
+class LagCompensation {
+private:
+    bool enabled = true;
+    float maxRewindSeconds = 0.25f;
+    std::size_t historyCapacity_ = 1;
+
+    server_tick currentTick_ = 0;
+    double serverTime = 0.0;
+    std::vector<double> tickTimes;
+
+public:
+    // minTickSeconds is the shortest tick the server loop runs, which bounds
+    // how many ticks fit in the rewind window.
+    explicit LagCompensation(TimeUtils::duration minTickSeconds);
+
+    void beginTick(TimeUtils::duration deltaTime);
+
+    bool isEnabled() const { return enabled; }
+    server_tick currentTick() const { return currentTick_; }
+    // Seconds since the first tick, advanced by each tick's deltaTime.
+    double getServerTime() const { return serverTime; }
+    std::size_t historyCapacity() const { return historyCapacity_; }
+
+    server_tick rewindTicksFor(std::optional<uint32_t> roundTripMs) const;
+    glm::vec3 rewindPosition(const Client &client, server_tick rewindTicks) const;
+};
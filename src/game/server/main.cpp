@@ -7,12 +7,15 @@
 #include "server/terminal_commands.hpp"
 #include "server/server_cli_options.hpp"
 #include "server/community_heartbeat.hpp"
+#include "server/arena.hpp"
+#include "server/server_benchmarks.hpp"
 #include "game/common/data_path_spec.hpp"
 #include "karma/common/data_dir_override.hpp"
 #include "karma/common/data_path_resolver.hpp"
 #include "karma/common/config_helpers.hpp"
 #include "karma/common/config_store.hpp"
 #include "karma/common/json.hpp"
+#include "karma/physics/backend.hpp"
 #include <pybind11/embed.h>
 #include <csignal>
 #include <atomic>
@@ -21,10 +24,13 @@
 #include <poll.h>
 #include <unistd.h>
 #include <filesystem>
+#include <future>
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <sstream>
 #include <vector>
 
-#define MIN_FRAME_HZ (1.0f / 120.0f)
-
 spdlog::level::level_enum ParseLogLevel(const std::string &level) {
     if (level == "trace") {
         return spdlog::level::trace;
@@ -61,8 +67,9 @@ void ConfigureLogging(spdlog::level::level_enum level, bool includeTimestamp) {
 
 std::atomic<bool> g_running{true};
 namespace py = pybind11;
-Game* g_game = nullptr;
-ServerEngine* g_engine = nullptr;
+// Thread-local so that each arena thread in host mode sees its own instance.
+thread_local Game* g_game = nullptr;
+thread_local ServerEngine* g_engine = nullptr;
 
 /**
  * Signal handler for graceful shutdown.
@@ -89,8 +96,8 @@ public:
     void onShutdown(karma::app::EngineContext &) override {}
 
     void onUpdate(karma::app::EngineContext &, float dt) override {
-        if (dt < MIN_FRAME_HZ) {
-            TimeUtils::sleep(MIN_FRAME_HZ - dt);
+        if (dt < SERVER_MIN_TICK_SECONDS) {
+            TimeUtils::sleep(SERVER_MIN_TICK_SECONDS - dt);
             return;
         }
 
@@ -124,6 +131,148 @@ private:
     struct pollfd pfd_ = { STDIN_FILENO, POLLIN, 0 };
 };
 
+// Redirect Python bytecode to a writable temp (or configured) directory
+void ConfigurePythonBytecodeCache() {
+    namespace fs = std::filesystem;
+    py::module_ sys = py::module_::import("sys");
+
+    fs::path pycachePrefix;
+    if (const char *envPrefix = std::getenv("KARMA_PY_CACHE_DIR")) {
+        pycachePrefix = fs::path(envPrefix);
+    } else {
+        pycachePrefix = fs::temp_directory_path() / "bz3-pycache";
+    }
+
+    std::error_code ec;
+    fs::create_directories(pycachePrefix, ec);
+    if (!ec) {
+        sys.attr("pycache_prefix") = pycachePrefix.string();
+        spdlog::info("Python bytecode cache set to {}", pycachePrefix.string());
+    } else {
+        sys.attr("dont_write_bytecode") = true;
+        spdlog::warn("Failed to create pycache dir {}; disabling bytecode write ({}).", pycachePrefix.string(), ec.message());
+    }
+}
+
+/**
+ * Hosts every arena from the server config in one process, each on its own
+ * tick thread. The main thread only reads terminal input and routes
+ * "arena <name> <command>" lines to the matching arena.
+ */
+// How long the host console waits for an arena's reply before moving on; a
+// busy arena (world load, slow plugin) answers later instead of freezing it.
+constexpr std::chrono::milliseconds ARENA_REPLY_WAIT{500};
+
+struct PendingArenaReply {
+    std::string arena;
+    std::future<std::string> reply;
+};
+
+std::string TakeArenaReply(PendingArenaReply &pending) {
+    try {
+        return pending.reply.get();
+    } catch (const std::future_error &) {
+        return "Arena '" + pending.arena + "' stopped before answering.";
+    }
+}
+
+int RunArenaHost(const ServerCLIOptions &cliOptions) {
+    std::vector<ArenaSpec> specs = Arena::LoadSpecs(karma::config::ConfigStore::Merged());
+    if (specs.empty()) {
+        spdlog::error("main: -A/--arenas given but no usable entries under 'arenas' in the server config");
+        return 1;
+    }
+    // Arenas tick concurrently; their physics worlds share one job pool.
+    physics_backend::SetConcurrentWorlds(specs.size() > 1);
+
+    py::scoped_interpreter guard{};
+    ConfigurePythonBytecodeCache();
+    // Arena threads take the GIL whenever they call into Python.
+    py::gil_scoped_release releaseGil;
+
+    const std::string communityOverride = cliOptions.communityExplicit ? cliOptions.community : std::string();
+    std::vector<std::unique_ptr<Arena>> arenas;
+    for (auto &spec : specs) {
+        arenas.push_back(std::make_unique<Arena>(std::move(spec), communityOverride));
+        arenas.back()->start();
+    }
+
+    spdlog::info("main: Hosting {} arenas", arenas.size());
+    std::cout << "> " << std::flush;
+
+    std::vector<PendingArenaReply> pendingReplies;
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    while (g_running) {
+        for (auto it = pendingReplies.begin(); it != pendingReplies.end();) {
+            if (it->reply.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+            std::cout << "\n[" << it->arena << "] " << TakeArenaReply(*it) << "\n> " << std::flush;
+            it = pendingReplies.erase(it);
+        }
+
+        if (poll(&pfd, 1, 100) <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        std::string line;
+        if (!std::getline(std::cin, line)) {
+            continue;
+        }
+
+        std::string response;
+        std::istringstream iss(line);
+        std::string cmd;
+        iss >> cmd;
+        if (cmd == "quit" || cmd == "exit") {
+            g_running = false;
+            response = "Shutting down server...";
+        } else if (cmd == "listArenas") {
+            response = "Arenas:";
+            for (const auto &arena : arenas) {
+                response += "\n - " + arena->getSpec().name +
+                            " (port " + std::to_string(arena->getSpec().port) + ", " +
+                            (arena->isRunning() ? "running" : "stopped") + ")";
+            }
+        } else if (cmd == "arena") {
+            std::string name;
+            iss >> name;
+            std::string rest;
+            std::getline(iss >> std::ws, rest);
+            auto it = std::find_if(arenas.begin(), arenas.end(), [&name](const std::unique_ptr<Arena> &arena) {
+                return arena->getSpec().name == name;
+            });
+            if (name.empty() || rest.empty()) {
+                response = "Usage: arena <name> <command>";
+            } else if (it == arenas.end()) {
+                response = "Unknown arena '" + name + "'";
+            } else {
+                PendingArenaReply pending{name, (*it)->submitCommand(rest)};
+                if (pending.reply.wait_for(ARENA_REPLY_WAIT) == std::future_status::ready) {
+                    response = TakeArenaReply(pending);
+                } else {
+                    response = "Arena '" + name + "' is busy; its reply will be printed when it arrives.";
+                    pendingReplies.push_back(std::move(pending));
+                }
+            }
+        } else if (!cmd.empty()) {
+            response = "Host mode commands: listArenas, arena <name> <command>, quit";
+        }
+
+        if (!response.empty()) {
+            std::cout << response << std::endl;
+        }
+        std::cout << "> " << std::flush;
+    }
+
+    for (auto &arena : arenas) {
+        arena->stop();
+    }
+    spdlog::info("Server shutdown complete");
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     ConfigureLogging(spdlog::level::info, false);
 
@@ -156,6 +305,10 @@ int main(int argc, char *argv[]) {
            : spdlog::level::info);
     ConfigureLogging(logLevel, cliOptions.timestampLogging);
 
+    if (cliOptions.hostArenas) {
+        return RunArenaHost(cliOptions);
+    }
+
     if (!cliOptions.worldSpecified) {
         spdlog::error("No world directory specified. Use -w <directory> or -D to load the bundled default world.");
         return 1;
@@ -206,6 +359,10 @@ int main(int argc, char *argv[]) {
     g_engine = &engine;
     g_game = &game;
 
+    if (!cliOptions.benchmark.empty()) {
+        return RunServerBenchmark(cliOptions.benchmark, game);
+    }
+
     ServerDiscoveryBeacon discoveryBeacon(port, serverName, worldName);
 
     CommunityHeartbeat communityHeartbeat;
@@ -214,30 +371,17 @@ int main(int argc, char *argv[]) {
 
     spdlog::trace("Loading plugins...");
     py::scoped_interpreter guard{};
-
-    // Redirect Python bytecode to a writable temp (or configured) directory
-    {
-        namespace fs = std::filesystem;
-        py::module_ sys = py::module_::import("sys");
-
-        fs::path pycachePrefix;
-        if (const char *envPrefix = std::getenv("KARMA_PY_CACHE_DIR")) {
-            pycachePrefix = fs::path(envPrefix);
-        } else {
-            pycachePrefix = fs::temp_directory_path() / "bz3-pycache";
-        }
-
-        std::error_code ec;
-        fs::create_directories(pycachePrefix, ec);
-        if (!ec) {
-            sys.attr("pycache_prefix") = pycachePrefix.string();
-            spdlog::info("Python bytecode cache set to {}", pycachePrefix.string());
-        } else {
-            sys.attr("dont_write_bytecode") = true;
-            spdlog::warn("Failed to create pycache dir {}; disabling bytecode write ({}).", pycachePrefix.string(), ec.message());
-        }
+    ConfigurePythonBytecodeCache();
+    // In thread mode only the host's worker runs Python, so this thread lets go of the GIL.
+    std::optional<py::gil_scoped_release> releaseGil;
+    std::unique_ptr<PluginHost> pluginHost;
+    if (PluginHost::Enabled()) {
+        releaseGil.emplace();
+        pluginHost = std::make_unique<PluginHost>(mergedConfig, false);
+    } else {
+        PluginAPI::loadPythonPlugins(mergedConfig);
     }
-    PluginAPI::loadPythonPlugins(mergedConfig);
+    NativePlugins::load(mergedConfig);
     spdlog::trace("Plugins loaded successfully");
 
     spdlog::trace("Starting main loop");
@@ -248,6 +392,8 @@ int main(int argc, char *argv[]) {
     app.context().physics = engine.physics;
     app.setGame(&adapter);
     const int result = app.run();
+    NativePlugins::unload();
+    pluginHost.reset();
     spdlog::info("Server shutdown complete");
     return result;
 }
@@ -0,0 +1,189 @@
+#include "server/movement_validator.hpp"
+#include "server/game.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Longest gap between two reports that is replayed as a single character step.
+constexpr TimeUtils::duration MAX_STEP_SECONDS = 0.25f;
+
+float paramOr(const PlayerParameters &params, PlayerParameterId id, float fallback) {
+    return id < params.size() ? params[id] : fallback;
+}
+
+} // namespace
+
+MovementValidator::MovementValidator(Game &game) : game(game) {
+    enabled = karma::config::ReadBoolConfig({"movementValidation.Enabled"}, false);
+    speedTolerance = karma::config::ReadFloatConfig({"movementValidation.SpeedTolerance"}, 1.25f);
+    positionTolerance = karma::config::ReadFloatConfig({"movementValidation.PositionToleranceMeters"}, 0.5f);
+
+    const std::string modeName = karma::config::ReadStringConfig("movementValidation.Mode", "flag");
+    if (modeName == "correct") {
+        mode = MovementValidationMode_Correct;
+    } else {
+        if (modeName != "flag") {
+            spdlog::warn("MovementValidator: Unknown mode '{}', falling back to 'flag'", modeName);
+        }
+        mode = MovementValidationMode_Flag;
+    }
+
+    if (enabled) {
+        spdlog::info("MovementValidator: Enabled in '{}' mode", mode == MovementValidationMode_Correct ? "correct" : "flag");
+    }
+}
+
+MovementValidator::~MovementValidator() {
+    tracked.clear();
+}
+
+MovementValidator::Tracked &MovementValidator::track(const Client &client) {
+    auto it = tracked.find(client.getId());
+    if (it != tracked.end()) {
+        return it->second;
+    }
+
+    if (!paramIdsResolved) {
+        const PlayerParameterSchema &schema = game.world->parameterSchema();
+        paramIds.speed = schema.find("speed");
+        paramIds.forwardSpeedMultiplier = schema.find("forwardSpeedMultiplier");
+        paramIds.backwardSpeedMultiplier = schema.find("backwardSpeedMultiplier");
+        paramIds.jumpSpeed = schema.find("jumpSpeed");
+        paramIds.xExtent = schema.find("x_extent");
+        paramIds.yExtent = schema.find("y_extent");
+        paramIds.zExtent = schema.find("z_extent");
+        paramIdsResolved = true;
+    }
+
+    const PlayerParameters &params = client.getState().params;
+    const glm::vec3 size(paramOr(params, paramIds.xExtent, 1.0f),
+                         paramOr(params, paramIds.yExtent, 2.0f),
+                         paramOr(params, paramIds.zExtent, 1.0f));
+
+    Tracked entry;
+    entry.controller = game.engine.physics->createPlayerController(size);
+    entry.controller.setPosition(client.getPosition());
+    entry.controller.setRotation(client.getState().rotation);
+    return tracked.emplace(client.getId(), std::move(entry)).first->second;
+}
+
+void MovementValidator::submit(const Client &client,
+                               const glm::vec3 &position,
+                               const glm::quat &rotation,
+                               const glm::vec3 &velocity) {
+    Tracked &entry = track(client);
+    // Only the newest report per tick is checked; intermediate ones are
+    // covered by the accumulated step time.
+    entry.claimedPosition = position;
+    entry.claimedRotation = rotation;
+    entry.claimedVelocity = velocity;
+    entry.hasClaim = true;
+}
+
+void MovementValidator::teleport(const Client &client) {
+    if (!enabled) {
+        return;
+    }
+
+    Tracked &entry = track(client);
+    entry.controller.setPosition(client.getPosition());
+    entry.controller.setRotation(client.getState().rotation);
+    entry.controller.setVelocity(glm::vec3(0.0f));
+    entry.controller.setAngularVelocity(glm::vec3(0.0f));
+    entry.elapsed = 0.0f;
+    entry.hasClaim = false;
+}
+
+void MovementValidator::update(TimeUtils::duration deltaTime) {
+    if (!enabled) {
+        return;
+    }
+
+    std::vector<PhysicsPlayerStep> steps;
+    std::vector<std::pair<Client *, Tracked *>> stepped;
+    steps.reserve(tracked.size());
+    stepped.reserve(tracked.size());
+
+    for (auto it = tracked.begin(); it != tracked.end();) {
+        Client *client = game.getClient(it->first);
+        if (!client) {
+            it = tracked.erase(it);
+            continue;
+        }
+
+        Tracked &entry = it->second;
+        ++it;
+
+        entry.elapsed += deltaTime;
+        if (!entry.hasClaim) {
+            continue;
+        }
+        if (!client->getState().alive) {
+            entry.hasClaim = false;
+            continue;
+        }
+
+        const PlayerParameters &params = client->getState().params;
+        const float maxHorizontal = paramOr(params, paramIds.speed, 0.0f) *
+                                    std::max(paramOr(params, paramIds.forwardSpeedMultiplier, 1.0f),
+                                             paramOr(params, paramIds.backwardSpeedMultiplier, 1.0f)) *
+                                    speedTolerance;
+        const float maxRise = paramOr(params, paramIds.jumpSpeed, 0.0f) * speedTolerance;
+
+        const TimeUtils::duration stepTime = std::clamp(entry.elapsed, deltaTime, MAX_STEP_SECONDS);
+        glm::vec3 velocity = (entry.claimedPosition - entry.controller.getPosition()) / stepTime;
+
+        glm::vec2 horizontal(velocity.x, velocity.z);
+        const float horizontalSpeed = glm::length(horizontal);
+        if (horizontalSpeed > maxHorizontal && horizontalSpeed > 0.0f) {
+            horizontal *= maxHorizontal / horizontalSpeed;
+            velocity.x = horizontal.x;
+            velocity.z = horizontal.y;
+        }
+        velocity.y = std::min(velocity.y, maxRise);
+
+        entry.controller.setRotation(entry.claimedRotation);
+        entry.controller.setVelocity(velocity);
+        entry.controller.setAngularVelocity(glm::vec3(0.0f));
+
+        steps.push_back({&entry.controller, stepTime});
+        stepped.emplace_back(client, &entry);
+    }
+
+    if (steps.empty()) {
+        return;
+    }
+
+    game.engine.physics->updatePlayers(steps);
+
+    for (auto &[client, entry] : stepped) {
+        const glm::vec3 simulated = entry->controller.getPosition();
+        const float error = glm::distance(simulated, entry->claimedPosition);
+
+        entry->hasClaim = false;
+        entry->elapsed = 0.0f;
+
+        if (error <= positionTolerance) {
+            entry->controller.setPosition(entry->claimedPosition);
+            client->applyLocation(entry->claimedPosition, entry->claimedRotation, entry->claimedVelocity);
+            continue;
+        }
+
+        ++entry->violations;
+        spdlog::warn("MovementValidator: Client id {} moved {:.2f}m past what physics allows (violations: {})",
+                     client->getId(),
+                     error,
+                     entry->violations);
+
+        if (mode == MovementValidationMode_Correct) {
+            client->correctLocation(simulated, entry->claimedRotation, entry->controller.getVelocity());
+        } else {
+            entry->controller.setPosition(entry->claimedPosition);
+            client->applyLocation(entry->claimedPosition, entry->claimedRotation, entry->claimedVelocity);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "karma/core/types.hpp"
+#include "game/net/messages.hpp"
+#include "karma/physics/player_controller.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+class Game;
+class Client;
+
+enum MovementValidationMode {
+    MovementValidationMode_Flag,
+    MovementValidationMode_Correct
+};
+
+// Opt-in authoritative movement check. Each client gets a server-side virtual
+// character that is driven toward its reported position. All characters are
+// stepped in one batch so the physics backend can spread them across workers.
+class MovementValidator {
+private:
+    struct Tracked {
+        PhysicsPlayerController controller;
+        glm::vec3 claimedPosition{0.0f};
+        glm::quat claimedRotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 claimedVelocity{0.0f};
+        TimeUtils::duration elapsed = 0.0f;
+        bool hasClaim = false;
+        uint32_t violations = 0;
+    };
+
+    Game &game;
+    bool enabled = false;
+    MovementValidationMode mode = MovementValidationMode_Flag;
+    float speedTolerance = 1.25f;
+    float positionTolerance = 0.5f;
+    std::unordered_map<client_id, Tracked> tracked;
+
+    // Parameter ids read every tick, resolved once the world is loaded.
+    struct ParameterIds {
+        PlayerParameterId speed = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId forwardSpeedMultiplier = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId backwardSpeedMultiplier = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId jumpSpeed = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId xExtent = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId yExtent = INVALID_PLAYER_PARAMETER;
+        PlayerParameterId zExtent = INVALID_PLAYER_PARAMETER;
+    };
+    ParameterIds paramIds;
+    bool paramIdsResolved = false;
+
+    Tracked &track(const Client &client);
+
+public:
+    MovementValidator(Game &game);
+    ~MovementValidator();
+
+    bool isEnabled() const { return enabled; }
+
+    void submit(const Client &client, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &velocity);
+    void teleport(const Client &client);
+    void update(TimeUtils::duration deltaTime);
+};
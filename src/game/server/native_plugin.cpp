@@ -0,0 +1,211 @@
+#include "server/native_plugin.hpp"
+#include "plugin.hpp"
+#include "karma/common/data_path_resolver.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+thread_local NativePlugins::CallbackTable NativePlugins::g_callbacks;
+
+namespace {
+
+struct LoadedLibrary {
+    void *handle = nullptr;
+    bz_plugin_unload_fn unload = nullptr;
+    void *state = nullptr;
+};
+
+thread_local std::vector<LoadedLibrary> g_libraries;
+thread_local std::vector<std::string> g_libraryPaths;
+
+void *OpenLibrary(const std::string &path, std::string &error) {
+#if defined(_WIN32)
+    HMODULE handle = LoadLibraryA(path.c_str());
+    if (!handle) {
+        error = "LoadLibrary error " + std::to_string(GetLastError());
+    }
+    return reinterpret_cast<void *>(handle);
+#else
+    void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        const char *message = dlerror();
+        error = message ? message : "dlopen failed";
+    }
+    return handle;
+#endif
+}
+
+void *FindSymbol(void *handle, const char *name) {
+#if defined(_WIN32)
+    return reinterpret_cast<void *>(GetProcAddress(reinterpret_cast<HMODULE>(handle), name));
+#else
+    return dlsym(handle, name);
+#endif
+}
+
+void CloseLibrary(void *handle) {
+#if defined(_WIN32)
+    FreeLibrary(reinterpret_cast<HMODULE>(handle));
+#else
+    dlclose(handle);
+#endif
+}
+
+int CopyString(const std::optional<std::string> &value, char *out, size_t capacity) {
+    if (!value) {
+        return -1;
+    }
+    if (out && capacity > 0) {
+        const size_t count = std::min(value->size(), capacity - 1);
+        std::memcpy(out, value->data(), count);
+        out[count] = '\0';
+    }
+    return static_cast<int>(value->size());
+}
+
+const bz_host_api &HostApi() {
+    static const bz_host_api api = [] {
+        bz_host_api table{};
+        table.abi_version = BZ_PLUGIN_ABI_VERSION;
+        table.struct_size = sizeof(bz_host_api);
+
+        table.register_chat = [](bz_chat_callback callback, void *userData) {
+            NativePlugins::g_callbacks.chat.push_back({callback, userData});
+        };
+        table.register_player_join = [](bz_player_join_callback callback, void *userData) {
+            NativePlugins::g_callbacks.playerJoin.push_back({callback, userData});
+        };
+        table.register_player_leave = [](bz_player_leave_callback callback, void *userData) {
+            NativePlugins::g_callbacks.playerLeave.push_back({callback, userData});
+        };
+        table.register_player_spawn = [](bz_player_spawn_callback callback, void *userData) {
+            NativePlugins::g_callbacks.playerSpawn.push_back({callback, userData});
+        };
+        table.register_player_die = [](bz_player_die_callback callback, void *userData) {
+            NativePlugins::g_callbacks.playerDie.push_back({callback, userData});
+        };
+        table.register_create_shot = [](bz_create_shot_callback callback, void *userData) {
+            NativePlugins::g_callbacks.createShot.push_back({callback, userData});
+        };
+
+        table.send_chat_message = [](bz_client_id fromId, bz_client_id toId, const char *text) {
+            PluginAPI::sendChatMessage(fromId, toId, text ? text : "");
+        };
+        table.set_player_parameter = [](bz_client_id playerId, const char *param, float value) -> int {
+            return param && PluginAPI::setPlayerParameter(playerId, param, value) ? 1 : 0;
+        };
+        table.kill_player = [](bz_client_id targetId) {
+            PluginAPI::killPlayer(targetId);
+        };
+        table.disconnect_player = [](bz_client_id targetId, const char *reason) {
+            PluginAPI::disconnectPlayer(targetId, reason ? reason : "");
+        };
+        table.get_player_by_name = [](const char *name) -> bz_client_id {
+            return name ? PluginAPI::getPlayerByName(name) : 0;
+        };
+        table.get_all_player_ids = [](bz_client_id *outIds, size_t capacity) -> size_t {
+            const std::vector<client_id> ids = PluginAPI::getAllPlayerIds();
+            if (outIds) {
+                std::copy_n(ids.begin(), std::min(capacity, ids.size()), outIds);
+            }
+            return ids.size();
+        };
+        table.get_player_name = [](bz_client_id id, char *out, size_t capacity) {
+            return CopyString(PluginAPI::getPlayerName(id), out, capacity);
+        };
+        table.get_player_ip = [](bz_client_id id, char *out, size_t capacity) {
+            return CopyString(PluginAPI::getPlayerIP(id), out, capacity);
+        };
+        table.log = [](bz_log_level level, const char *message) {
+            const char *text = message ? message : "";
+            switch (level) {
+                case BZ_LOG_DEBUG: spdlog::debug("[native] {}", text); break;
+                case BZ_LOG_INFO: spdlog::info("[native] {}", text); break;
+                case BZ_LOG_WARN: spdlog::warn("[native] {}", text); break;
+                default: spdlog::error("[native] {}", text); break;
+            }
+        };
+        return table;
+    }();
+    return api;
+}
+
+} // namespace
+
+void NativePlugins::load(const karma::json::Value &configJson) {
+    namespace fs = std::filesystem;
+
+    const fs::path pluginDir = karma::data::DataRoot() / "plugins";
+    for (const auto &pluginName : PluginAPI::getConfiguredPluginNames(configJson)) {
+        const fs::path libraryPath = pluginDir / pluginName / LIBRARY_FILE_NAME;
+        if (!fs::exists(libraryPath)) {
+            continue;
+        }
+
+        const std::string path = libraryPath.lexically_normal().string();
+        std::string error;
+        void *handle = OpenLibrary(path, error);
+        if (!handle) {
+            spdlog::error("NativePlugins::load: Failed to open '{}': {}", path, error);
+            continue;
+        }
+
+        auto abiVersion = reinterpret_cast<bz_plugin_abi_version_fn>(FindSymbol(handle, BZ_PLUGIN_ABI_VERSION_SYMBOL));
+        auto loadFn = reinterpret_cast<bz_plugin_load_fn>(FindSymbol(handle, BZ_PLUGIN_LOAD_SYMBOL));
+        auto unloadFn = reinterpret_cast<bz_plugin_unload_fn>(FindSymbol(handle, BZ_PLUGIN_UNLOAD_SYMBOL));
+        if (!abiVersion || !loadFn) {
+            spdlog::error("NativePlugins::load: '{}' does not export {} and {}",
+                          path, BZ_PLUGIN_ABI_VERSION_SYMBOL, BZ_PLUGIN_LOAD_SYMBOL);
+            CloseLibrary(handle);
+            continue;
+        }
+        if (abiVersion() != BZ_PLUGIN_ABI_VERSION) {
+            spdlog::error("NativePlugins::load: '{}' targets plugin ABI {}, server provides {}",
+                          path, abiVersion(), BZ_PLUGIN_ABI_VERSION);
+            CloseLibrary(handle);
+            continue;
+        }
+
+        // Registrations made by a plugin that then fails to load are rolled back.
+        const CallbackTable before = g_callbacks;
+        void *state = nullptr;
+        if (loadFn(&HostApi(), &state) == 0) {
+            spdlog::error("NativePlugins::load: '{}' failed to initialize", path);
+            g_callbacks = before;
+            CloseLibrary(handle);
+            continue;
+        }
+
+        spdlog::info("NativePlugins::load: Loaded native plugin '{}' from {}", pluginName, path);
+        g_libraries.push_back({handle, unloadFn, state});
+        g_libraryPaths.push_back(path);
+    }
+}
+
+void NativePlugins::unload() {
+    // Drop callbacks before the code they point into goes away.
+    g_callbacks = CallbackTable{};
+    for (auto it = g_libraries.rbegin(); it != g_libraries.rend(); ++it) {
+        if (it->unload) {
+            it->unload(it->state);
+        }
+        CloseLibrary(it->handle);
+    }
+    g_libraries.clear();
+    g_libraryPaths.clear();
+}
+
+const std::vector<std::string> &NativePlugins::getLoadedLibraries() {
+    return g_libraryPaths;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "server/plugin_abi.h"
+#include "karma/common/json.hpp"
+#include <string>
+#include <vector>
+
+// Shared-library plugins built against plugin_abi.h. They receive the same
+// events as Python plugins through plain function pointers, without the GIL.
+namespace NativePlugins {
+
+#if defined(_WIN32)
+inline constexpr const char *LIBRARY_FILE_NAME = "plugin.dll";
+#elif defined(__APPLE__)
+inline constexpr const char *LIBRARY_FILE_NAME = "plugin.dylib";
+#else
+inline constexpr const char *LIBRARY_FILE_NAME = "plugin.so";
+#endif
+
+template <typename Callback>
+struct Handler {
+    Callback callback;
+    void *userData;
+};
+
+struct CallbackTable {
+    std::vector<Handler<bz_chat_callback>> chat;
+    std::vector<Handler<bz_player_join_callback>> playerJoin;
+    std::vector<Handler<bz_player_leave_callback>> playerLeave;
+    std::vector<Handler<bz_player_spawn_callback>> playerSpawn;
+    std::vector<Handler<bz_player_die_callback>> playerDie;
+    std::vector<Handler<bz_create_shot_callback>> createShot;
+};
+
+// Per thread, like the Python callback table, so arenas stay separate.
+extern thread_local CallbackTable g_callbacks;
+
+void load(const karma::json::Value &configJson);
+void unload();
+const std::vector<std::string> &getLoadedLibraries();
+
+template <typename Callback, typename Event>
+inline bool dispatch(const std::vector<Handler<Callback>> &handlers, const Event &event) {
+    bool handled = false;
+    for (const auto &handler : handlers) {
+        if (handler.callback(&event, handler.userData) != 0) {
+            handled = true;
+        }
+    }
+    return handled;
+}
+
+} // namespace NativePlugins
@@ -5,38 +5,154 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/embed.h>
+#include <cstring>
 #include <filesystem>
+#include <mutex>
 
 
 
-extern Game* g_game;
-extern ServerEngine* g_engine;
-std::map<EventType, std::vector<pybind11::function>> g_pluginCallbacks;
+extern thread_local Game* g_game;
+extern thread_local ServerEngine* g_engine;
+thread_local std::map<EventType, std::vector<PluginCallback>> g_pluginCallbacks;
+thread_local std::map<EventType, std::vector<PluginCallback>> g_pluginBatchCallbacks;
+thread_local uint32_t g_pluginBatchMask = 0;
+thread_local PluginEventBatch g_pluginEventBatch;
 namespace {
-std::vector<std::string> g_loadedPlugins;
+thread_local std::vector<std::string> g_loadedPlugins;
+// Plugin whose plugin.py is being executed, for attributing registrations.
+thread_local std::string g_loadingPlugin;
+
+std::string CallbackOwner(const pybind11::function &func) {
+    namespace py = pybind11;
+    if (!g_loadingPlugin.empty()) {
+        return g_loadingPlugin;
+    }
+    // Registered later (e.g. from another callback): name it after its source directory.
+    try {
+        const py::object code = py::getattr(func, "__code__", py::none());
+        if (!code.is_none()) {
+            const std::filesystem::path file(code.attr("co_filename").cast<std::string>());
+            return file.parent_path().filename().string();
+        }
+    } catch (const py::error_already_set &) {
+    }
+    return "unknown";
 }
 
-void PluginAPI::loadPythonPlugins(const karma::json::Value &configJson) {
+PluginCallback MakeCallback(EventType type, pybind11::function func) {
+    const std::string owner = CallbackOwner(func);
+    return {std::move(func), &PluginProfiler::timingFor(owner, type)};
+}
+
+template<typename T, typename ToTuple>
+void DeliverBatch(EventType type, std::vector<QueuedPluginEvent<T>> &queued, ToTuple toTuple) {
     namespace py = pybind11;
-    namespace fs = std::filesystem;
+    if (queued.empty()) {
+        return;
+    }
 
-    std::vector<std::string> configuredPlugins;
-    if (configJson.contains("plugins") && configJson["plugins"].is_array()) {
-        for (const auto &entry : configJson["plugins"]) {
-            if (!entry.is_object()) {
-                spdlog::warn("Skipping plugin entry because it is not an object.");
+    // Swap out first: a callback may raise more events, which go to next tick's batch.
+    std::vector<QueuedPluginEvent<T>> pending;
+    pending.swap(queued);
+
+    auto it = g_pluginBatchCallbacks.find(type);
+    if (it != g_pluginBatchCallbacks.end() && !it->second.empty()) {
+        py::list events(pending.size());
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            events[i] = toTuple(pending[i].event, pending[i].handled);
+        }
+        for (const auto &callback : it->second) {
+            if (callback.timing->disabled) {
                 continue;
             }
-
-            auto nameIt = entry.find("name");
-            if (nameIt != entry.end() && nameIt->is_string()) {
-                configuredPlugins.emplace_back(nameIt->get<std::string>());
-            } else {
-                spdlog::warn("Skipping plugin entry missing a string 'name' field.");
+            try {
+                PluginProfiler::Scope timed(*callback.timing);
+                callback.func(events);
+            } catch (const py::error_already_set &e) {
+                spdlog::error("Error in plugin batch callback for event type {}: {}", static_cast<int>(type), e.what());
             }
         }
     }
 
+    // Keep the capacity for the next tick.
+    pending.clear();
+    if (queued.empty()) {
+        queued.swap(pending);
+    }
+}
+
+// sys.modules and sys.path belong to the whole interpreter; isolated (arena)
+// loads take turns so one arena never imports while another swaps them.
+std::mutex g_isolatedLoadMutex;
+
+// Removes every module imported from under `root` from sys.modules, so the
+// next import executes it afresh instead of returning another arena's copy.
+void ForgetModulesUnder(const std::filesystem::path &root) {
+    namespace py = pybind11;
+    namespace fs = std::filesystem;
+    const std::string prefix = fs::absolute(root).lexically_normal().string();
+    py::dict modules = py::module_::import("sys").attr("modules");
+
+    std::vector<py::object> names;
+    for (auto item : modules) {
+        const py::object file = py::getattr(item.second, "__file__", py::none());
+        if (!py::isinstance<py::str>(file)) {
+            continue;
+        }
+        const std::string path = fs::absolute(fs::path(file.cast<std::string>())).lexically_normal().string();
+        if (path.rfind(prefix, 0) == 0) {
+            names.push_back(py::reinterpret_borrow<py::object>(item.first));
+        }
+    }
+    for (const auto &name : names) {
+        modules.attr("pop")(name, py::none());
+    }
+}
+
+void FlushBatchedEvents() {
+    namespace py = pybind11;
+    auto &batch = g_pluginEventBatch;
+    if (batch.chat.empty() && batch.playerJoin.empty() && batch.playerLeave.empty() &&
+        batch.playerSpawn.empty() && batch.playerDie.empty() && batch.createShot.empty()) {
+        return;
+    }
+
+    py::gil_scoped_acquire gil;
+    DeliverBatch(EventType_Chat, batch.chat, [](const Event_Chat &e, bool handled) {
+        return py::make_tuple(e.fromId, e.toId, e.message, handled);
+    });
+    DeliverBatch(EventType_PlayerJoin, batch.playerJoin, [](const Event_PlayerJoin &e, bool handled) {
+        return py::make_tuple(e.playerName, e.ip, handled);
+    });
+    DeliverBatch(EventType_PlayerLeave, batch.playerLeave, [](const Event_PlayerLeave &e, bool handled) {
+        return py::make_tuple(e.playerId, handled);
+    });
+    DeliverBatch(EventType_PlayerSpawn, batch.playerSpawn, [](const Event_PlayerSpawn &e, bool handled) {
+        return py::make_tuple(e.playerId, handled);
+    });
+    DeliverBatch(EventType_PlayerDie, batch.playerDie, [](const Event_PlayerDie &e, bool handled) {
+        return py::make_tuple(e.victimPlayerId, e.shotId, handled);
+    });
+    DeliverBatch(EventType_CreateShot, batch.createShot, [](const Event_CreateShot &e, bool handled) {
+        return py::make_tuple(e.shotId, handled);
+    });
+}
+}
+
+void PluginAPI::loadPythonPlugins(const karma::json::Value &configJson, bool isolatedScope) {
+    namespace py = pybind11;
+    namespace fs = std::filesystem;
+
+    py::gil_scoped_acquire gil;
+    std::unique_lock<std::mutex> isolatedLoad;
+    if (isolatedScope) {
+        // Wait without the GIL; the arena holding the lock may need it to finish.
+        py::gil_scoped_release unlocked;
+        isolatedLoad = std::unique_lock<std::mutex>(g_isolatedLoadMutex);
+    }
+
+    const std::vector<std::string> configuredPlugins = PluginAPI::getConfiguredPluginNames(configJson);
+
     if (configuredPlugins.empty()) {
         spdlog::info("No plugins configured in world config; skipping Python plugin load.");
         g_loadedPlugins.clear();
@@ -55,10 +171,24 @@ void PluginAPI::loadPythonPlugins(const karma::json::Value &configJson) {
     }
 
     py::module_ sys  = py::module_::import("sys");
+    py::list sysPath = sys.attr("path");
+
+    // An isolated load imports its own copy of every plugin-side module and
+    // leaves sys.path as it found it. Plugins therefore import at the top of
+    // their files; a later import of a plugin module from inside a callback
+    // fails instead of picking up another arena's copy.
+    const py::list savedSysPath = sysPath.attr("copy")();
+    if (isolatedScope) {
+        ForgetModulesUnder(dataRoot);
+    }
 
     auto addSysPath = [&](const fs::path &path) {
-        if (!path.empty() && fs::exists(path)) {
-            sys.attr("path").attr("insert")(0, path.lexically_normal().string());
+        if (path.empty() || !fs::exists(path)) {
+            return;
+        }
+        const py::str entry(path.lexically_normal().string());
+        if (!sysPath.contains(entry)) {
+            sysPath.attr("insert")(0, entry);
         }
     };
 
@@ -70,23 +200,24 @@ void PluginAPI::loadPythonPlugins(const karma::json::Value &configJson) {
     }
 
     g_loadedPlugins.clear();
-
-    auto isPluginNameSafe = [](const std::string &pluginName) {
-        return !pluginName.empty() &&
-               pluginName.find("..") == std::string::npos &&
-               pluginName.find('/') == std::string::npos &&
-               pluginName.find('\\') == std::string::npos;
-    };
+    PluginProfiler::configure();
+
+    // Arenas sharing the interpreter each get their own globals for plugin.py
+    // as well as their own plugin modules (above).
+    py::dict scope = py::globals();
+    if (isolatedScope) {
+        scope = py::dict();
+        scope["__builtins__"] = py::module_::import("builtins");
+        scope["__name__"] = "__main__";
+    }
 
     for (const auto &pluginName : configuredPlugins) {
-        if (!isPluginNameSafe(pluginName)) {
-            spdlog::warn("Skipping plugin '{}' because it contains invalid path characters.", pluginName);
-            continue;
-        }
-
         const fs::path scriptPath = pluginDir / pluginName / "plugin.py";
         if (!fs::exists(scriptPath)) {
-            spdlog::warn("Configured plugin '{}' missing at {}", pluginName, scriptPath.string());
+            // Native-only plugins are loaded by NativePlugins::load.
+            if (!fs::exists(pluginDir / pluginName / NativePlugins::LIBRARY_FILE_NAME)) {
+                spdlog::warn("Configured plugin '{}' missing at {}", pluginName, scriptPath.string());
+            }
             continue;
         }
 
@@ -95,27 +226,159 @@ void PluginAPI::loadPythonPlugins(const karma::json::Value &configJson) {
         try {
             const std::string normalizedPath = scriptPath.lexically_normal().string();
             py::print("[PY] Loading plugin:", pluginName, "->", normalizedPath);
-            py::eval_file(normalizedPath, py::globals());
+            g_loadingPlugin = pluginName;
+            py::eval_file(normalizedPath, scope);
+            g_loadingPlugin.clear();
             g_loadedPlugins.push_back(normalizedPath);
         } catch (py::error_already_set &e) {
+            g_loadingPlugin.clear();
             py::print("[PY ERROR]", e.what());
         }
     }
+
+    if (isolatedScope) {
+        ForgetModulesUnder(dataRoot);
+        sysPath.attr("clear")();
+        sysPath.attr("extend")(savedSysPath);
+    }
+}
+
+void PluginAPI::unloadPythonPlugins() {
+    // Callbacks hold Python references and must be released with the GIL held.
+    pybind11::gil_scoped_acquire gil;
+    g_pluginCallbacks.clear();
+    g_pluginBatchCallbacks.clear();
+    g_pluginBatchMask = 0;
+    g_pluginEventBatch = PluginEventBatch{};
+    PluginProfiler::reset();
+    g_loadedPlugins.clear();
 }
 
 const std::vector<std::string> &PluginAPI::getLoadedPluginScripts() {
+    if (PluginHost *host = PluginHost::current()) {
+        return host->loadedScripts();
+    }
     return g_loadedPlugins;
 }
 
-void PluginAPI::registerCallback(EventType type, pybind11::function func) {
-    if (g_pluginCallbacks.find(type) == g_pluginCallbacks.end()) {
-        g_pluginCallbacks[type] = std::vector<pybind11::function>();
+std::vector<std::string> PluginAPI::getConfiguredPluginNames(const karma::json::Value &configJson) {
+    auto isPluginNameSafe = [](const std::string &pluginName) {
+        return !pluginName.empty() &&
+               pluginName.find("..") == std::string::npos &&
+               pluginName.find('/') == std::string::npos &&
+               pluginName.find('\\') == std::string::npos;
+    };
+
+    std::vector<std::string> configuredPlugins;
+    if (!configJson.contains("plugins") || !configJson["plugins"].is_array()) {
+        return configuredPlugins;
     }
-    g_pluginCallbacks[type].push_back(func);
+    for (const auto &entry : configJson["plugins"]) {
+        if (!entry.is_object()) {
+            spdlog::warn("Skipping plugin entry because it is not an object.");
+            continue;
+        }
+
+        auto nameIt = entry.find("name");
+        if (nameIt == entry.end() || !nameIt->is_string()) {
+            spdlog::warn("Skipping plugin entry missing a string 'name' field.");
+            continue;
+        }
+        const std::string pluginName = nameIt->get<std::string>();
+        if (!isPluginNameSafe(pluginName)) {
+            spdlog::warn("Skipping plugin '{}' because it contains invalid path characters.", pluginName);
+            continue;
+        }
+        configuredPlugins.push_back(pluginName);
+    }
+    return configuredPlugins;
+}
+
+void PluginAPI::registerCallback(EventType type, pybind11::function func) {
+    g_pluginCallbacks[type].push_back(MakeCallback(type, std::move(func)));
     spdlog::debug("PluginAPI: Registered callback for event {} (total: {})", static_cast<int>(type), g_pluginCallbacks[type].size());
 }
 
+void PluginAPI::registerBatchCallback(EventType type, pybind11::function func) {
+    g_pluginBatchCallbacks[type].push_back(MakeCallback(type, std::move(func)));
+    g_pluginBatchMask |= 1u << type;
+    spdlog::debug("PluginAPI: Registered batch callback for event {} (total: {})", static_cast<int>(type), g_pluginBatchCallbacks[type].size());
+}
+
+void PluginAPI::beginTick() {
+    PluginHost *host = PluginHost::current();
+    if (!host || !g_game) {
+        return;
+    }
+    host->beginTick(getPlayerSnapshot());
+}
+
+void PluginAPI::endTick() {
+    if (PluginHost *host = PluginHost::current()) {
+        // Batch queues, callbacks and timings live on the worker; skip the
+        // wake-up when nothing was posted since the last tick.
+        thread_local uint64_t lastTickJobs = 0;
+        if (host->postedJobs() != lastTickJobs) {
+            host->post([]() {
+                endTick();
+                return false;
+            });
+            lastTickJobs = host->postedJobs();
+        }
+        return;
+    }
+
+    if (g_pluginBatchMask != 0) {
+        FlushBatchedEvents();
+    }
+    PluginProfiler::endTick();
+
+    // Keep the game thread's copy of the statistics report reasonably fresh.
+    constexpr auto STATS_REPORT_INTERVAL = std::chrono::seconds(1);
+    thread_local auto lastStatsReport = std::chrono::steady_clock::time_point{};
+    if (PluginHost *host = PluginHost::hosting()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastStatsReport >= STATS_REPORT_INTERVAL) {
+            host->publishStatsReport(PluginProfiler::formatReport());
+            lastStatsReport = now;
+        }
+    }
+}
+
+std::string PluginAPI::getPluginStatsReport(bool clear) {
+    if (PluginHost *host = PluginHost::current()) {
+        // Timings live on the worker. Answer from its last published report
+        // and ask it for a fresh one, so the tick never waits on Python.
+        std::string report = host->statsReport();
+        host->post([host, clear]() {
+            if (clear) {
+                PluginProfiler::clearStats();
+            }
+            host->publishStatsReport(PluginProfiler::formatReport());
+            return false;
+        });
+        if (report.empty()) {
+            report = "No plugin statistics published yet; ask again in a moment.";
+        }
+        if (clear) {
+            report += "\nStatistics will be cleared and disabled callbacks re-enabled on the plugin thread.";
+        }
+        return report;
+    }
+
+    std::string report = PluginProfiler::formatReport();
+    if (clear) {
+        PluginProfiler::clearStats();
+        report += "\nStatistics cleared; disabled callbacks re-enabled.";
+    }
+    return report;
+}
+
 void PluginAPI::sendChatMessage(client_id fromId, client_id toId, const std::string &text) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        host->enqueueCommand([=]() { sendChatMessage(fromId, toId, text); });
+        return;
+    }
     ServerMsg_Chat serverChatMsg;
     serverChatMsg.fromId = fromId;
     serverChatMsg.toId = toId;
@@ -124,14 +387,27 @@ void PluginAPI::sendChatMessage(client_id fromId, client_id toId, const std::str
 }
 
 bool PluginAPI::setPlayerParameter(client_id playerId, const std::string &param, const pybind11::object &value) {
+    return setPlayerParameter(playerId, param, value.cast<float>());
+}
+
+bool PluginAPI::setPlayerParameter(client_id playerId, const std::string &param, float value) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        // Applied next tick; report whether the player exists right now.
+        host->enqueueCommand([=]() { setPlayerParameter(playerId, param, value); });
+        return getPlayerName(playerId).has_value();
+    }
     Client* client = g_game->getClient(playerId);
     if (client) {
-        return client->setParameter(param, value.cast<float>());
+        return client->setParameter(param, value);
     }
     return false;
 }
 
 void PluginAPI::killPlayer(client_id targetId) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        host->enqueueCommand([=]() { killPlayer(targetId); });
+        return;
+    }
     Client *client = g_game->getClient(targetId);
 
     if (client) {
@@ -141,6 +417,10 @@ void PluginAPI::killPlayer(client_id targetId) {
 }
 
 void PluginAPI::disconnectPlayer(client_id targetId, const std::string &reason) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        host->enqueueCommand([=]() { disconnectPlayer(targetId, reason); });
+        return;
+    }
     if (!g_engine || !g_engine->network) {
         spdlog::warn("PluginAPI::disconnectPlayer: Server engine not initialized");
         return;
@@ -156,6 +436,14 @@ void PluginAPI::disconnectPlayer(client_id targetId, const std::string &reason)
 }
 
 client_id PluginAPI::getPlayerByName(const std::string &name) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        for (const auto &player : host->players()) {
+            if (player.name == name) {
+                return player.id;
+            }
+        }
+        return 0;
+    }
     Client* client = g_game->getClientByName(name);
     if (client) {
         return client->getId();
@@ -165,6 +453,12 @@ client_id PluginAPI::getPlayerByName(const std::string &name) {
 
 std::vector<client_id> PluginAPI::getAllPlayerIds() {
     std::vector<client_id> ids;
+    if (PluginHost *host = PluginHost::hosting()) {
+        for (const auto &player : host->players()) {
+            ids.push_back(player.id);
+        }
+        return ids;
+    }
     for (const auto &client : g_game->getClients()) {
         ids.push_back(client->getId());
     }
@@ -172,6 +466,14 @@ std::vector<client_id> PluginAPI::getAllPlayerIds() {
 }
 
 std::optional<std::string> PluginAPI::getPlayerName(client_id id) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        for (const auto &player : host->players()) {
+            if (player.id == id) {
+                return player.name;
+            }
+        }
+        return std::nullopt;
+    }
     Client* client = g_game->getClient(id);
     if (client) {
         return client->getName();
@@ -180,6 +482,14 @@ std::optional<std::string> PluginAPI::getPlayerName(client_id id) {
 }
 
 std::optional<std::string> PluginAPI::getPlayerIP(client_id id) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        for (const auto &player : host->players()) {
+            if (player.id == id) {
+                return player.ip;
+            }
+        }
+        return std::nullopt;
+    }
     Client* client = g_game->getClient(id);
     if (client) {
         return client->getIP();
@@ -187,6 +497,146 @@ std::optional<std::string> PluginAPI::getPlayerIP(client_id id) {
     return std::nullopt;
 }
 
+bool PluginAPI::grantFlag(client_id playerId, const std::string &cname) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        host->enqueueCommand([=]() { grantFlag(playerId, cname); });
+        return hasNativeFlag(cname) && getPlayerName(playerId).has_value();
+    }
+    return g_game->flags->grant(playerId, cname);
+}
+
+void PluginAPI::dropFlag(client_id playerId) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        host->enqueueCommand([=]() { dropFlag(playerId); });
+        return;
+    }
+    g_game->flags->drop(playerId);
+}
+
+std::optional<std::string> PluginAPI::getPlayerFlag(client_id playerId) {
+    if (PluginHost *host = PluginHost::hosting()) {
+        for (const auto &player : host->players()) {
+            if (player.id == playerId && !player.flag.empty()) {
+                return player.flag;
+            }
+        }
+        return std::nullopt;
+    }
+    if (const FlagDefinition *flag = g_game->flags->heldBy(playerId)) {
+        return flag->cname;
+    }
+    return std::nullopt;
+}
+
+bool PluginAPI::hasNativeFlag(const std::string &cname) {
+    return FlagCatalog::Shared().find(cname) != nullptr;
+}
+
+std::vector<PluginHost::PlayerInfo> PluginAPI::getPlayerSnapshot() {
+    if (PluginHost *host = PluginHost::hosting()) {
+        return host->players();
+    }
+
+    std::vector<PluginHost::PlayerInfo> players;
+    if (!g_game) {
+        return players;
+    }
+    players.reserve(g_game->getClients().size());
+    for (const auto &client : g_game->getClients()) {
+        const PlayerState &state = client->getState();
+        const FlagDefinition *flag = g_game->flags->heldBy(client->getId());
+        players.push_back({client->getId(), client->getName(), client->getIP(),
+                           state.position, state.rotation, state.velocity, state.alive, state.score,
+                           flag ? flag->cname : std::string()});
+    }
+    return players;
+}
+
+namespace {
+
+// Read-only, C-contiguous column of the bulk player arrays, exposed to Python
+// through the buffer protocol (memoryview, numpy.asarray).
+struct PlayerColumn {
+    std::vector<std::byte> bytes;
+    std::string format;
+    pybind11::ssize_t itemSize = 0;
+    std::vector<pybind11::ssize_t> shape;
+};
+
+template<typename T>
+pybind11::memoryview MakeColumnView(const std::vector<T> &values, std::size_t rows, std::size_t width) {
+    PlayerColumn column;
+    column.format = pybind11::format_descriptor<T>::format();
+    column.itemSize = sizeof(T);
+    column.shape.push_back(static_cast<pybind11::ssize_t>(rows));
+    if (width > 1) {
+        column.shape.push_back(static_cast<pybind11::ssize_t>(width));
+    }
+    column.bytes.resize(values.size() * sizeof(T));
+    if (!values.empty()) {
+        std::memcpy(column.bytes.data(), values.data(), column.bytes.size());
+    }
+    // The memoryview holds a reference to the column, which owns the bytes.
+    pybind11::object owner = pybind11::cast(std::move(column));
+    return pybind11::reinterpret_steal<pybind11::memoryview>(PyMemoryView_FromObject(owner.ptr()));
+}
+
+pybind11::dict GetPlayerArrays() {
+    const std::vector<PluginHost::PlayerInfo> players = PluginAPI::getPlayerSnapshot();
+    const std::size_t count = players.size();
+
+    std::vector<uint32_t> ids(count);
+    std::vector<float> positions(count * 3);
+    std::vector<float> rotations(count * 4);
+    std::vector<float> velocities(count * 3);
+    std::vector<uint8_t> alive(count);
+    std::vector<int32_t> scores(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto &player = players[i];
+        ids[i] = player.id;
+        positions[i * 3 + 0] = player.position.x;
+        positions[i * 3 + 1] = player.position.y;
+        positions[i * 3 + 2] = player.position.z;
+        rotations[i * 4 + 0] = player.rotation.x;
+        rotations[i * 4 + 1] = player.rotation.y;
+        rotations[i * 4 + 2] = player.rotation.z;
+        rotations[i * 4 + 3] = player.rotation.w;
+        velocities[i * 3 + 0] = player.velocity.x;
+        velocities[i * 3 + 1] = player.velocity.y;
+        velocities[i * 3 + 2] = player.velocity.z;
+        alive[i] = player.alive ? 1 : 0;
+        scores[i] = player.score;
+    }
+
+    pybind11::dict arrays;
+    arrays["count"] = count;
+    arrays["ids"] = MakeColumnView(ids, count, 1);
+    arrays["positions"] = MakeColumnView(positions, count, 3);
+    arrays["rotations"] = MakeColumnView(rotations, count, 4);
+    arrays["velocities"] = MakeColumnView(velocities, count, 3);
+    arrays["alive"] = MakeColumnView(alive, count, 1);
+    arrays["scores"] = MakeColumnView(scores, count, 1);
+    return arrays;
+}
+
+pybind11::list GetPluginStats() {
+    pybind11::list stats;
+    for (const auto &timing : PluginProfiler::timings()) {
+        pybind11::dict entry;
+        entry["plugin"] = timing.plugin;
+        entry["event"] = static_cast<EventType>(timing.eventType);
+        entry["count"] = timing.count;
+        entry["total_ms"] = static_cast<double>(timing.totalNs) / 1.0e6;
+        entry["max_ms"] = static_cast<double>(timing.maxNs) / 1.0e6;
+        entry["histogram"] = std::vector<uint64_t>(timing.histogram.begin(), timing.histogram.end());
+        entry["disabled"] = timing.disabled;
+        stats.append(entry);
+    }
+    return stats;
+}
+
+} // namespace
+
 PYBIND11_EMBEDDED_MODULE(bzapi, m) {
     m.doc() = "Plugin API for BZ server plugins";
 
@@ -203,10 +653,15 @@ PYBIND11_EMBEDDED_MODULE(bzapi, m) {
     // Callback registration function
     m.def("register_callback", &PluginAPI::registerCallback, "Register a callback",
           pybind11::arg("type"), pybind11::arg("callback"));
+    m.def("register_batch_callback", &PluginAPI::registerBatchCallback,
+          "Register a callback that receives each tick's events of a type as one list",
+          pybind11::arg("type"), pybind11::arg("callback"));
 
     m.def("send_chat_message", &PluginAPI::sendChatMessage, "Send a chat message",
           pybind11::arg("from_id"), pybind11::arg("to_id"), pybind11::arg("text"));
-    m.def("set_player_parameter", &PluginAPI::setPlayerParameter, "Set a player parameter",
+    m.def("set_player_parameter",
+          pybind11::overload_cast<client_id, const std::string &, const pybind11::object &>(&PluginAPI::setPlayerParameter),
+          "Set a player parameter",
           pybind11::arg("player_id"), pybind11::arg("param"), pybind11::arg("value"));
     m.def("kill_player", &PluginAPI::killPlayer, "Kill a player",
           pybind11::arg("target_id"));
@@ -221,4 +676,27 @@ PYBIND11_EMBEDDED_MODULE(bzapi, m) {
           pybind11::arg("id"));
     m.def("get_player_ip", &PluginAPI::getPlayerIP, "Get a player's IP by ID",
           pybind11::arg("id"));
+    m.def("grant_flag", &PluginAPI::grantFlag, "Give a player a native flag, replacing any flag they hold",
+          pybind11::arg("player_id"), pybind11::arg("cname"));
+    m.def("drop_flag", &PluginAPI::dropFlag, "Drop a player's native flag",
+          pybind11::arg("player_id"));
+    m.def("get_player_flag", &PluginAPI::getPlayerFlag, "Get the cname of the native flag a player holds",
+          pybind11::arg("player_id"));
+    m.def("has_native_flag", &PluginAPI::hasNativeFlag, "Whether a flag is defined by a flag.json file",
+          pybind11::arg("cname"));
+
+    pybind11::class_<PlayerColumn>(m, "PlayerColumn", pybind11::buffer_protocol())
+        .def_buffer([](PlayerColumn &column) {
+            std::vector<pybind11::ssize_t> strides(column.shape.size(), column.itemSize);
+            if (column.shape.size() == 2) {
+                strides[0] = column.itemSize * column.shape[1];
+            }
+            return pybind11::buffer_info(column.bytes.data(), column.itemSize, column.format,
+                                         static_cast<pybind11::ssize_t>(column.shape.size()),
+                                         column.shape, strides, true);
+        });
+    m.def("get_plugin_stats", &GetPluginStats,
+          "Get per-plugin, per-event callback timing (count, total/max ms, histogram, disabled)");
+    m.def("get_player_arrays", &GetPlayerArrays,
+          "Get every player's id, position, rotation, velocity, alive flag and score as row-aligned arrays");
 }
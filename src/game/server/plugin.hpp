@@ -1,8 +1,12 @@
 #pragma once
 #include "karma/core/types.hpp"
 #include "game/net/messages.hpp"
+#include "server/native_plugin.hpp"
+#include "server/plugin_host.hpp"
+#include "server/plugin_profiler.hpp"
 #include "spdlog/spdlog.h"
 #include "karma/common/json.hpp"
+#include <functional>
 #include <vector>
 #include <memory>
 #include <map>
@@ -19,7 +23,18 @@ enum EventType {
     EventType_CreateShot
 };
 
-extern std::map<EventType, std::vector<pybind11::function>> g_pluginCallbacks;
+struct PluginCallback {
+    pybind11::function func;
+    // Shared by every callback one plugin registers for one event type.
+    PluginProfiler::Timing *timing;
+};
+
+// Per thread so each arena in a multi-arena host keeps its own registrations.
+extern thread_local std::map<EventType, std::vector<PluginCallback>> g_pluginCallbacks;
+// Callbacks that take one list per tick instead of one call per event.
+extern thread_local std::map<EventType, std::vector<PluginCallback>> g_pluginBatchCallbacks;
+// Bit (1 << EventType) is set while any batch callback wants that event.
+extern thread_local uint32_t g_pluginBatchMask;
 
 struct Event_Chat {
     client_id fromId;
@@ -48,16 +63,88 @@ struct Event_PlayerDie {
     client_id victimPlayerId;
     shot_id shotId;
 };
+template<typename T> struct QueuedPluginEvent {
+    T event;
+    bool handled;
+};
+
+// Events recorded during a tick for batch callbacks, with the outcome of the
+// synchronous callbacks that already saw them.
+struct PluginEventBatch {
+    std::vector<QueuedPluginEvent<Event_Chat>> chat;
+    std::vector<QueuedPluginEvent<Event_PlayerJoin>> playerJoin;
+    std::vector<QueuedPluginEvent<Event_PlayerLeave>> playerLeave;
+    std::vector<QueuedPluginEvent<Event_PlayerSpawn>> playerSpawn;
+    std::vector<QueuedPluginEvent<Event_PlayerDie>> playerDie;
+    std::vector<QueuedPluginEvent<Event_CreateShot>> createShot;
+};
 
+extern thread_local PluginEventBatch g_pluginEventBatch;
 
+inline void g_queuePluginEvent(const Event_Chat& e, bool handled) { g_pluginEventBatch.chat.push_back({e, handled}); }
+inline void g_queuePluginEvent(const Event_PlayerJoin& e, bool handled) { g_pluginEventBatch.playerJoin.push_back({e, handled}); }
+inline void g_queuePluginEvent(const Event_PlayerLeave& e, bool handled) { g_pluginEventBatch.playerLeave.push_back({e, handled}); }
+inline void g_queuePluginEvent(const Event_PlayerSpawn& e, bool handled) { g_pluginEventBatch.playerSpawn.push_back({e, handled}); }
+inline void g_queuePluginEvent(const Event_PlayerDie& e, bool handled) { g_pluginEventBatch.playerDie.push_back({e, handled}); }
+inline void g_queuePluginEvent(const Event_CreateShot& e, bool handled) { g_pluginEventBatch.createShot.push_back({e, handled}); }
+
+inline bool g_triggerNativePluginEvent(const Event_Chat& e) {
+    const bz_chat_event event{e.fromId, e.toId, e.message.c_str(), e.message.size()};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.chat, event);
+}
+
+inline bool g_triggerNativePluginEvent(const Event_PlayerJoin& e) {
+    const bz_player_join_event event{e.playerName.c_str(), e.ip.c_str()};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.playerJoin, event);
+}
+
+inline bool g_triggerNativePluginEvent(const Event_PlayerLeave& e) {
+    const bz_player_leave_event event{e.playerId};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.playerLeave, event);
+}
+
+inline bool g_triggerNativePluginEvent(const Event_PlayerSpawn& e) {
+    const bz_player_spawn_event event{e.playerId};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.playerSpawn, event);
+}
+
+inline bool g_triggerNativePluginEvent(const Event_PlayerDie& e) {
+    const bz_player_die_event event{e.victimPlayerId, e.shotId};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.playerDie, event);
+}
+
+inline bool g_triggerNativePluginEvent(const Event_CreateShot& e) {
+    const bz_create_shot_event event{e.shotId};
+    return NativePlugins::dispatch(NativePlugins::g_callbacks.createShot, event);
+}
+
+// Native callbacks run first, then Python ones; every callback sees the event.
+// Only these synchronous callbacks decide `handled`; batch callbacks are told
+// the outcome when PluginAPI::endTick runs.
 template<typename T> inline bool g_triggerPluginEvent(EventType type, T& eventData) {
     namespace py = pybind11;
+    bool handled = g_triggerNativePluginEvent(eventData);
+
+    // Threaded host: Python runs on the worker against its own callback tables,
+    // and the tick never waits for it. Vetoes go through g_triggerPluginVeto.
+    if (PluginHost *host = PluginHost::current()) {
+        host->post([type, eventData]() mutable {
+            return g_triggerPluginEvent<T>(type, eventData);
+        });
+        return handled;
+    }
+
     auto it = g_pluginCallbacks.find(type);
-    bool handled = false;    
 
     if (it != g_pluginCallbacks.end()) {
-        for (const auto &func : it->second) {
+        py::gil_scoped_acquire gil;
+        for (const auto &callback : it->second) {
+            if (callback.timing->disabled) {
+                continue;
+            }
+            const auto &func = callback.func;
             try {
+                PluginProfiler::Scope timed(*callback.timing);
                 // Get return value to check if the event was handled
                 bool h = false;
 
@@ -101,18 +188,73 @@ template<typename T> inline bool g_triggerPluginEvent(EventType type, T& eventDa
         }
     }
 
+    if (g_pluginBatchMask & (1u << type)) {
+        g_queuePluginEvent(eventData, handled);
+    }
+
     return handled;
 }
 
+enum class PluginVerdict {
+    Allowed,    // resolve(true) has run
+    Vetoed,     // resolve(false) has run
+    Deferred    // the plugin host decides; resolve runs at a later beginTick
+};
+
+// For events a plugin can veto (chat, spawn, death). resolve(allowed) carries
+// out the game's side of the event and runs exactly once on the game thread.
+// Inline plugins and native vetoes answer now. With the threaded host, Python
+// answers on the worker and resolve is queued back as a command, so the tick
+// never blocks on a plugin. If the host's queue is full, the event is allowed.
+template<typename T> inline PluginVerdict g_triggerPluginVeto(EventType type, T& eventData, std::function<void(bool allowed)> resolve) {
+    PluginHost *host = PluginHost::current();
+    if (!host) {
+        const bool allowed = !g_triggerPluginEvent<T>(type, eventData);
+        resolve(allowed);
+        return allowed ? PluginVerdict::Allowed : PluginVerdict::Vetoed;
+    }
+
+    if (g_triggerNativePluginEvent(eventData)) {
+        // Python still sees the event, but the veto already stands.
+        host->post([type, eventData]() mutable {
+            return g_triggerPluginEvent<T>(type, eventData);
+        });
+        resolve(false);
+        return PluginVerdict::Vetoed;
+    }
+
+    auto deferred = std::make_shared<std::function<void(bool)>>(std::move(resolve));
+    const bool posted = host->postVeto([type, eventData]() mutable {
+        return g_triggerPluginEvent<T>(type, eventData);
+    }, [deferred](bool allowed) { (*deferred)(allowed); });
+    if (!posted) {
+        (*deferred)(true);
+        return PluginVerdict::Allowed;
+    }
+    return PluginVerdict::Deferred;
+}
+
 namespace py = pybind11;
 
 namespace PluginAPI {
     void registerCallback(EventType type, pybind11::function func);
-    void loadPythonPlugins(const karma::json::Value &configJson);
+    void registerBatchCallback(EventType type, pybind11::function func);
+    // Tick boundaries, called by Game at the start and end of each update.
+    // beginTick applies actions queued by a threaded plugin host; endTick
+    // delivers batched events and checks the plugin tick budget.
+    void beginTick();
+    void endTick();
+    // Text table of plugin callback timings; clear also re-enables disabled callbacks.
+    std::string getPluginStatsReport(bool clear);
+    // Names from the config's `plugins` array, with unsafe path names dropped.
+    std::vector<std::string> getConfiguredPluginNames(const karma::json::Value &configJson);
+    void loadPythonPlugins(const karma::json::Value &configJson, bool isolatedScope = false);
+    void unloadPythonPlugins();
     const std::vector<std::string>& getLoadedPluginScripts();
     
     void sendChatMessage(client_id fromId, client_id toId, const std::string &text);
     bool setPlayerParameter(client_id playerId, const std::string &param, const pybind11::object &value);
+    bool setPlayerParameter(client_id playerId, const std::string &param, float value);
     void killPlayer(client_id targetId);
     void disconnectPlayer(client_id targetId, const std::string &reason);
     client_id getPlayerByName(const std::string &name);
@@ -120,4 +262,11 @@ namespace PluginAPI {
 
     std::optional<std::string> getPlayerName(client_id id);
     std::optional<std::string> getPlayerIP(client_id id);
+    // Native flags (see FlagEngine). Python flag modules keep only bespoke behaviour.
+    bool grantFlag(client_id playerId, const std::string &cname);
+    void dropFlag(client_id playerId);
+    std::optional<std::string> getPlayerFlag(client_id playerId);
+    bool hasNativeFlag(const std::string &cname);
+    // Every player in one pass; the bulk bzapi accessors are built from this.
+    std::vector<PluginHost::PlayerInfo> getPlayerSnapshot();
 }
@@ -0,0 +1,120 @@
+/*
+ * Native server plugin ABI.
+ *
+ * A native plugin is a shared library at data/plugins/<name>/plugin.{so,dylib,dll}
+ * listed in the server's `plugins` config array like a Python plugin. It exports
+ * the three BZ_PLUGIN_EXPORT functions below with C linkage. The host passes a
+ * bz_host_api table to bz_plugin_load; callbacks registered through it run on
+ * the arena thread before any Python callback for the same event.
+ *
+ * Compatibility: BZ_PLUGIN_ABI_VERSION changes only on breaking changes. New
+ * host functions are appended to bz_host_api and announced by struct_size, so a
+ * plugin built against an older header keeps working.
+ */
+#ifndef BZ3_PLUGIN_ABI_H
+#define BZ3_PLUGIN_ABI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BZ_PLUGIN_ABI_VERSION 1u
+
+#if defined(_WIN32)
+    #define BZ_PLUGIN_EXPORT __declspec(dllexport)
+#else
+    #define BZ_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef uint32_t bz_client_id;
+typedef uint32_t bz_shot_id;
+
+/* Strings in events are only valid for the duration of the callback. */
+typedef struct bz_chat_event {
+    bz_client_id from_id;
+    bz_client_id to_id;
+    const char *message;
+    size_t message_length;
+} bz_chat_event;
+
+typedef struct bz_player_join_event {
+    const char *player_name;
+    const char *ip;
+} bz_player_join_event;
+
+typedef struct bz_player_leave_event {
+    bz_client_id player_id;
+} bz_player_leave_event;
+
+typedef struct bz_player_spawn_event {
+    bz_client_id player_id;
+} bz_player_spawn_event;
+
+typedef struct bz_player_die_event {
+    bz_client_id victim_player_id;
+    bz_shot_id shot_id;
+} bz_player_die_event;
+
+typedef struct bz_create_shot_event {
+    bz_shot_id shot_id;
+} bz_create_shot_event;
+
+/* Return nonzero to mark the event handled, as a Python callback returning True does. */
+typedef int (*bz_chat_callback)(const bz_chat_event *event, void *user_data);
+typedef int (*bz_player_join_callback)(const bz_player_join_event *event, void *user_data);
+typedef int (*bz_player_leave_callback)(const bz_player_leave_event *event, void *user_data);
+typedef int (*bz_player_spawn_callback)(const bz_player_spawn_event *event, void *user_data);
+typedef int (*bz_player_die_callback)(const bz_player_die_event *event, void *user_data);
+typedef int (*bz_create_shot_callback)(const bz_create_shot_event *event, void *user_data);
+
+typedef enum bz_log_level {
+    BZ_LOG_DEBUG = 0,
+    BZ_LOG_INFO = 1,
+    BZ_LOG_WARN = 2,
+    BZ_LOG_ERROR = 3
+} bz_log_level;
+
+typedef struct bz_host_api {
+    uint32_t abi_version;
+    uint32_t struct_size;
+
+    void (*register_chat)(bz_chat_callback callback, void *user_data);
+    void (*register_player_join)(bz_player_join_callback callback, void *user_data);
+    void (*register_player_leave)(bz_player_leave_callback callback, void *user_data);
+    void (*register_player_spawn)(bz_player_spawn_callback callback, void *user_data);
+    void (*register_player_die)(bz_player_die_callback callback, void *user_data);
+    void (*register_create_shot)(bz_create_shot_callback callback, void *user_data);
+
+    void (*send_chat_message)(bz_client_id from_id, bz_client_id to_id, const char *text);
+    int (*set_player_parameter)(bz_client_id player_id, const char *param, float value);
+    void (*kill_player)(bz_client_id target_id);
+    void (*disconnect_player)(bz_client_id target_id, const char *reason);
+    /* Returns 0 when no player has that name. */
+    bz_client_id (*get_player_by_name)(const char *name);
+    /* Writes up to capacity ids and returns the total player count. */
+    size_t (*get_all_player_ids)(bz_client_id *out_ids, size_t capacity);
+    /* Copy a NUL-terminated string into out (truncating to capacity) and
+       return its full length, or return -1 if the player is unknown. */
+    int (*get_player_name)(bz_client_id id, char *out, size_t capacity);
+    int (*get_player_ip)(bz_client_id id, char *out, size_t capacity);
+    void (*log)(bz_log_level level, const char *message);
+} bz_host_api;
+
+/* Plugin exports. */
+typedef uint32_t (*bz_plugin_abi_version_fn)(void);
+/* Return nonzero on success; *plugin_state is passed back to bz_plugin_unload. */
+typedef int (*bz_plugin_load_fn)(const bz_host_api *api, void **plugin_state);
+typedef void (*bz_plugin_unload_fn)(void *plugin_state);
+
+#define BZ_PLUGIN_ABI_VERSION_SYMBOL "bz_plugin_abi_version"
+#define BZ_PLUGIN_LOAD_SYMBOL "bz_plugin_load"
+#define BZ_PLUGIN_UNLOAD_SYMBOL "bz_plugin_unload"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BZ3_PLUGIN_ABI_H */
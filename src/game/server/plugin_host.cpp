@@ -0,0 +1,224 @@
+#include "server/plugin_host.hpp"
+#include "plugin.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+#include <pybind11/embed.h>
+#include <algorithm>
+
+namespace {
+
+thread_local PluginHost *g_currentHost = nullptr;
+thread_local PluginHost *g_hostingHost = nullptr;
+
+int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+bool PluginHost::Enabled() {
+    const std::string mode = karma::config::ReadStringConfig("pluginHost.Mode", "inline");
+    if (mode != "inline" && mode != "thread") {
+        spdlog::warn("PluginHost::Enabled: Unknown pluginHost.Mode '{}'; running plugins inline", mode);
+    }
+    return mode == "thread";
+}
+
+PluginHost::Settings PluginHost::ReadSettings() {
+    Settings settings;
+    settings.callbackTimeout = std::chrono::milliseconds(static_cast<int64_t>(
+        std::max(0.0f, karma::config::ReadFloatConfig({"pluginHost.CallbackTimeoutMs"}, 100.0f))));
+    settings.queueLimit = static_cast<std::size_t>(
+        std::max(1.0f, karma::config::ReadFloatConfig({"pluginHost.QueueLimit"}, 4096.0f)));
+    return settings;
+}
+
+PluginHost *PluginHost::current() {
+    return g_currentHost;
+}
+
+PluginHost *PluginHost::hosting() {
+    return g_hostingHost;
+}
+
+PluginHost::PluginHost(const karma::json::Value &configJson, bool isolatedScope, Settings settings)
+    : settings_(settings) {
+    std::promise<void> loaded;
+    std::future<void> loadedFuture = loaded.get_future();
+    worker_ = std::thread(&PluginHost::workerLoop, this, configJson, isolatedScope, std::move(loaded));
+    loadedFuture.wait();
+
+    if (settings_.callbackTimeout.count() > 0) {
+        watchdog_ = std::thread(&PluginHost::watchdogLoop, this);
+    }
+    g_currentHost = this;
+    spdlog::info("PluginHost: Running {} Python plugin(s) on a worker thread", loadedScripts_.size());
+}
+
+PluginHost::~PluginHost() {
+    if (g_currentHost == this) {
+        g_currentHost = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopping_ = true;
+    }
+    jobReady_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(watchdogMutex_);
+    }
+    watchdogWake_.notify_all();
+    if (watchdog_.joinable()) {
+        watchdog_.join();
+    }
+}
+
+bool PluginHost::post(std::function<bool()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        if (jobs_.size() >= settings_.queueLimit) {
+            if (!overflowing_) {
+                spdlog::warn("PluginHost::post: Event queue full ({} events); dropping events until plugins catch up",
+                             jobs_.size());
+                overflowing_ = true;
+            }
+            return false;
+        }
+        overflowing_ = false;
+        jobs_.push_back({std::move(job)});
+        postedJobs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    jobReady_.notify_one();
+    return true;
+}
+
+bool PluginHost::postVeto(std::function<bool()> job, std::function<void(bool allowed)> resolve) {
+    return post([this, job = std::move(job), resolve = std::move(resolve)]() {
+        const bool handled = job();
+        enqueueCommand([resolve, handled]() { resolve(!handled); });
+        return handled;
+    });
+}
+
+void PluginHost::beginTick(std::vector<PlayerInfo> players) {
+    std::vector<std::function<void()>> commands;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        commands.swap(commands_);
+    }
+    for (auto &command : commands) {
+        command();
+    }
+
+    std::lock_guard<std::mutex> lock(playerMutex_);
+    players_ = std::move(players);
+}
+
+void PluginHost::publishStatsReport(std::string report) {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    statsReport_ = std::move(report);
+}
+
+std::string PluginHost::statsReport() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return statsReport_;
+}
+
+void PluginHost::enqueueCommand(std::function<void()> command) {
+    std::lock_guard<std::mutex> lock(commandMutex_);
+    commands_.push_back(std::move(command));
+}
+
+std::vector<PluginHost::PlayerInfo> PluginHost::players() const {
+    std::lock_guard<std::mutex> lock(playerMutex_);
+    return players_;
+}
+
+void PluginHost::workerLoop(karma::json::Value configJson, bool isolatedScope, std::promise<void> loaded) {
+    namespace py = pybind11;
+    g_hostingHost = this;
+
+    {
+        py::gil_scoped_acquire gil;
+        pythonThreadId_ = PyThread_get_thread_ident();
+        PluginAPI::loadPythonPlugins(configJson, isolatedScope);
+        loadedScripts_ = PluginAPI::getLoadedPluginScripts();
+    }
+    loaded.set_value();
+
+    uint64_t jobId = 0;
+    for (;;) {
+        std::deque<Job> batch;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobReady_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                // Unanswered vetoes are dropped with the host; the game is shutting down.
+                break;
+            }
+            batch.swap(jobs_);
+        }
+
+        // One GIL acquisition per batch; Python still yields it to other arenas between bytecodes.
+        py::gil_scoped_acquire gil;
+        for (auto &job : batch) {
+            currentJobStartedMs_.store(NowMs(), std::memory_order_relaxed);
+            currentJob_.store(++jobId, std::memory_order_release);
+
+            try {
+                job.fn();
+            } catch (const py::error_already_set &e) {
+                spdlog::error("PluginHost: Plugin job failed: {}", e.what());
+            }
+
+            currentJob_.store(0, std::memory_order_release);
+            if (interruptedJob_.load(std::memory_order_relaxed) == jobId) {
+                // Drop a TimeoutError the callback finished before receiving.
+                PyThreadState_SetAsyncExc(pythonThreadId_, nullptr);
+            }
+        }
+    }
+
+    py::gil_scoped_acquire gil;
+    PluginAPI::unloadPythonPlugins();
+    g_hostingHost = nullptr;
+}
+
+void PluginHost::watchdogLoop() {
+    namespace py = pybind11;
+    const auto timeout = settings_.callbackTimeout;
+    const auto interval = std::max(std::chrono::milliseconds(1), timeout / 4);
+
+    std::unique_lock<std::mutex> lock(watchdogMutex_);
+    for (;;) {
+        watchdogWake_.wait_for(lock, interval);
+        {
+            std::lock_guard<std::mutex> jobLock(jobMutex_);
+            if (stopping_) {
+                return;
+            }
+        }
+
+        const uint64_t job = currentJob_.load(std::memory_order_acquire);
+        if (job == 0 || job == interruptedJob_.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        const int64_t elapsed = NowMs() - currentJobStartedMs_.load(std::memory_order_relaxed);
+        if (elapsed < timeout.count()) {
+            continue;
+        }
+
+        // The worker only switches jobs while holding the GIL, so this check is exact.
+        py::gil_scoped_acquire gil;
+        if (currentJob_.load(std::memory_order_acquire) != job) {
+            continue;
+        }
+        interruptedJob_.store(job, std::memory_order_relaxed);
+        PyThreadState_SetAsyncExc(pythonThreadId_, PyExc_TimeoutError);
+        spdlog::warn("PluginHost: Plugin callback exceeded {} ms; raising TimeoutError in it", timeout.count());
+    }
+}
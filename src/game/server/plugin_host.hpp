@@ -0,0 +1,116 @@
+#pragma once
+#include "game/net/messages.hpp"
+#include "karma/common/json.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs Python plugins on their own thread (pluginHost.Mode = "thread") so a
+// slow or blocking callback cannot stall the tick. The game thread posts
+// events to it; PluginAPI actions made by plugins come back as commands that
+// the game thread applies at the start of its next tick.
+class PluginHost {
+public:
+    struct Settings {
+        // Python callbacks running longer than this get a TimeoutError raised in them. 0 disables.
+        std::chrono::milliseconds callbackTimeout{100};
+        std::size_t queueLimit = 4096;
+    };
+
+    struct PlayerInfo {
+        client_id id;
+        std::string name;
+        std::string ip;
+        glm::vec3 position;
+        glm::quat rotation;
+        glm::vec3 velocity;
+        bool alive;
+        int score;
+        // cname of the native flag held, empty if none.
+        std::string flag;
+    };
+
+    static bool Enabled();
+    static Settings ReadSettings();
+    // Host serving the calling game thread, if any.
+    static PluginHost *current();
+    // Host whose worker is the calling thread, if any.
+    static PluginHost *hosting();
+
+    // Blocks until the plugins have been loaded on the worker.
+    PluginHost(const karma::json::Value &configJson, bool isolatedScope, Settings settings = ReadSettings());
+    ~PluginHost();
+
+    PluginHost(const PluginHost &) = delete;
+    PluginHost &operator=(const PluginHost &) = delete;
+
+    // Game thread. Queues job for the worker without waiting for it; returns
+    // false if the queue is full and the job was dropped.
+    bool post(std::function<bool()> job);
+    // Game thread. Queues a vetoable event: job returns whether a plugin
+    // handled it, and resolve(!handled) is then queued as a command, so it
+    // runs on the game thread at a later beginTick. Returns false, without
+    // queuing anything, if the queue is full.
+    bool postVeto(std::function<bool()> job, std::function<void(bool allowed)> resolve);
+    // Number of jobs accepted by post() so far.
+    uint64_t postedJobs() const { return postedJobs_.load(std::memory_order_relaxed); }
+    // Game thread, once per tick: applies queued commands and publishes the player list.
+    void beginTick(std::vector<PlayerInfo> players);
+
+    // Worker thread.
+    void enqueueCommand(std::function<void()> command);
+    std::vector<PlayerInfo> players() const;
+    // Worker thread. Replaces the plugin statistics report the game thread reads.
+    void publishStatsReport(std::string report);
+    // Game thread. Last report the worker published; empty before the first.
+    std::string statsReport() const;
+
+    const std::vector<std::string> &loadedScripts() const { return loadedScripts_; }
+
+private:
+    struct Job {
+        std::function<bool()> fn;
+    };
+
+    void workerLoop(karma::json::Value configJson, bool isolatedScope, std::promise<void> loaded);
+    void watchdogLoop();
+
+    Settings settings_;
+    std::vector<std::string> loadedScripts_;
+
+    std::mutex jobMutex_;
+    std::condition_variable jobReady_;
+    std::deque<Job> jobs_;
+    bool stopping_ = false;
+    bool overflowing_ = false;
+    std::atomic<uint64_t> postedJobs_{0};
+
+    std::mutex commandMutex_;
+    std::vector<std::function<void()>> commands_;
+
+    mutable std::mutex playerMutex_;
+    std::vector<PlayerInfo> players_;
+
+    mutable std::mutex statsMutex_;
+    std::string statsReport_;
+
+    // Watchdog view of the job the worker is running (0 = idle).
+    std::atomic<uint64_t> currentJob_{0};
+    std::atomic<int64_t> currentJobStartedMs_{0};
+    std::atomic<uint64_t> interruptedJob_{0};
+    unsigned long pythonThreadId_ = 0;
+    std::mutex watchdogMutex_;
+    std::condition_variable watchdogWake_;
+
+    std::thread worker_;
+    std::thread watchdog_;
+};
@@ -0,0 +1,147 @@
+#include "server/plugin_profiler.hpp"
+#include "plugin.hpp"
+#include "karma/common/config_helpers.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+constexpr auto BUDGET_LOG_INTERVAL = std::chrono::seconds(1);
+
+struct Settings {
+    uint64_t tickBudgetNs = 0;
+    uint32_t disableAfterTicks = 0;
+};
+
+thread_local Settings g_settings;
+thread_local std::deque<PluginProfiler::Timing> g_timings;
+thread_local std::chrono::steady_clock::time_point g_lastBudgetLog{};
+
+const char *EventTypeName(int type) {
+    switch (type) {
+        case EventType_Chat: return "CHAT";
+        case EventType_PlayerJoin: return "PLAYER_JOIN";
+        case EventType_PlayerLeave: return "PLAYER_LEAVE";
+        case EventType_PlayerSpawn: return "PLAYER_SPAWN";
+        case EventType_PlayerDie: return "PLAYER_DIE";
+        case EventType_CreateShot: return "CREATE_SHOT";
+        default: return "UNKNOWN";
+    }
+}
+
+double ToMs(uint64_t ns) {
+    return static_cast<double>(ns) / 1.0e6;
+}
+
+} // namespace
+
+void PluginProfiler::configure() {
+    const float budgetMs = karma::config::ReadFloatConfig({"pluginProfiler.TickBudgetMs"}, 5.0f);
+    const float disableAfter = karma::config::ReadFloatConfig({"pluginProfiler.DisableAfterTicks"}, 0.0f);
+    g_settings.tickBudgetNs = static_cast<uint64_t>(std::max(0.0f, budgetMs) * 1.0e6f);
+    g_settings.disableAfterTicks = static_cast<uint32_t>(std::max(0.0f, disableAfter));
+}
+
+PluginProfiler::Timing &PluginProfiler::timingFor(const std::string &plugin, int eventType) {
+    for (auto &timing : g_timings) {
+        if (timing.eventType == eventType && timing.plugin == plugin) {
+            return timing;
+        }
+    }
+    Timing &timing = g_timings.emplace_back();
+    timing.plugin = plugin;
+    timing.eventType = eventType;
+    return timing;
+}
+
+const std::deque<PluginProfiler::Timing> &PluginProfiler::timings() {
+    return g_timings;
+}
+
+void PluginProfiler::endTick() {
+    const uint64_t budget = g_settings.tickBudgetNs;
+    if (budget == 0) {
+        for (auto &timing : g_timings) {
+            timing.tickNs = 0;
+        }
+        return;
+    }
+
+    uint64_t tickTotal = 0;
+    const Timing *worst = nullptr;
+    for (const auto &timing : g_timings) {
+        tickTotal += timing.tickNs;
+        if (!worst || timing.tickNs > worst->tickNs) {
+            worst = &timing;
+        }
+    }
+
+    if (tickTotal > budget) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - g_lastBudgetLog >= BUDGET_LOG_INTERVAL) {
+            g_lastBudgetLog = now;
+            spdlog::warn("PluginProfiler: Plugins took {:.2f} ms of a {:.2f} ms tick budget; worst: {} on {} ({:.2f} ms)",
+                         ToMs(tickTotal), ToMs(budget), worst->plugin, EventTypeName(worst->eventType), ToMs(worst->tickNs));
+        }
+    }
+
+    for (auto &timing : g_timings) {
+        if (timing.tickNs > budget) {
+            ++timing.overBudgetTicks;
+            if (g_settings.disableAfterTicks > 0 && !timing.disabled &&
+                timing.overBudgetTicks >= g_settings.disableAfterTicks) {
+                timing.disabled = true;
+                spdlog::error("PluginProfiler: Disabled {} callbacks of plugin '{}' after {} ticks over the {:.2f} ms budget",
+                              EventTypeName(timing.eventType), timing.plugin, timing.overBudgetTicks, ToMs(budget));
+            }
+        } else {
+            timing.overBudgetTicks = 0;
+        }
+        timing.tickNs = 0;
+    }
+}
+
+void PluginProfiler::clearStats() {
+    for (auto &timing : g_timings) {
+        timing.count = 0;
+        timing.totalNs = 0;
+        timing.maxNs = 0;
+        timing.histogram.fill(0);
+        timing.tickNs = 0;
+        timing.overBudgetTicks = 0;
+        timing.disabled = false;
+    }
+}
+
+void PluginProfiler::reset() {
+    g_timings.clear();
+}
+
+std::string PluginProfiler::formatReport() {
+    std::vector<const Timing *> sorted;
+    for (const auto &timing : g_timings) {
+        sorted.push_back(&timing);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Timing *a, const Timing *b) {
+        return a->totalNs > b->totalNs;
+    });
+
+    std::string report = "Plugin callback time (histogram: <1us <10us <100us <1ms <10ms <100ms >=100ms):";
+    if (sorted.empty()) {
+        report += "\n (no Python callbacks registered)";
+    }
+    char line[256];
+    for (const Timing *timing : sorted) {
+        const double avgMs = timing->count > 0 ? ToMs(timing->totalNs) / static_cast<double>(timing->count) : 0.0;
+        std::snprintf(line, sizeof(line), "\n - %s %s: %llu calls, total %.2f ms, avg %.3f ms, max %.3f ms%s\n   ",
+                      timing->plugin.c_str(), EventTypeName(timing->eventType),
+                      static_cast<unsigned long long>(timing->count), ToMs(timing->totalNs), avgMs,
+                      ToMs(timing->maxNs), timing->disabled ? " [DISABLED]" : "");
+        report += line;
+        for (uint64_t bucket : timing->histogram) {
+            report += " " + std::to_string(bucket);
+        }
+    }
+    return report;
+}
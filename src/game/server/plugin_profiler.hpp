@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+// Time spent in Python plugin callbacks, per plugin and event type. Lives on
+// the thread that runs the callbacks (the tick thread, or the plugin host's
+// worker), like the callback tables themselves.
+namespace PluginProfiler {
+
+// Upper bounds of the histogram buckets: <1us, <10us, ..., <100ms, then >=100ms.
+inline constexpr std::size_t HISTOGRAM_BUCKETS = 7;
+
+struct Timing {
+    std::string plugin;
+    int eventType = 0;
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+
+    // Budget bookkeeping, reset by endTick.
+    uint64_t tickNs = 0;
+    uint32_t overBudgetTicks = 0;
+    bool disabled = false;
+
+    void record(uint64_t ns) {
+        ++count;
+        totalNs += ns;
+        tickNs += ns;
+        if (ns > maxNs) {
+            maxNs = ns;
+        }
+        std::size_t bucket = 0;
+        for (uint64_t bound = 1000; bucket + 1 < HISTOGRAM_BUCKETS && ns >= bound; bound *= 10) {
+            ++bucket;
+        }
+        ++histogram[bucket];
+    }
+};
+
+// Times one callback invocation into a Timing.
+class Scope {
+public:
+    explicit Scope(Timing &timing) : timing_(timing), start_(std::chrono::steady_clock::now()) {}
+    ~Scope() {
+        timing_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count()));
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    Timing &timing_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Reads pluginProfiler.* settings; called when plugins are loaded.
+void configure();
+// Shared entry for a plugin/event pair; the reference stays valid until reset().
+Timing &timingFor(const std::string &plugin, int eventType);
+const std::deque<Timing> &timings();
+// Checks this tick's callback time against the budget, then starts a new tick.
+void endTick();
+// Zeroes the counters and re-enables disabled callbacks.
+void clearStats();
+// Drops all entries; only valid once no callback refers to them.
+void reset();
+std::string formatReport();
+
+} // namespace PluginProfiler
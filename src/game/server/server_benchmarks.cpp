@@ -0,0 +1,294 @@
+#include "server/server_benchmarks.hpp"
+#include "server/game.hpp"
+#include "plugin.hpp"
+#include "karma/geometry/mesh_loader.hpp"
+#include "karma/physics/backend.hpp"
+#include "spdlog/spdlog.h"
+#include <glm/gtc/constants.hpp>
+#include <pybind11/embed.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+double MillisecondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Steps N server-side characters on the loaded world, once one at a time and
+// once through the batched updatePlayers path MovementValidator and
+// InputAuthority use. The clients-per-core column is an estimate from the
+// serial cost per client, not a measurement of a loaded server.
+int RunMovementBenchmark(Game &game) {
+    constexpr int TICKS = 240;
+    constexpr int TURN_EVERY_TICKS = 60;
+    constexpr float SPEED = 10.0f;
+    const float tickSeconds = SERVER_MIN_TICK_SECONDS;
+    const double budgetMs = static_cast<double>(tickSeconds) * 1000.0;
+
+    PhysicsWorld *physics = game.engine.physics;
+    if (!physics || !physics->createPlayerController(glm::vec3(1.0f, 2.0f, 1.0f)).isValid()) {
+        spdlog::error("Benchmark movement: the physics backend cannot simulate characters");
+        return 1;
+    }
+
+    std::printf("movement: %d ticks of %.2f ms per run, %u hardware threads\n",
+                TICKS, budgetMs, std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s %12s %17s\n", "clients", "serial ms/tick", "batched ms/tick", "us/client", "est clients/core");
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> heading(0.0f, glm::two_pi<float>());
+
+    for (int clients : {16, 64, 256, 1024}) {
+        std::vector<PhysicsPlayerController> controllers;
+        std::vector<glm::vec3> velocities;
+        controllers.reserve(clients);
+        velocities.reserve(clients);
+        for (int i = 0; i < clients; ++i) {
+            const Location spawn = game.world->pickSpawnLocation(0);
+            controllers.push_back(physics->createPlayerController(glm::vec3(1.0f, 2.0f, 1.0f)));
+            controllers.back().setPosition(spawn.position);
+            controllers.back().setRotation(spawn.rotation);
+            velocities.emplace_back(0.0f);
+        }
+
+        std::vector<PhysicsPlayerStep> steps;
+        steps.reserve(clients);
+        for (auto &controller : controllers) {
+            steps.push_back({&controller, tickSeconds});
+        }
+
+        auto runTicks = [&](bool batched) {
+            const auto start = BenchClock::now();
+            for (int tick = 0; tick < TICKS; ++tick) {
+                for (int i = 0; i < clients; ++i) {
+                    if (tick % TURN_EVERY_TICKS == 0) {
+                        const float angle = heading(rng);
+                        velocities[i] = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * SPEED;
+                    }
+                    controllers[i].setVelocity(velocities[i]);
+                }
+                if (batched) {
+                    physics->updatePlayers(steps);
+                } else {
+                    for (auto &controller : controllers) {
+                        controller.update(tickSeconds);
+                    }
+                }
+            }
+            return MillisecondsSince(start) / TICKS;
+        };
+
+        const double serialMs = runTicks(false);
+        const double batchedMs = runTicks(true);
+        const double perClientUs = serialMs * 1000.0 / clients;
+        const double perCore = perClientUs > 0.0 ? budgetMs * 1000.0 / perClientUs : 0.0;
+        std::printf("%8d %16.3f %16.3f %12.2f %17.0f\n", clients, serialMs, batchedMs, perClientUs, perCore);
+    }
+    return 0;
+}
+
+// Casts a fixed ray set at the world mesh through the server's physics backend
+// (one at a time and as a batch) and through the simulation backend, and fails
+// on any disagreement. Only meaningful in KARMA_SERVER_PHYSICS_BACKEND=bvh
+// builds; otherwise both sides are the same backend.
+int RunBvhRaysCheck(Game &game) {
+    constexpr int RAYS = 8192;
+    constexpr float FRACTION_TOLERANCE = 1e-3f;
+    constexpr float NORMAL_DOT = 0.99f;
+
+    std::unique_ptr<physics_backend::PhysicsWorldBackend> server = physics_backend::CreatePhysicsWorldBackend();
+    std::unique_ptr<physics_backend::PhysicsWorldBackend> reference = physics_backend::CreateSimulationPhysicsWorldBackend();
+    if (typeid(*server) == typeid(*reference)) {
+        std::printf("bvh-rays: server uses the simulation backend; nothing to compare\n");
+        return 0;
+    }
+
+    const std::string meshPath = game.world->resolveAssetPath("world").string();
+    auto serverBody = server->createStaticMesh(meshPath);
+    auto referenceBody = reference->createStaticMesh(meshPath);
+    if (!serverBody || !serverBody->isValid() || !referenceBody || !referenceBody->isValid()) {
+        spdlog::error("Benchmark bvh-rays: Failed to load {} into both backends", meshPath);
+        return 1;
+    }
+
+    glm::vec3 lo(std::numeric_limits<float>::max());
+    glm::vec3 hi(std::numeric_limits<float>::lowest());
+    for (const auto &mesh : MeshLoader::loadGLB(meshPath)) {
+        for (const auto &vertex : mesh.vertices) {
+            lo = glm::min(lo, vertex);
+            hi = glm::max(hi, vertex);
+        }
+    }
+    if (lo.x > hi.x) {
+        spdlog::error("Benchmark bvh-rays: {} has no vertices", meshPath);
+        return 1;
+    }
+    lo -= glm::vec3(1.0f);
+    hi += glm::vec3(1.0f);
+
+    // Half the rays fall straight down (spawn and ground queries), half are
+    // random segments through the bounds (shots). Seeded, so every run and
+    // every build casts the same set.
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> distX(lo.x, hi.x);
+    std::uniform_real_distribution<float> distY(lo.y, hi.y);
+    std::uniform_real_distribution<float> distZ(lo.z, hi.z);
+    PhysicsQueryBatch batch;
+    batch.rays.reserve(RAYS);
+    for (int i = 0; i < RAYS; ++i) {
+        if (i % 2 == 0) {
+            const float x = distX(rng);
+            const float z = distZ(rng);
+            batch.rays.push_back({{x, hi.y, z}, {x, lo.y, z}, {}});
+        } else {
+            batch.rays.push_back({{distX(rng), distY(rng), distZ(rng)}, {distX(rng), distY(rng), distZ(rng)}, {}});
+        }
+    }
+
+    std::vector<PhysicsQueryHit> expected(RAYS);
+    std::vector<PhysicsQueryHit> single(RAYS);
+    PhysicsQueryResults batched;
+
+    auto start = BenchClock::now();
+    for (int i = 0; i < RAYS; ++i) {
+        expected[i] = reference->castRay(batch.rays[i]);
+    }
+    const double referenceMs = MillisecondsSince(start);
+    start = BenchClock::now();
+    for (int i = 0; i < RAYS; ++i) {
+        single[i] = server->castRay(batch.rays[i]);
+    }
+    const double singleMs = MillisecondsSince(start);
+    start = BenchClock::now();
+    server->query(batch, batched);
+    const double batchedMs = MillisecondsSince(start);
+
+    auto agrees = [&](const PhysicsQueryHit &ours, const PhysicsQueryHit &theirs) {
+        if (ours.hit != theirs.hit) {
+            return false;
+        }
+        return !ours.hit ||
+               (std::fabs(ours.fraction - theirs.fraction) <= FRACTION_TOLERANCE &&
+                glm::dot(ours.normal, theirs.normal) >= NORMAL_DOT);
+    };
+
+    int singleMismatches = 0;
+    int batchedMismatches = 0;
+    for (int i = 0; i < RAYS; ++i) {
+        const bool singleAgrees = agrees(single[i], expected[i]);
+        const bool batchedAgrees = agrees(batched.rays[i], expected[i]);
+        singleMismatches += singleAgrees ? 0 : 1;
+        batchedMismatches += batchedAgrees ? 0 : 1;
+        if (!singleAgrees || !batchedAgrees) {
+            const PhysicsRayQuery &ray = batch.rays[i];
+            spdlog::warn("Benchmark bvh-rays: ray {} ({}, {}, {}) -> ({}, {}, {}): server hit={} f={} batched hit={} f={} reference hit={} f={}",
+                         i, ray.from.x, ray.from.y, ray.from.z, ray.to.x, ray.to.y, ray.to.z,
+                         single[i].hit, single[i].fraction, batched.rays[i].hit, batched.rays[i].fraction,
+                         expected[i].hit, expected[i].fraction);
+        }
+    }
+
+    serverBody->destroy();
+    referenceBody->destroy();
+
+    std::printf("bvh-rays: %d rays against %s\n", RAYS, meshPath.c_str());
+    std::printf("%10s %12s %12s\n", "path", "ms", "mismatches");
+    std::printf("%10s %12.3f %12s\n", "reference", referenceMs, "-");
+    std::printf("%10s %12.3f %12d\n", "single", singleMs, singleMismatches);
+    std::printf("%10s %12.3f %12d\n", "batched", batchedMs, batchedMismatches);
+    return singleMismatches == 0 && batchedMismatches == 0 ? 0 : 1;
+}
+
+// Pushes synthetic spawn events through a trivial Python plugin, once with a
+// per-event callback and once with a batch callback, at several events per
+// tick. The per-event column is the pre-batching delivery path, so one run
+// gives the before and after. Fails if Python did not see every event.
+// Runs before the server's own interpreter exists, so it starts one.
+int RunPluginEventsBenchmark() {
+    namespace py = pybind11;
+    constexpr int EVENTS_PER_RUN = 200000;
+
+    py::scoped_interpreter interpreter{};
+    py::dict scope;
+    scope["__builtins__"] = py::module_::import("builtins");
+    py::exec(R"(
+received = 0
+
+def on_spawn(player_id):
+    global received
+    received += 1
+    return False
+
+def on_spawn_batch(events):
+    global received
+    received += len(events)
+)", scope);
+
+    PluginProfiler::Timing &timing = PluginProfiler::timingFor("benchmark", EventType_PlayerSpawn);
+    bool complete = true;
+    auto runTicks = [&](int eventsPerTick) {
+        scope["received"] = 0;
+        const int ticks = EVENTS_PER_RUN / eventsPerTick;
+        const auto start = BenchClock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            for (int i = 0; i < eventsPerTick; ++i) {
+                Event_PlayerSpawn event{static_cast<client_id>(i)};
+                g_triggerPluginEvent(EventType_PlayerSpawn, event);
+            }
+            PluginAPI::endTick();
+        }
+        const double seconds = MillisecondsSince(start) / 1000.0;
+        const int delivered = scope["received"].cast<int>();
+        if (delivered != ticks * eventsPerTick) {
+            spdlog::error("Benchmark plugin-events: delivered {} of {} events", delivered, ticks * eventsPerTick);
+            complete = false;
+        }
+        return seconds > 0.0 ? delivered / seconds : 0.0;
+    };
+
+    std::printf("plugin-events: %d events per run through one Python callback\n", EVENTS_PER_RUN);
+    std::printf("%12s %18s %18s %10s\n", "events/tick", "per-event ev/s", "batched ev/s", "speedup");
+    for (int eventsPerTick : {1, 16, 256, 4096}) {
+        g_pluginCallbacks[EventType_PlayerSpawn] = {PluginCallback{scope["on_spawn"].cast<py::function>(), &timing}};
+        const double perEvent = runTicks(eventsPerTick);
+        g_pluginCallbacks.clear();
+
+        g_pluginBatchCallbacks[EventType_PlayerSpawn] = {PluginCallback{scope["on_spawn_batch"].cast<py::function>(), &timing}};
+        g_pluginBatchMask = 1u << EventType_PlayerSpawn;
+        const double batched = runTicks(eventsPerTick);
+        g_pluginBatchCallbacks.clear();
+        g_pluginBatchMask = 0;
+
+        std::printf("%12d %18.0f %18.0f %9.1fx\n", eventsPerTick, perEvent, batched,
+                    perEvent > 0.0 ? batched / perEvent : 0.0);
+    }
+
+    // Callback tables hold Python objects; release them before the interpreter.
+    PluginAPI::unloadPythonPlugins();
+    return complete ? 0 : 1;
+}
+
+} // namespace
+
+int RunServerBenchmark(const std::string &name, Game &game) {
+    if (name == "movement") {
+        return RunMovementBenchmark(game);
+    }
+    if (name == "bvh-rays") {
+        return RunBvhRaysCheck(game);
+    }
+    if (name == "plugin-events") {
+        return RunPluginEventsBenchmark();
+    }
+    spdlog::error("Unknown benchmark '{}' (available: movement, bvh-rays, plugin-events)", name);
+    return 1;
+}
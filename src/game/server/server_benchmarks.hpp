@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+class Game;
+
+// Offline measurements selected with `bz3-server --benchmark <name>`. They run
+// against the loaded world instead of serving it, print a table to stdout and
+// return the process exit code.
+int RunServerBenchmark(const std::string &name, Game &game);
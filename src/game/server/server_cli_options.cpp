@@ -53,6 +53,7 @@ ServerCLIOptions ParseServerCLIOptions(int argc, char *argv[]) {
     options.add_options()
         ("w,world", "World directory", cxxopts::value<std::string>())
         ("D,default-world", "Use bundled default world")
+        ("A,arenas", "Host every arena listed under 'arenas' in the server config")
         ("p,port", "Server listen port", cxxopts::value<uint16_t>()->default_value(ConfiguredPortDefault()))
         ("d,data-dir", "Data directory (overrides KARMA_DATA_DIR)", cxxopts::value<std::string>())
         ("c,config", "User config file path", cxxopts::value<std::string>())
@@ -60,6 +61,7 @@ ServerCLIOptions ParseServerCLIOptions(int argc, char *argv[]) {
         ("v,verbose", "Enable verbose logging (-v=debug, -vv=trace)")
         ("L,log-level", "Logging level (trace, debug, info, warn, err, critical, off)", cxxopts::value<std::string>())
         ("T,timestamp-logging", "Enable timestamped logging output")
+        ("benchmark", "Run a benchmark against the loaded world and exit (movement, bvh-rays, plugin-events)", cxxopts::value<std::string>())
         ("h,help", "Show help");
 
     cxxopts::ParseResult result;
@@ -99,6 +101,13 @@ ServerCLIOptions ParseServerCLIOptions(int argc, char *argv[]) {
         parsed.customWorldProvided = false;
     }
 
+    if (result.count("arenas")) {
+        if (result.count("world") || result.count("default-world") || result.count("port")) {
+            throw std::runtime_error("-A/--arenas takes worlds and ports from the 'arenas' config; drop -w, -D and -p");
+        }
+        parsed.hostArenas = true;
+    }
+
     if (result.count("world")) {
         parsed.worldDir = result["world"].as<std::string>();
         parsed.worldSpecified = true;
@@ -117,6 +126,10 @@ ServerCLIOptions ParseServerCLIOptions(int argc, char *argv[]) {
     parsed.timestampLogging = result.count("timestamp-logging") > 0;
     parsed.community = result.count("community") ? result["community"].as<std::string>() : std::string();
     parsed.communityExplicit = result.count("community") > 0;
+    parsed.benchmark = result.count("benchmark") ? result["benchmark"].as<std::string>() : std::string();
+    if (!parsed.benchmark.empty() && parsed.hostArenas) {
+        throw std::runtime_error("--benchmark runs against a single world; drop -A");
+    }
     if (parsed.logLevelExplicit && !IsValidLogLevel(parsed.logLevel)) {
         std::cerr << "Error: invalid --log-level value '" << parsed.logLevel << "'.\n";
         std::cerr << options.help() << std::endl;
@@ -7,6 +7,7 @@ struct ServerCLIOptions {
     std::string worldDir;
     bool worldSpecified = false;
     bool customWorldProvided = false;
+    bool hostArenas = false;
     uint16_t hostPort;
     bool hostPortExplicit = false;
     std::string dataDir;
@@ -19,6 +20,7 @@ struct ServerCLIOptions {
     bool timestampLogging = false;
     std::string community;
     bool communityExplicit = false;
+    std::string benchmark;
 };
 
 ServerCLIOptions ParseServerCLIOptions(int argc, char *argv[]);
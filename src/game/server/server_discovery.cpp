@@ -129,15 +129,27 @@ void ServerDiscoveryBeacon::run() {
 
         sockaddr_in from{};
         socklen_t fromLen = sizeof(from);
-        DiscoveryProtocol::RequestPacket request{};
-        int received = static_cast<int>(recvfrom(socketFd, reinterpret_cast<char*>(&request), sizeof(request), 0,
+        char buffer[sizeof(DiscoveryProtocol::PingPacket)] = {};
+        int received = static_cast<int>(recvfrom(socketFd, buffer, sizeof(buffer), 0,
             reinterpret_cast<sockaddr*>(&from), &fromLen));
 
         if (received < static_cast<int>(sizeof(DiscoveryProtocol::PacketHeader))) {
             continue;
         }
 
-        if (!DiscoveryProtocol::isRequest(request)) {
+        DiscoveryProtocol::PacketHeader header{};
+        std::memcpy(&header, buffer, sizeof(header));
+
+        if (DiscoveryProtocol::isPing(header) && received >= static_cast<int>(sizeof(DiscoveryProtocol::PingPacket))) {
+            DiscoveryProtocol::PingPacket ping;
+            std::memcpy(&ping, buffer, sizeof(ping));
+            const DiscoveryProtocol::PongPacket pong = DiscoveryProtocol::makePong(ping);
+            sendto(socketFd, reinterpret_cast<const char*>(&pong), sizeof(pong), 0,
+                reinterpret_cast<sockaddr*>(&from), fromLen);
+            continue;
+        }
+
+        if (!DiscoveryProtocol::isRequest(header)) {
             continue;
         }
 
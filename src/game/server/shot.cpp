@@ -2,8 +2,16 @@
 #include "server/game.hpp"
 #include "spdlog/spdlog.h"
 
-Shot::Shot(Game &game, client_id ownerId, shot_id localShotId, glm::vec3 position, glm::vec3 velocity) : game(game) {
+Shot::Shot(Game &game,
+           client_id ownerId,
+           shot_id localShotId,
+           glm::vec3 position,
+           glm::vec3 velocity,
+           server_tick rewindTicks,
+           bool serverSpawned) : game(game) {
     this->ownerId = ownerId;
+    this->rewindTicks = rewindTicks;
+    this->serverSpawned = serverSpawned;
     this->localId = localShotId;
     this->position = position;
     this->velocity = velocity;
@@ -14,12 +22,24 @@ Shot::Shot(Game &game, client_id ownerId, shot_id localShotId, glm::vec3 positio
     serverShotMsg.globalShotId = globalId;
     serverShotMsg.position = position;
     serverShotMsg.velocity = velocity;
-    game.engine.network->sendExcept<ServerMsg_CreateShot>(ownerId, &serverShotMsg);
+    if (serverSpawned) {
+        game.engine.network->sendAll<ServerMsg_CreateShot>(&serverShotMsg);
+    } else {
+        game.engine.network->sendExcept<ServerMsg_CreateShot>(ownerId, &serverShotMsg);
+    }
 
     creationTime = TimeUtils::GetCurrentTime();
 }
 
 Shot::~Shot() {
+    if (serverSpawned) {
+        ServerMsg_RemoveShot globalRemoveMsg;
+        globalRemoveMsg.isGlobalId = true;
+        globalRemoveMsg.shotId = globalId;
+        game.engine.network->sendAll<ServerMsg_RemoveShot>(&globalRemoveMsg);
+        return;
+    }
+
     // Local remove message to owner
     ServerMsg_RemoveShot localRemoveMsg;
     localRemoveMsg.isGlobalId = false;
@@ -33,17 +53,20 @@ Shot::~Shot() {
     game.engine.network->sendExcept<ServerMsg_RemoveShot>(ownerId, &globalRemoveMsg);
 }
 
-void Shot::update(TimeUtils::duration deltaTime) {
-    glm::vec3 hitPoint, hitNormal;
-    if (game.engine.physics->raycast(position, position + velocity * deltaTime, hitPoint, hitNormal)) {
-        velocity = glm::reflect(velocity, hitNormal);
+PhysicsRayQuery Shot::movementRay(TimeUtils::duration deltaTime) const {
+    return PhysicsRayQuery{position, position + velocity * deltaTime, {}};
+}
+
+void Shot::update(TimeUtils::duration deltaTime, const PhysicsQueryHit &bounce) {
+    if (bounce.hit) {
+        velocity = glm::reflect(velocity, bounce.normal);
     }
     
     position += velocity * deltaTime;
 }
 
-bool Shot::hits(Client *client) {
-    if (glm::distance(position, client->getPosition() + glm::vec3(0.0f, 1.0f, 0.0f)) < 1.0f) {
+bool Shot::hits(const glm::vec3 &targetPosition) const {
+    if (glm::distance(position, targetPosition + glm::vec3(0.0f, 1.0f, 0.0f)) < 1.0f) {
         return true;
     } else {
         return false;
@@ -1,6 +1,9 @@
 #pragma once
 #include "karma/core/types.hpp"
 #include "game/net/messages.hpp"
+#include "server/lag_compensation.hpp"
+#include "karma/physics/types.hpp"
+#include <atomic>
 
 class Game;
 class Client;
@@ -14,19 +17,31 @@ private:
     glm::vec3 position;
     glm::vec3 velocity;
     TimeUtils::time creationTime;
+    server_tick rewindTicks;
+    // Spawned by the server (e.g. a flag's extra shots), so the owner has no local copy.
+    bool serverSpawned;
 
     shot_id getNextGlobalShotId() {
-        static shot_id nextId = 1;
+        static std::atomic<shot_id> nextId{1};
         return nextId++;
     }
 
 public:
-    Shot(Game &game, client_id ownerId, shot_id localShotId, glm::vec3 position, glm::vec3 velocity);
+    Shot(Game &game,
+         client_id ownerId,
+         shot_id localShotId,
+         glm::vec3 position,
+         glm::vec3 velocity,
+         server_tick rewindTicks = 0,
+         bool serverSpawned = false);
     ~Shot();
 
-    void update(TimeUtils::duration deltaTime);
-    bool hits(Client *client);
+    // Segment the shot travels this tick; Game casts these for all shots as one batch.
+    PhysicsRayQuery movementRay(TimeUtils::duration deltaTime) const;
+    void update(TimeUtils::duration deltaTime, const PhysicsQueryHit &bounce);
+    bool hits(const glm::vec3 &targetPosition) const;
     bool isExpired() const;
     client_id getOwnerId() const { return ownerId; }
     shot_id getGlobalId() const { return globalId; }
+    server_tick getRewindTicks() const { return rewindTicks; }
 };
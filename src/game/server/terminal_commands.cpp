@@ -7,7 +7,7 @@
 #include <sstream>
 #include <vector>
 
-extern Game *g_game;
+extern thread_local Game *g_game;
 extern std::atomic<bool> g_running;
 
 namespace {
@@ -40,9 +40,17 @@ std::string processTerminalInput(const std::string &input) {
         for (const auto &plugin : PluginAPI::getLoadedPluginScripts()) {
             response += "\n - " + plugin;
         }
+        for (const auto &plugin : NativePlugins::getLoadedLibraries()) {
+            response += "\n - " + plugin + " (native)";
+        }
         return response;
     }
 
+    if (cmd == "pluginStats") {
+        const bool clear = args.size() > 1 && args[1] == "reset";
+        return PluginAPI::getPluginStatsReport(clear);
+    }
+
     if (cmd == "config" || cmd == "manifest") {
         try {
             return g_game->world->config().dump(4);
@@ -64,8 +72,10 @@ std::string processTerminalInput(const std::string &input) {
 
     if (cmd == "defaultPlayerParameters") {
         std::string response = "Default Player Parameters:";
-        for (const auto &[key, val] : g_game->world->defaultPlayerParameters()) {
-            response += "\n - " + key + ": " + std::to_string(val);
+        const PlayerParameterSchema &schema = g_game->world->parameterSchema();
+        const PlayerParameters &defaults = g_game->world->defaultPlayerParameters();
+        for (std::size_t i = 0; i < schema.size(); ++i) {
+            response += "\n - " + schema.name(static_cast<PlayerParameterId>(i)) + ": " + std::to_string(defaults[i]);
         }
         return response;
     }
@@ -80,5 +90,42 @@ std::string processTerminalInput(const std::string &input) {
         return response;
     }
 
+    if (cmd == "listFlags") {
+        std::string response = "Native Flags:";
+        for (const auto &flag : FlagCatalog::Shared().definitions()) {
+            response += "\n - " + flag.cname;
+        }
+        for (const auto &client : g_game->getClients()) {
+            if (const FlagDefinition *flag = g_game->flags->heldBy(client->getId())) {
+                response += "\n" + client->getName() + " holds " + flag->cname;
+            }
+        }
+        return response;
+    }
+
+    if (cmd == "giveFlag" || cmd == "dropFlag") {
+        const std::size_t needed = cmd == "giveFlag" ? 3 : 2;
+        if (args.size() < needed) {
+            return cmd == "giveFlag" ? "Usage: giveFlag <playerId> <flag>" : "Usage: dropFlag <playerId>";
+        }
+        client_id id = 0;
+        try {
+            id = static_cast<client_id>(std::stoul(args[1]));
+        } catch (const std::exception &) {
+            return "Invalid player id: " + args[1];
+        }
+        if (!g_game->getClient(id)) {
+            return "No player with id " + args[1];
+        }
+        if (cmd == "dropFlag") {
+            g_game->flags->drop(id);
+            return "Dropped flag of player " + args[1];
+        }
+        if (!g_game->flags->grant(id, args[2])) {
+            return "Unknown flag: " + args[2];
+        }
+        return "Gave " + args[2] + " to player " + args[1];
+    }
+
     return std::string("Unknown command: ") + input;
 }
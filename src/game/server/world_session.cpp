@@ -1,15 +1,50 @@
 #include "server/world_session.hpp"
 
 #include "server/game.hpp"
+#include "server/client.hpp"
 #include "spdlog/spdlog.h"
+#include "karma/common/config_helpers.hpp"
 #include "karma/common/data_path_resolver.hpp"
+#include "karma/geometry/mesh_loader.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <optional>
 
+namespace {
+
+constexpr float FALLBACK_SPAWN_HALF_EXTENT = 20.0f;
+
+uint64_t HashBytes(uint64_t hash, const void *data, std::size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Cache key for a baked grid: changes whenever the world mesh or any bake
+// setting changes, so a stale grid is rebaked instead of loaded.
+uint64_t GroundGridSourceKey(const std::filesystem::path &meshPath, const game_world::GroundGridSettings &settings) {
+    uint64_t hash = 14695981039346656037ull;
+    const std::string pathString = meshPath.generic_string();
+    hash = HashBytes(hash, pathString.data(), pathString.size());
+
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(meshPath, ec);
+    hash = HashBytes(hash, &size, sizeof(size));
+    const auto mtime = std::filesystem::last_write_time(meshPath, ec).time_since_epoch().count();
+    hash = HashBytes(hash, &mtime, sizeof(mtime));
+    return HashBytes(hash, &settings, sizeof(settings));
+}
+
+} // namespace
+
 ServerWorldSession::ServerWorldSession(Game &game,
                                        std::string serverNameIn,
                                        std::string worldName,
@@ -31,7 +66,8 @@ ServerWorldSession::ServerWorldSession(Game &game,
                                      std::filesystem::path(worldDir),
                                      std::move(worldName),
                                      "ServerWorldSession");
-    defaultPlayerParameters_ = game_world::ExtractDefaultPlayerParameters(content_.config);
+    parameterSchema_ = PlayerParameterSchema::FromDefaults(
+        game_world::ExtractDefaultPlayerParameters(content_.config), defaultPlayerParameters_);
 
     if (archiveOnStartup) {
         archiveCache = buildArchive();
@@ -41,12 +77,75 @@ ServerWorldSession::ServerWorldSession(Game &game,
     }
 
     physics = game.engine.physics->createStaticMesh(resolveAssetPath("world").string());
+
+    spawnSafeDistance = karma::config::ReadFloatConfig({"spawn.SafeDistance"}, spawnSafeDistance);
+    spawnCandidates = std::max(1, static_cast<int>(karma::config::ReadFloatConfig({"spawn.Candidates"}, static_cast<float>(spawnCandidates))));
+    loadGroundGrid();
 }
 
 ServerWorldSession::~ServerWorldSession() {
     physics.destroy();
 }
 
+void ServerWorldSession::loadGroundGrid() {
+    game_world::GroundGridSettings settings;
+    settings.cellSize = karma::config::ReadFloatConfig({"spawn.GridCellSize"}, settings.cellSize);
+    settings.maxSlopeDegrees = karma::config::ReadFloatConfig({"spawn.MaxSlopeDegrees"}, settings.maxSlopeDegrees);
+    settings.spawnClearance = karma::config::ReadFloatConfig({"spawn.Clearance"}, settings.spawnClearance);
+    settings.footprintHeightTolerance = karma::config::ReadFloatConfig({"spawn.FootprintHeightTolerance"}, settings.footprintHeightTolerance);
+    auto defaultParam = [this](const char *name, float fallback) {
+        const PlayerParameterId id = parameterSchema_.find(name);
+        return id < defaultPlayerParameters_.size() ? defaultPlayerParameters_[id] : fallback;
+    };
+    settings.footprint = {defaultParam("x_extent", 1.0f), defaultParam("z_extent", 1.0f)};
+
+    const std::filesystem::path meshPath = resolveAssetPath("world");
+
+    // Kept next to the world directory (like the world .zip) rather than in it,
+    // so the cache never ends up in the archive sent to clients.
+    std::filesystem::path cachePath = content_.rootDir;
+    if (!cachePath.has_filename()) {
+        cachePath = cachePath.parent_path();
+    }
+    cachePath += ".groundgrid";
+
+    const uint64_t sourceKey = GroundGridSourceKey(meshPath, settings);
+    if (groundGrid_.loadCache(cachePath, sourceKey)) {
+        spdlog::info("ServerWorldSession: Loaded ground grid {}x{} ({} spawn cells) from {}",
+                     groundGrid_.width(), groundGrid_.depth(), groundGrid_.spawnCells().size(), cachePath.string());
+        return;
+    }
+
+    if (!game.engine.physics) {
+        return;
+    }
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (const auto &mesh : MeshLoader::loadGLB(meshPath.string())) {
+        for (const auto &vertex : mesh.vertices) {
+            boundsMin = glm::min(boundsMin, vertex);
+            boundsMax = glm::max(boundsMax, vertex);
+        }
+    }
+    if (boundsMin.x > boundsMax.x) {
+        spdlog::warn("ServerWorldSession: World mesh {} has no vertices; spawning falls back to raycasts", meshPath.string());
+        return;
+    }
+
+    const TimeUtils::time bakeStart = TimeUtils::GetCurrentTime();
+    settings.rayTop = boundsMax.y + 1.0f;
+    settings.rayBottom = boundsMin.y - 1.0f;
+    groundGrid_.bake(*game.engine.physics, {boundsMin.x, boundsMin.z}, {boundsMax.x, boundsMax.z}, settings);
+    spdlog::info("ServerWorldSession: Baked ground grid {}x{} ({} spawn cells) in {:.2f}s",
+                 groundGrid_.width(), groundGrid_.depth(), groundGrid_.spawnCells().size(),
+                 TimeUtils::GetElapsedTime(bakeStart, TimeUtils::GetCurrentTime()));
+
+    if (!groundGrid_.saveCache(cachePath, sourceKey)) {
+        spdlog::debug("ServerWorldSession: Ground grid cache not written; it will be rebaked next start");
+    }
+}
+
 world::ArchiveBytes ServerWorldSession::buildArchive() {
     if (!archiveOnStartup) {
         return {};
@@ -72,8 +171,12 @@ void ServerWorldSession::sendWorldInit(client_id clientId) {
     initHeaderMsg.serverName = serverName;
     initHeaderMsg.worldName = content_.name;
     initHeaderMsg.protocolVersion = NET_PROTOCOL_VERSION;
+    initHeaderMsg.playerParameterNames = parameterSchema_.names();
     initHeaderMsg.defaultPlayerParams = defaultPlayerParameters_;
     initHeaderMsg.worldData = worldData;
+    if (game.inputAuthority->isEnabled()) {
+        initHeaderMsg.features.push_back(NET_FEATURE_SERVER_MOVEMENT);
+    }
     game.engine.network->send<ServerMsg_Init>(clientId, &initHeaderMsg);
 
     spdlog::trace("ServerWorldSession: Sent init message to client id {}", clientId);
@@ -83,9 +186,44 @@ std::filesystem::path ServerWorldSession::resolveAssetPath(const std::string &as
     return content_.resolveAssetPath(assetName, "ServerWorldSession");
 }
 
-Location ServerWorldSession::pickSpawnLocation() const {
+Location ServerWorldSession::pickSpawnLocation(client_id spawning) const {
+    static thread_local std::mt19937 rng{std::random_device{}()};
+    const auto &cells = groundGrid_.spawnCells();
+    if (cells.empty()) {
+        return pickFallbackSpawnLocation();
+    }
+
+    game_world::SpawnSafetyIndex players(std::max(spawnSafeDistance, 1.0f));
+    for (const auto &client : game.getClients()) {
+        if (client->getId() != spawning && client->getState().alive) {
+            players.insert(client->getState().position);
+        }
+    }
+
+    std::uniform_int_distribution<std::size_t> distCell(0, cells.size() - 1);
+    std::uniform_real_distribution<float> distRot(0.0f, glm::two_pi<float>());
+
+    glm::vec3 best = groundGrid_.cellPosition(cells[distCell(rng)]);
+    float bestDistance = players.nearestDistance(best, spawnSafeDistance);
+    for (int i = 1; i < spawnCandidates && bestDistance < spawnSafeDistance; ++i) {
+        const glm::vec3 candidate = groundGrid_.cellPosition(cells[distCell(rng)]);
+        const float distance = players.nearestDistance(candidate, spawnSafeDistance);
+        if (distance > bestDistance) {
+            best = candidate;
+            bestDistance = distance;
+        }
+    }
+
+    const float rotY = distRot(rng);
+    return Location{
+        .position = best,
+        .rotation = glm::angleAxis(rotY, glm::vec3(0.0f, 1.0f, 0.0f))
+    };
+}
+
+Location ServerWorldSession::pickFallbackSpawnLocation() const {
     static thread_local std::mt19937 rng{std::random_device{}()};
-    std::uniform_real_distribution<float> distXZ(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> distXZ(-FALLBACK_SPAWN_HALF_EXTENT, FALLBACK_SPAWN_HALF_EXTENT);
     std::uniform_real_distribution<float> distRot(0.0f, glm::two_pi<float>());
 
     const float x = distXZ(rng);
@@ -4,6 +4,7 @@
 #include "game/net/messages.hpp"
 #include "karma/physics/static_body.hpp"
 #include "game/world/config.hpp"
+#include "game/world/ground_grid.hpp"
 #include "world/backend.hpp"
 #include "world/content.hpp"
 
@@ -22,6 +23,7 @@ private:
 
     std::string serverName;
     world::WorldContent content_;
+    PlayerParameterSchema parameterSchema_;
     PlayerParameters defaultPlayerParameters_;
 
     PhysicsStaticBody physics;
@@ -29,7 +31,13 @@ private:
     bool archiveCached = false;
     world::ArchiveBytes archiveCache;
 
+    game_world::GroundGrid groundGrid_;
+    float spawnSafeDistance = 30.0f;
+    int spawnCandidates = 16;
+
     world::ArchiveBytes buildArchive();
+    void loadGroundGrid();
+    Location pickFallbackSpawnLocation() const;
 
 public:
     ServerWorldSession(Game &game,
@@ -45,7 +53,11 @@ public:
 
     std::filesystem::path resolveAssetPath(const std::string &assetName) const;
     const karma::json::Value &config() const { return content_.config; }
+    const PlayerParameterSchema &parameterSchema() const { return parameterSchema_; }
     const PlayerParameters &defaultPlayerParameters() const { return defaultPlayerParameters_; }
+    const game_world::GroundGrid &groundGrid() const { return groundGrid_; }
 
-    Location pickSpawnLocation() const;
+    // Picks a spawnable grid cell, preferring ones with no live player other
+    // than `spawning` within spawn.SafeDistance.
+    Location pickSpawnLocation(client_id spawning) const;
 };
@@ -21,6 +21,24 @@ struct CommunityBrowserEntry {
     std::string screenshotId;
     std::string sourceHost;
     std::string worldName;
+    // Latency from the server browser's ping probes; negative until measured.
+    int pingMs = -1;
+    int jitterMs = -1;
+    int lossPercent = -1;
+    // Position in the list as delivered, so the listed order can be restored.
+    int listOrder = 0;
+};
+
+enum class CommunityBrowserSortKey {
+    Listed,
+    Name,
+    Players,
+    Ping
+};
+
+struct CommunityBrowserSort {
+    CommunityBrowserSortKey key = CommunityBrowserSortKey::Listed;
+    bool descending = false;
 };
 
 struct CommunityBrowserSelection {
@@ -2,8 +2,41 @@
 
 #include "ui/config/ui_config.hpp"
 
+#include <algorithm>
+#include <cctype>
+
 namespace ui {
 
+namespace {
+
+std::string entryKey(const CommunityBrowserEntry &entry) {
+    return entry.host + ":" + std::to_string(entry.port);
+}
+
+std::string entrySortName(const CommunityBrowserEntry &entry) {
+    const std::string &name = !entry.worldName.empty()
+        ? entry.worldName
+        : (!entry.label.empty() ? entry.label : entry.host);
+    std::string lowered = name;
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return lowered;
+}
+
+// Orders two measured values; unknown (negative) values sort last in either direction.
+int compareMeasured(int lhs, int rhs, bool descending) {
+    if ((lhs < 0) != (rhs < 0)) {
+        return lhs < 0 ? 1 : -1;
+    }
+    if (lhs == rhs) {
+        return 0;
+    }
+    return ((lhs < rhs) != descending) ? -1 : 1;
+}
+
+} // namespace
+
 ConsoleController::ConsoleController(ConsoleModel &modelIn)
     : model(modelIn) {}
 
@@ -124,6 +157,76 @@ void ConsoleController::clearPending() {
     refreshRequested = false;
 }
 
+void ConsoleController::setCommunityEntries(const std::vector<CommunityBrowserEntry> &entries) {
+    auto &community = model.community;
+    std::string selectedKey;
+    if (community.selectedIndex >= 0 && community.selectedIndex < static_cast<int>(community.entries.size())) {
+        selectedKey = entryKey(community.entries[static_cast<std::size_t>(community.selectedIndex)]);
+    }
+    community.entries = entries;
+    for (std::size_t i = 0; i < community.entries.size(); ++i) {
+        community.entries[i].listOrder = static_cast<int>(i);
+    }
+    sortCommunityEntries(selectedKey);
+}
+
+void ConsoleController::setCommunitySort(const CommunityBrowserSort &sort) {
+    auto &community = model.community;
+    std::string selectedKey;
+    if (community.selectedIndex >= 0 && community.selectedIndex < static_cast<int>(community.entries.size())) {
+        selectedKey = entryKey(community.entries[static_cast<std::size_t>(community.selectedIndex)]);
+    }
+    community.sort = sort;
+    sortCommunityEntries(selectedKey);
+}
+
+void ConsoleController::sortCommunityEntries(const std::string &selectedKey) {
+    auto &community = model.community;
+    const CommunityBrowserSort sort = community.sort;
+    std::stable_sort(community.entries.begin(), community.entries.end(),
+                     [&sort](const CommunityBrowserEntry &lhs, const CommunityBrowserEntry &rhs) {
+        int order = 0;
+        switch (sort.key) {
+            case CommunityBrowserSortKey::Name: {
+                const std::string lhsName = entrySortName(lhs);
+                const std::string rhsName = entrySortName(rhs);
+                if (lhsName != rhsName) {
+                    order = ((lhsName < rhsName) != sort.descending) ? -1 : 1;
+                }
+                break;
+            }
+            case CommunityBrowserSortKey::Players:
+                order = compareMeasured(lhs.activePlayers, rhs.activePlayers, sort.descending);
+                break;
+            case CommunityBrowserSortKey::Ping:
+                order = compareMeasured(lhs.pingMs, rhs.pingMs, sort.descending);
+                if (order == 0) {
+                    order = compareMeasured(lhs.lossPercent, rhs.lossPercent, sort.descending);
+                }
+                break;
+            case CommunityBrowserSortKey::Listed:
+                if (lhs.listOrder != rhs.listOrder) {
+                    order = ((lhs.listOrder < rhs.listOrder) != sort.descending) ? -1 : 1;
+                }
+                break;
+        }
+        if (order == 0) {
+            return lhs.listOrder < rhs.listOrder;
+        }
+        return order < 0;
+    });
+
+    if (selectedKey.empty()) {
+        return;
+    }
+    for (std::size_t i = 0; i < community.entries.size(); ++i) {
+        if (entryKey(community.entries[i]) == selectedKey) {
+            community.selectedIndex = static_cast<int>(i);
+            return;
+        }
+    }
+}
+
 std::optional<CommunityBrowserSelection> ConsoleController::consumeSelection() {
     if (!pendingSelection.has_value()) {
         return std::nullopt;
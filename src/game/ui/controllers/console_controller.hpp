@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "ui/models/console_model.hpp"
 
@@ -32,6 +33,9 @@ public:
     void queueDeleteListRequest(const std::string &host);
     void requestRefresh();
     void clearPending();
+    // Replace or reorder the server entries, keeping the selected server selected.
+    void setCommunityEntries(const std::vector<CommunityBrowserEntry> &entries);
+    void setCommunitySort(const CommunityBrowserSort &sort);
 
     std::optional<CommunityBrowserSelection> consumeSelection();
     std::optional<int> consumeListSelection();
@@ -40,6 +44,8 @@ public:
     bool consumeRefreshRequest();
 
 private:
+    void sortCommunityEntries(const std::string &selectedKey);
+
     ConsoleModel &model;
     std::optional<CommunityBrowserSelection> pendingSelection;
     std::optional<int> pendingListSelection;
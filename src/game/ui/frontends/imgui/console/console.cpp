@@ -447,7 +447,7 @@ ConsoleView::~ConsoleView() {
 }
 
 void ConsoleView::setEntries(const std::vector<CommunityBrowserEntry> &newEntries) {
-    consoleModel.community.entries = newEntries;
+    consoleController.setCommunityEntries(newEntries);
     if (consoleModel.community.entries.empty()) {
         consoleModel.community.selectedIndex = -1;
     } else if (consoleModel.community.selectedIndex < 0) {
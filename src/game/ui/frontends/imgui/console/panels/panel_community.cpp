@@ -635,27 +635,53 @@ void ConsoleView::drawCommunityPanel(const MessageColors &messageColors) {
         tableHeight = 0.0f;
     }
     const float playerColumnWidth = 120.0f;
-
-    if (ImGui::BeginTable("##CommunityBrowserPresets", 2, tableFlags, ImVec2(-1.0f, tableHeight))) {
-        ImGui::TableSetupColumn("##ServerListColumn", ImGuiTableColumnFlags_WidthStretch, 1.0f);
-        ImGui::TableSetupColumn("##PlayerCountColumn", ImGuiTableColumnFlags_WidthFixed, playerColumnWidth);
-
-        ImGui::TableNextRow(ImGuiTableRowFlags_Headers);
-
-        const char *serversHeadingLabel = "Servers";
-
-        ImGui::TableSetColumnIndex(0);
+    const float pingColumnWidth = 90.0f;
+
+    // Clicking a heading sorts by it, clicking again reverses, a third click
+    // restores the listed order.
+    auto drawSortHeading = [&](const char *label, CommunityBrowserSortKey key) {
+        const CommunityBrowserSort sort = community.sort;
+        std::string text = label;
+        if (sort.key == key) {
+            text += sort.descending ? " v" : " ^";
+        }
+        text += "##Sort";
+        text += label;
         if (hasHeadingFont) {
             ImGui::PushFont(headingFont);
         }
         ImGui::PushStyleColor(ImGuiCol_Text, headingColor);
-        ImGui::TextUnformatted(serversHeadingLabel);
+        if (ImGui::Selectable(text.c_str(), false)) {
+            CommunityBrowserSort next{key, false};
+            if (sort.key == key) {
+                if (sort.descending) {
+                    next.key = CommunityBrowserSortKey::Listed;
+                } else {
+                    next.descending = true;
+                }
+            }
+            consoleController.setCommunitySort(next);
+        }
         ImGui::PopStyleColor();
         if (hasHeadingFont) {
             ImGui::PopFont();
         }
+    };
+
+    if (ImGui::BeginTable("##CommunityBrowserPresets", 3, tableFlags, ImVec2(-1.0f, tableHeight))) {
+        ImGui::TableSetupColumn("##ServerListColumn", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("##PingColumn", ImGuiTableColumnFlags_WidthFixed, pingColumnWidth);
+        ImGui::TableSetupColumn("##PlayerCountColumn", ImGuiTableColumnFlags_WidthFixed, playerColumnWidth);
+
+        ImGui::TableNextRow(ImGuiTableRowFlags_Headers);
+
+        ImGui::TableSetColumnIndex(0);
+        drawSortHeading("Servers", CommunityBrowserSortKey::Name);
 
         ImGui::TableSetColumnIndex(1);
+        drawSortHeading("Ping", CommunityBrowserSortKey::Ping);
+
+        ImGui::TableSetColumnIndex(2);
         const float headerStartX = ImGui::GetCursorPosX();
         const float headerStartY = ImGui::GetCursorPosY();
         const float headerColumnWidth = ImGui::GetColumnWidth();
@@ -725,6 +751,23 @@ void ConsoleView::drawCommunityPanel(const MessageColors &messageColors) {
                     }
                 }
                 ImGui::TableSetColumnIndex(1);
+                if (entry.pingMs >= 0) {
+                    if (entry.lossPercent > 0) {
+                        ImGui::Text("%d ms (%d%%)", entry.pingMs, entry.lossPercent);
+                    } else {
+                        ImGui::Text("%d ms", entry.pingMs);
+                    }
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip("RTT %d ms, jitter %d ms, %d%% loss",
+                                          entry.pingMs, entry.jitterMs, entry.lossPercent);
+                    }
+                } else if (entry.lossPercent >= 100) {
+                    ImGui::TextDisabled("no reply");
+                } else {
+                    ImGui::TextDisabled("-");
+                }
+
+                ImGui::TableSetColumnIndex(2);
                 if (entry.activePlayers >= 0) {
                     if (entry.maxPlayers >= 0) {
                         std::string activeText = std::to_string(entry.activePlayers);
@@ -1065,6 +1108,13 @@ void ConsoleView::drawCommunityPanel(const MessageColors &messageColors) {
             ImGui::Text("Capacity: %d", selectedEntry->maxPlayers);
         }
 
+        if (selectedEntry->pingMs >= 0) {
+            ImGui::Text("Ping: %d ms (jitter %d ms, %d%% loss)",
+                        selectedEntry->pingMs, selectedEntry->jitterMs, selectedEntry->lossPercent);
+        } else if (selectedEntry->lossPercent >= 100) {
+            ImGui::Text("Ping: no reply");
+        }
+
         if (!selectedEntry->gameMode.empty()) {
             ImGui::Text("Mode: %s", selectedEntry->gameMode.c_str());
         }
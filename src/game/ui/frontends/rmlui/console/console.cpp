@@ -61,7 +61,7 @@ void RmlUiConsole::show(const std::vector<CommunityBrowserEntry> &entriesIn) {
 }
 
 void RmlUiConsole::setEntries(const std::vector<CommunityBrowserEntry> &entriesIn) {
-    consoleModel.community.entries = entriesIn;
+    consoleController.setCommunityEntries(entriesIn);
     if (consoleModel.community.selectedIndex >= static_cast<int>(consoleModel.community.entries.size())) {
         consoleModel.community.selectedIndex = -1;
     }
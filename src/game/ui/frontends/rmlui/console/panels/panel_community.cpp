@@ -324,6 +324,7 @@ public:
         Selection,
         SelectionBlur,
         Refresh,
+        Sort,
         Join,
         Roam,
         Quit,
@@ -350,6 +351,9 @@ public:
             case Action::Refresh:
                 panel->handleRefresh();
                 break;
+            case Action::Sort:
+                panel->handleSortCycle();
+                break;
             case Action::Join:
                 panel->handleJoin();
                 break;
@@ -536,6 +540,7 @@ void RmlUiPanelCommunity::onLoaded(Rml::ElementDocument *doc) {
     selectElement = document->GetElementById("community-select");
     addButton = document->GetElementById("community-add-button");
     refreshButton = document->GetElementById("community-refresh-button");
+    sortButton = document->GetElementById("community-sort-button");
     inputElement = document->GetElementById("community-add-input");
     usernameInput = document->GetElementById("community-username-input");
     passwordInput = document->GetElementById("community-password-input");
@@ -582,6 +587,12 @@ void RmlUiPanelCommunity::onLoaded(Rml::ElementDocument *doc) {
         refreshButton->AddEventListener("click", listener.get());
         listeners.emplace_back(std::move(listener));
     }
+    if (sortButton) {
+        auto listener = std::make_unique<RmlUiPanelCommunityListener>(this, RmlUiPanelCommunityListener::Action::Sort);
+        sortButton->AddEventListener("click", listener.get());
+        listeners.emplace_back(std::move(listener));
+        updateSortButton();
+    }
     if (joinButton) {
         auto listener = std::make_unique<RmlUiPanelCommunityListener>(this, RmlUiPanelCommunityListener::Action::Join);
         joinButton->AddEventListener("click", listener.get());
@@ -770,6 +781,18 @@ void RmlUiPanelCommunity::setEntries(const std::vector<CommunityBrowserEntry> &e
         const char *parityClass = (i % 2 == 0) ? "even" : "odd";
         std::string row = "<div id=\"" + rowId + "\" class=\"server-item " + std::string(parityClass) + "\">";
         row += "<span id=\"" + nameId + "\" class=\"server-name\"></span>";
+        if (entry.pingMs >= 0) {
+            std::string ping = std::to_string(entry.pingMs) + " ms";
+            if (entry.jitterMs > 0) {
+                ping += " ±" + std::to_string(entry.jitterMs);
+            }
+            if (entry.lossPercent > 0) {
+                ping += " · " + std::to_string(entry.lossPercent) + "% loss";
+            }
+            row += "<span class=\"server-ping\">" + ping + "</span>";
+        } else if (entry.lossPercent >= 100) {
+            row += "<span class=\"server-ping unknown\">no reply</span>";
+        }
         if (!players.empty()) {
             row += "<span class=\"server-players\">" + players + "</span>";
         }
@@ -975,6 +998,53 @@ void RmlUiPanelCommunity::handleRefresh() {
     }
 }
 
+// Steps through listed order, name, most players and lowest ping.
+void RmlUiPanelCommunity::handleSortCycle() {
+    if (!consoleModel || !consoleController) {
+        return;
+    }
+    CommunityBrowserSort next;
+    switch (consoleModel->community.sort.key) {
+        case CommunityBrowserSortKey::Listed:
+            next = {CommunityBrowserSortKey::Name, false};
+            break;
+        case CommunityBrowserSortKey::Name:
+            next = {CommunityBrowserSortKey::Players, true};
+            break;
+        case CommunityBrowserSortKey::Players:
+            next = {CommunityBrowserSortKey::Ping, false};
+            break;
+        case CommunityBrowserSortKey::Ping:
+            next = {CommunityBrowserSortKey::Listed, false};
+            break;
+    }
+    consoleController->setCommunitySort(next);
+    updateSortButton();
+    setEntries(consoleModel->community.entries);
+}
+
+void RmlUiPanelCommunity::updateSortButton() {
+    if (!sortButton || !consoleModel) {
+        return;
+    }
+    const char *label = "Listed";
+    switch (consoleModel->community.sort.key) {
+        case CommunityBrowserSortKey::Listed:
+            label = "Listed";
+            break;
+        case CommunityBrowserSortKey::Name:
+            label = "Name";
+            break;
+        case CommunityBrowserSortKey::Players:
+            label = "Players";
+            break;
+        case CommunityBrowserSortKey::Ping:
+            label = "Ping";
+            break;
+    }
+    sortButton->SetInnerRML(std::string("Sort: ") + label);
+}
+
 void RmlUiPanelCommunity::handleJoin() {
     if (!consoleModel) {
         return;
@@ -67,6 +67,8 @@ private:
     void handleSelectionBlur();
     void handleAdd();
     void handleRefresh();
+    void handleSortCycle();
+    void updateSortButton();
     void handleJoin();
     void handleRoam();
     void handleResume();
@@ -91,6 +93,7 @@ private:
     Rml::ElementDocument *document = nullptr;
     Rml::Element *addButton = nullptr;
     Rml::Element *refreshButton = nullptr;
+    Rml::Element *sortButton = nullptr;
     Rml::Element *serverList = nullptr;
     Rml::Element *selectElement = nullptr;
     Rml::Element *inputElement = nullptr;
@@ -11,6 +11,7 @@ namespace ui {
 struct ConsoleCommunityModel {
     std::vector<CommunityBrowserEntry> entries;
     std::vector<ServerListOption> listOptions;
+    CommunityBrowserSort sort;
     int selectedIndex = -1;
     int listSelectedIndex = -1;
     int selectedServerIndex = -1;
@@ -2,8 +2,8 @@
 
 namespace game_world {
 
-PlayerParameters ExtractDefaultPlayerParameters(const karma::json::Value& config) {
-    PlayerParameters params;
+std::map<std::string, float> ExtractDefaultPlayerParameters(const karma::json::Value& config) {
+    std::map<std::string, float> params;
     if (!config.is_object()) {
         return params;
     }
@@ -3,8 +3,12 @@
 #include "karma/core/types.hpp"
 #include "karma/common/json.hpp"
 
+#include <map>
+#include <string>
+
 namespace game_world {
 
-PlayerParameters ExtractDefaultPlayerParameters(const karma::json::Value& config);
+// Name -> value pairs of the config's defaultPlayerParameters.
+std::map<std::string, float> ExtractDefaultPlayerParameters(const karma::json::Value& config);
 
 } // namespace game_world
@@ -0,0 +1,325 @@
+#include "game/world/ground_grid.hpp"
+
+#include "karma/physics/physics_world.hpp"
+#include "spdlog/spdlog.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace game_world {
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x47474242; // "BBGG"
+constexpr uint32_t CACHE_VERSION = 2;
+constexpr uint32_t MAX_GRID_DIMENSION = 8192;
+constexpr float CLEARANCE_RAY_OFFSET = 0.05f;
+// Points sampled on the footprint circle; the corners of the tank box lie on
+// it whatever the spawn heading.
+constexpr int FOOTPRINT_SAMPLES = 8;
+
+// Arenas loading the same world save its cache at the same time; each writes
+// its own temp file so a rename never moves a mix of both into place.
+std::filesystem::path UniqueTempPath(const std::filesystem::path &path) {
+    const std::size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ std::random_device{}();
+    return path.string() + "." + std::to_string(salt) + ".tmp";
+}
+
+template <typename T>
+void WritePod(std::ofstream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+} // namespace
+
+void GroundGrid::bake(const PhysicsWorld &physics,
+                      const glm::vec2 &minXZ,
+                      const glm::vec2 &maxXZ,
+                      const GroundGridSettings &settings) {
+    cellSize_ = std::max(settings.cellSize, 0.1f);
+    origin_ = minXZ;
+    const glm::vec2 extent = glm::max(maxXZ - minXZ, glm::vec2(0.0f));
+    width_ = std::min(MAX_GRID_DIMENSION, static_cast<uint32_t>(std::ceil(extent.x / cellSize_)) + 1);
+    depth_ = std::min(MAX_GRID_DIMENSION, static_cast<uint32_t>(std::ceil(extent.y / cellSize_)) + 1);
+
+    const std::size_t cellCount = static_cast<std::size_t>(width_) * depth_;
+    heights_.assign(cellCount, 0.0f);
+    flags_.assign(cellCount, 0);
+
+    const float minNormalY = std::cos(glm::radians(settings.maxSlopeDegrees));
+    const PhysicsQueryFilter staticOnly{PhysicsQueryBodies::StaticOnly};
+
+    // Pass 1: one downward ray per cell for the ground height and slope.
+    PhysicsQueryBatch batch;
+    PhysicsQueryResults results;
+    batch.rays.reserve(cellCount);
+    for (uint32_t row = 0; row < depth_; ++row) {
+        const float z = origin_.y + static_cast<float>(row) * cellSize_;
+        for (uint32_t col = 0; col < width_; ++col) {
+            const float x = origin_.x + static_cast<float>(col) * cellSize_;
+            batch.rays.push_back({{x, settings.rayTop, z}, {x, settings.rayBottom, z}, staticOnly});
+        }
+    }
+    physics.query(batch, results);
+
+    std::vector<uint32_t> walkable;
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        const PhysicsQueryHit &hit = results.rays[i];
+        if (!hit.hit) {
+            continue;
+        }
+        heights_[i] = hit.point.y;
+        flags_[i] = CELL_GROUND;
+        if (hit.normal.y >= minNormalY) {
+            flags_[i] |= CELL_WALKABLE;
+            walkable.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // Pass 2: for each walkable cell, downward rays around the footprint circle
+    // for level ground, then upward rays at the centre and around the circle
+    // for spawn headroom.
+    const float footprintRadius = 0.5f * glm::length(settings.footprint);
+    const int samples = footprintRadius > 0.0f ? FOOTPRINT_SAMPLES : 0;
+    const std::size_t raysPerCell = static_cast<std::size_t>(2 * samples + 1);
+    std::vector<glm::vec2> offsets;
+    offsets.reserve(samples);
+    for (int s = 0; s < samples; ++s) {
+        const float angle = glm::two_pi<float>() * static_cast<float>(s) / static_cast<float>(samples);
+        offsets.emplace_back(std::cos(angle) * footprintRadius, std::sin(angle) * footprintRadius);
+    }
+    const float headroomStart = CLEARANCE_RAY_OFFSET + (samples > 0 ? settings.footprintHeightTolerance : 0.0f);
+
+    batch.clear();
+    batch.rays.reserve(walkable.size() * raysPerCell);
+    for (uint32_t cell : walkable) {
+        const glm::vec3 ground = cellPosition(cell);
+        for (const glm::vec2 &offset : offsets) {
+            const float x = ground.x + offset.x;
+            const float z = ground.z + offset.y;
+            batch.rays.push_back({{x, settings.rayTop, z}, {x, settings.rayBottom, z}, staticOnly});
+        }
+        batch.rays.push_back({ground + glm::vec3(0.0f, CLEARANCE_RAY_OFFSET, 0.0f),
+                              ground + glm::vec3(0.0f, settings.spawnClearance, 0.0f),
+                              staticOnly});
+        for (const glm::vec2 &offset : offsets) {
+            const glm::vec3 base = ground + glm::vec3(offset.x, 0.0f, offset.y);
+            batch.rays.push_back({base + glm::vec3(0.0f, headroomStart, 0.0f),
+                                  base + glm::vec3(0.0f, settings.spawnClearance, 0.0f),
+                                  staticOnly});
+        }
+    }
+    physics.query(batch, results);
+
+    for (std::size_t i = 0; i < walkable.size(); ++i) {
+        const PhysicsQueryHit *rays = results.rays.data() + i * raysPerCell;
+        const float height = heights_[walkable[i]];
+        bool spawnable = true;
+        for (int s = 0; s < samples && spawnable; ++s) {
+            const PhysicsQueryHit &ground = rays[s];
+            spawnable = ground.hit && ground.normal.y >= minNormalY &&
+                        std::fabs(ground.point.y - height) <= settings.footprintHeightTolerance;
+        }
+        for (std::size_t r = samples; r < raysPerCell && spawnable; ++r) {
+            spawnable = !rays[r].hit;
+        }
+        if (spawnable) {
+            flags_[walkable[i]] |= CELL_SPAWNABLE;
+        }
+    }
+
+    rebuildSpawnCells();
+}
+
+bool GroundGrid::loadCache(const std::filesystem::path &path, uint64_t sourceKey) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t key = 0;
+    glm::vec2 origin{0.0f};
+    float cellSize = 0.0f;
+    uint32_t width = 0;
+    uint32_t depth = 0;
+    if (!ReadPod(in, magic) || !ReadPod(in, version) || !ReadPod(in, key) ||
+        !ReadPod(in, origin) || !ReadPod(in, cellSize) || !ReadPod(in, width) || !ReadPod(in, depth)) {
+        return false;
+    }
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || key != sourceKey ||
+        width > MAX_GRID_DIMENSION || depth > MAX_GRID_DIMENSION || cellSize <= 0.0f) {
+        return false;
+    }
+
+    const std::size_t cellCount = static_cast<std::size_t>(width) * depth;
+    std::vector<float> heights(cellCount);
+    std::vector<uint8_t> flags(cellCount);
+    in.read(reinterpret_cast<char *>(heights.data()), static_cast<std::streamsize>(cellCount * sizeof(float)));
+    in.read(reinterpret_cast<char *>(flags.data()), static_cast<std::streamsize>(cellCount));
+    if (!in) {
+        spdlog::warn("GroundGrid::loadCache: Truncated cache file {}", path.string());
+        return false;
+    }
+
+    origin_ = origin;
+    cellSize_ = cellSize;
+    width_ = width;
+    depth_ = depth;
+    heights_ = std::move(heights);
+    flags_ = std::move(flags);
+    rebuildSpawnCells();
+    return true;
+}
+
+bool GroundGrid::saveCache(const std::filesystem::path &path, uint64_t sourceKey) const {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    const std::filesystem::path tempPath = UniqueTempPath(path);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            spdlog::warn("GroundGrid::saveCache: Failed to open {}", tempPath.string());
+            return false;
+        }
+        WritePod(out, CACHE_MAGIC);
+        WritePod(out, CACHE_VERSION);
+        WritePod(out, sourceKey);
+        WritePod(out, origin_);
+        WritePod(out, cellSize_);
+        WritePod(out, width_);
+        WritePod(out, depth_);
+        out.write(reinterpret_cast<const char *>(heights_.data()), static_cast<std::streamsize>(heights_.size() * sizeof(float)));
+        out.write(reinterpret_cast<const char *>(flags_.data()), static_cast<std::streamsize>(flags_.size()));
+        if (!out) {
+            spdlog::warn("GroundGrid::saveCache: Failed to write {}", tempPath.string());
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        spdlog::warn("GroundGrid::saveCache: Failed to move cache into place at {}: {}", path.string(), ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<uint32_t> GroundGrid::cellAt(float x, float z) const {
+    if (empty()) {
+        return std::nullopt;
+    }
+    const float col = std::round((x - origin_.x) / cellSize_);
+    const float row = std::round((z - origin_.y) / cellSize_);
+    if (col < 0.0f || row < 0.0f || col >= static_cast<float>(width_) || row >= static_cast<float>(depth_)) {
+        return std::nullopt;
+    }
+    return static_cast<uint32_t>(row) * width_ + static_cast<uint32_t>(col);
+}
+
+std::optional<float> GroundGrid::heightAt(float x, float z) const {
+    const auto cell = cellAt(x, z);
+    if (!cell || !(flags_[*cell] & CELL_GROUND)) {
+        return std::nullopt;
+    }
+    return heights_[*cell];
+}
+
+uint8_t GroundGrid::flagsAt(float x, float z) const {
+    const auto cell = cellAt(x, z);
+    return cell ? flags_[*cell] : 0;
+}
+
+glm::vec3 GroundGrid::cellPosition(uint32_t cell) const {
+    const uint32_t row = cell / width_;
+    const uint32_t col = cell % width_;
+    return {
+        origin_.x + static_cast<float>(col) * cellSize_,
+        heights_[cell],
+        origin_.y + static_cast<float>(row) * cellSize_
+    };
+}
+
+void GroundGrid::rebuildSpawnCells() {
+    spawnCells_.clear();
+    for (uint32_t i = 0; i < flags_.size(); ++i) {
+        if (flags_[i] & CELL_SPAWNABLE) {
+            spawnCells_.push_back(i);
+        }
+    }
+}
+
+SpawnSafetyIndex::SpawnSafetyIndex(float bucketSize)
+    : bucketSize_(std::max(bucketSize, 1.0f)) {
+}
+
+void SpawnSafetyIndex::clear() {
+    buckets_.clear();
+    count_ = 0;
+}
+
+uint64_t SpawnSafetyIndex::bucketKey(int32_t x, int32_t z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+void SpawnSafetyIndex::insert(const glm::vec3 &position) {
+    const int32_t bx = static_cast<int32_t>(std::floor(position.x / bucketSize_));
+    const int32_t bz = static_cast<int32_t>(std::floor(position.z / bucketSize_));
+    buckets_[bucketKey(bx, bz)].emplace_back(position.x, position.z);
+    ++count_;
+}
+
+float SpawnSafetyIndex::nearestDistance(const glm::vec3 &position, float maxDistance) const {
+    if (count_ == 0) {
+        return maxDistance;
+    }
+
+    const glm::vec2 point{position.x, position.z};
+    const int32_t cx = static_cast<int32_t>(std::floor(point.x / bucketSize_));
+    const int32_t cz = static_cast<int32_t>(std::floor(point.y / bucketSize_));
+    const int32_t maxRing = static_cast<int32_t>(std::ceil(maxDistance / bucketSize_)) + 1;
+
+    float bestSq = maxDistance * maxDistance;
+    for (int32_t ring = 0; ring <= maxRing; ++ring) {
+        // Anything in this ring or beyond is at least (ring - 1) buckets away.
+        const float ringMin = static_cast<float>(std::max(ring - 1, 0)) * bucketSize_;
+        if (ringMin * ringMin >= bestSq) {
+            break;
+        }
+        for (int32_t dz = -ring; dz <= ring; ++dz) {
+            for (int32_t dx = -ring; dx <= ring; ++dx) {
+                if (std::abs(dx) != ring && std::abs(dz) != ring) {
+                    continue;
+                }
+                auto it = buckets_.find(bucketKey(cx + dx, cz + dz));
+                if (it == buckets_.end()) {
+                    continue;
+                }
+                for (const glm::vec2 &other : it->second) {
+                    const glm::vec2 delta = other - point;
+                    bestSq = std::min(bestSq, glm::dot(delta, delta));
+                }
+            }
+        }
+    }
+    return std::sqrt(bestSq);
+}
+
+} // namespace game_world
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "karma/core/types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class PhysicsWorld;
+
+namespace game_world {
+
+struct GroundGridSettings {
+    float cellSize = 1.0f;
+    float maxSlopeDegrees = 40.0f;
+    float spawnClearance = 2.5f;
+    // Full x/z extents of the tank. Spawns face any direction, so the whole
+    // circle around this box must be walkable ground within the tolerance of
+    // the centre height. Zero checks only the cell centre.
+    glm::vec2 footprint{0.0f};
+    float footprintHeightTolerance = 0.3f;
+    float rayTop = 500.0f;
+    float rayBottom = -100.0f;
+};
+
+// Heightfield sampled from the world collision mesh on a regular XZ grid.
+// Baked once per world so ground height and spawn validity are lookups
+// instead of raycasts.
+class GroundGrid {
+public:
+    static constexpr uint8_t CELL_GROUND = 1 << 0;
+    static constexpr uint8_t CELL_WALKABLE = 1 << 1;
+    static constexpr uint8_t CELL_SPAWNABLE = 1 << 2;
+
+    void bake(const PhysicsWorld &physics,
+              const glm::vec2 &minXZ,
+              const glm::vec2 &maxXZ,
+              const GroundGridSettings &settings);
+
+    // sourceKey identifies the world geometry the cache was baked from.
+    bool loadCache(const std::filesystem::path &path, uint64_t sourceKey);
+    bool saveCache(const std::filesystem::path &path, uint64_t sourceKey) const;
+
+    bool empty() const { return width_ == 0 || depth_ == 0; }
+    uint32_t width() const { return width_; }
+    uint32_t depth() const { return depth_; }
+    float cellSize() const { return cellSize_; }
+
+    std::optional<uint32_t> cellAt(float x, float z) const;
+    std::optional<float> heightAt(float x, float z) const;
+    uint8_t flagsAt(float x, float z) const;
+    glm::vec3 cellPosition(uint32_t cell) const;
+
+    const std::vector<uint32_t> &spawnCells() const { return spawnCells_; }
+
+private:
+    void rebuildSpawnCells();
+
+    glm::vec2 origin_{0.0f};
+    float cellSize_ = 1.0f;
+    uint32_t width_ = 0;
+    uint32_t depth_ = 0;
+    std::vector<float> heights_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint32_t> spawnCells_;
+};
+
+// Bucketed XZ index of live players for "far from everyone" spawn picks.
+class SpawnSafetyIndex {
+public:
+    explicit SpawnSafetyIndex(float bucketSize = 16.0f);
+
+    void clear();
+    void insert(const glm::vec3 &position);
+    bool empty() const { return count_ == 0; }
+
+    // Horizontal distance to the closest inserted point, capped at maxDistance.
+    float nearestDistance(const glm::vec3 &position, float maxDistance) const;
+
+private:
+    static uint64_t bucketKey(int32_t x, int32_t z);
+
+    float bucketSize_;
+    std::size_t count_ = 0;
+    std::unordered_map<uint64_t, std::vector<glm::vec2>> buckets_;
+};
+
+} // namespace game_world
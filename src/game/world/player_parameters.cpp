@@ -0,0 +1,34 @@
+#include "game/world/player_parameters.hpp"
+
+#include "spdlog/spdlog.h"
+
+PlayerParameterSchema::PlayerParameterSchema(std::vector<std::string> names) : names_(std::move(names)) {
+    if (names_.size() >= INVALID_PLAYER_PARAMETER) {
+        spdlog::error("PlayerParameterSchema: {} parameters exceed the id range; truncating", names_.size());
+        names_.resize(INVALID_PLAYER_PARAMETER);
+    }
+    ids_.reserve(names_.size());
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+        ids_.emplace(names_[i], static_cast<PlayerParameterId>(i));
+    }
+}
+
+PlayerParameterSchema PlayerParameterSchema::FromDefaults(const std::map<std::string, float> &defaults,
+                                                          PlayerParameters &values) {
+    std::vector<std::string> names;
+    names.reserve(defaults.size());
+    values.clear();
+    values.reserve(defaults.size());
+    for (const auto &[name, value] : defaults) {
+        names.push_back(name);
+        values.push_back(value);
+    }
+    PlayerParameterSchema schema(std::move(names));
+    values.resize(schema.size());
+    return schema;
+}
+
+PlayerParameterId PlayerParameterSchema::find(const std::string &name) const {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : INVALID_PLAYER_PARAMETER;
+}
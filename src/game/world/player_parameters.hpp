@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using PlayerParameterId = uint16_t;
+constexpr PlayerParameterId INVALID_PLAYER_PARAMETER = std::numeric_limits<PlayerParameterId>::max();
+
+// A player's parameter values, indexed by PlayerParameterId.
+using PlayerParameters = std::vector<float>;
+
+struct PlayerParameterChange {
+    PlayerParameterId id;
+    float value;
+};
+
+// Interns the world's player parameter names to small ids. The server builds
+// it from defaultPlayerParameters when the world loads and sends the names
+// once in ServerMsg_Init; after that only ids and values cross the wire.
+class PlayerParameterSchema {
+public:
+    PlayerParameterSchema() = default;
+    explicit PlayerParameterSchema(std::vector<std::string> names);
+
+    // Ids follow the sorted parameter names; values receives the defaults in id order.
+    static PlayerParameterSchema FromDefaults(const std::map<std::string, float> &defaults, PlayerParameters &values);
+
+    // INVALID_PLAYER_PARAMETER for names the world does not define.
+    PlayerParameterId find(const std::string &name) const;
+    const std::string &name(PlayerParameterId id) const { return names_[id]; }
+    const std::vector<std::string> &names() const { return names_; }
+    std::size_t size() const { return names_.size(); }
+    bool empty() const { return names_.empty(); }
+
+private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, PlayerParameterId> ids_;
+};